@@ -1,6 +1,7 @@
 #include "CombProcessor.h"
 #include "WaterStickProcessor.h"
 #include "AdaptiveSmoother.h"
+#include "FastTanh.h"
 #include <cmath>
 #include <algorithm>
 
@@ -8,6 +9,7 @@ namespace WaterStick {
 
 CombProcessor::CombProcessor()
     : mBufferSize(0)
+    , mBufferMask(0)
     , mWriteIndex(0)
     , mSampleRate(44100.0)
     , mCombSize(0.1f)
@@ -42,11 +44,12 @@ CombProcessor::~CombProcessor()
 void CombProcessor::initialize(double sampleRate, double maxDelaySeconds)
 {
     mSampleRate = sampleRate;
-    mBufferSize = static_cast<int>(maxDelaySeconds * sampleRate + 1);
 
     // Allocate delay buffers
-    mDelayBufferL.resize(mBufferSize, 0.0f);
-    mDelayBufferR.resize(mBufferSize, 0.0f);
+    mDelayBufferL.allocate(static_cast<int>(maxDelaySeconds * sampleRate + 1), 1);
+    mDelayBufferR.allocate(static_cast<int>(maxDelaySeconds * sampleRate + 1), 1);
+    mBufferSize = mDelayBufferL.size();
+    mBufferMask = mDelayBufferL.mask();
 
     // Update smoothing coefficient based on sample rate
     updateSmoothingCoeff();
@@ -59,8 +62,8 @@ void CombProcessor::initialize(double sampleRate, double maxDelaySeconds)
 
 void CombProcessor::reset()
 {
-    std::fill(mDelayBufferL.begin(), mDelayBufferL.end(), 0.0f);
-    std::fill(mDelayBufferR.begin(), mDelayBufferR.end(), 0.0f);
+    mDelayBufferL.clear();
+    mDelayBufferR.clear();
     mWriteIndex = 0;
     mFeedbackBufferL = 0.0f;
     mFeedbackBufferR = 0.0f;
@@ -299,7 +302,7 @@ float CombProcessor::getTapGain(int tapIndex) const
 
 float CombProcessor::tanhLimiter(float input) const
 {
-    return std::tanh(input);
+    return FastTanh::pade(input);
 }
 
 void CombProcessor::updateSmoothingCoeff()
@@ -385,8 +388,8 @@ void CombProcessor::processStereo(float inputL, float inputR, float& outputL, fl
     float mixedL = inputL + mFeedbackBufferL * mFeedback;
     float mixedR = inputR + mFeedbackBufferR * mFeedback;
 
-    mDelayBufferL[mWriteIndex] = mixedL;
-    mDelayBufferR[mWriteIndex] = mixedR;
+    mDelayBufferL.write(static_cast<uint32_t>(mWriteIndex), mixedL);
+    mDelayBufferR.write(static_cast<uint32_t>(mWriteIndex), mixedR);
 
     outputL = 0.0f;
     outputR = 0.0f;
@@ -430,13 +433,13 @@ void CombProcessor::processStereo(float inputL, float inputR, float& outputL, fl
         int delayInt = static_cast<int>(delaySamples);
         float delayFrac = delaySamples - delayInt;
 
-        int readIdx1 = (mWriteIndex - delayInt + mBufferSize) % mBufferSize;
-        int readIdx2 = (readIdx1 - 1 + mBufferSize) % mBufferSize;
+        // [0] is one sample older than [1]; the guard tail keeps the pair contiguous
+        uint32_t readIdx = static_cast<uint32_t>(mWriteIndex - delayInt - 1) & mBufferMask;
+        const float* pairL = mDelayBufferL.data() + readIdx;
+        const float* pairR = mDelayBufferR.data() + readIdx;
 
-        float tapOutL = mDelayBufferL[readIdx1] * (1.0f - delayFrac) +
-                       mDelayBufferL[readIdx2] * delayFrac;
-        float tapOutR = mDelayBufferR[readIdx1] * (1.0f - delayFrac) +
-                       mDelayBufferR[readIdx2] * delayFrac;
+        float tapOutL = pairL[1] * (1.0f - delayFrac) + pairL[0] * delayFrac;
+        float tapOutR = pairR[1] * (1.0f - delayFrac) + pairR[0] * delayFrac;
 
         float densityGain = 1.0f / std::sqrt(static_cast<float>(mNumActiveTaps));
         float slopeGain = getTapGain(tap);
@@ -456,18 +459,17 @@ void CombProcessor::processStereo(float inputL, float inputR, float& outputL, fl
     int maxDelayInt = static_cast<int>(maxDelaySamples);
     float maxDelayFrac = maxDelaySamples - maxDelayInt;
 
-    int feedbackIdx1 = (mWriteIndex - maxDelayInt + mBufferSize) % mBufferSize;
-    int feedbackIdx2 = (feedbackIdx1 - 1 + mBufferSize) % mBufferSize;
+    uint32_t feedbackIdx = static_cast<uint32_t>(mWriteIndex - maxDelayInt - 1) & mBufferMask;
+    const float* feedbackPairL = mDelayBufferL.data() + feedbackIdx;
+    const float* feedbackPairR = mDelayBufferR.data() + feedbackIdx;
 
-    float feedbackL = mDelayBufferL[feedbackIdx1] * (1.0f - maxDelayFrac) +
-                     mDelayBufferL[feedbackIdx2] * maxDelayFrac;
-    float feedbackR = mDelayBufferR[feedbackIdx1] * (1.0f - maxDelayFrac) +
-                     mDelayBufferR[feedbackIdx2] * maxDelayFrac;
+    float feedbackL = feedbackPairL[1] * (1.0f - maxDelayFrac) + feedbackPairL[0] * maxDelayFrac;
+    float feedbackR = feedbackPairR[1] * (1.0f - maxDelayFrac) + feedbackPairR[0] * maxDelayFrac;
 
     mFeedbackBufferL = tanhLimiter(feedbackL);
     mFeedbackBufferR = tanhLimiter(feedbackR);
 
-    mWriteIndex = (mWriteIndex + 1) % mBufferSize;
+    mWriteIndex = (mWriteIndex + 1) & mBufferMask;
 }
 
 
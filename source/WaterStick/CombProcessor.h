@@ -2,6 +2,7 @@
 
 #include <vector>
 #include "AdaptiveSmoother.h"
+#include "MirroredRingBuffer.h"
 
 namespace WaterStick {
 
@@ -69,9 +70,12 @@ private:
     float getSmoothedPitchCV();
 
     // Internal state
-    std::vector<float> mDelayBufferL;
-    std::vector<float> mDelayBufferR;
+    // Power-of-two rings with a one-sample guard tail: interpolation reads
+    // its two samples as one contiguous pair, wrapped with mBufferMask
+    MirroredRingBuffer mDelayBufferL;
+    MirroredRingBuffer mDelayBufferR;
     int mBufferSize;
+    uint32_t mBufferMask;
     int mWriteIndex;
     double mSampleRate;
 
@@ -1,19 +1,58 @@
 #include "DecoupledDelayArchitecture.h"
+#include "TapMask.h"
+#include "TapMixKernel.h"
 #include <cmath>
 #include <algorithm>
-#include <chrono>
 #include <iostream>
 
 namespace WaterStick {
 
+// ===================================================================
+// 0. SHARED MULTI-TAP DELAY BUFFER IMPLEMENTATION
+// ===================================================================
+
+MultiTapDelayBuffer::MultiTapDelayBuffer()
+: mBufferSize(0)
+, mMask(0)
+, mMaxDelaySamples(0)
+, mWriteIndex(0)
+, mInitialized(false) {
+}
+
+MultiTapDelayBuffer::~MultiTapDelayBuffer() = default;
+
+void MultiTapDelayBuffer::initialize(double sampleRate, double maxDelaySeconds) {
+    // Single buffer per channel - every tap reads from here. The ring is
+    // rounded up to a power of two so heads wrap with a mask, not a division,
+    // and its start repeats after the end so reads of a block never wrap
+    mMaxDelaySamples = static_cast<int>(maxDelaySeconds * sampleRate);
+    mBuffer.allocate(mMaxDelaySamples + WRITE_AHEAD_SAMPLES, GUARD_SAMPLES);
+    mBufferSize = mBuffer.size();
+    mMask = mBuffer.mask();
+    mWriteIndex = 0;
+    mInitialized = true;
+}
+
+void MultiTapDelayBuffer::reset() {
+    if (!mInitialized) return;
+
+    mBuffer.clear();
+    mWriteIndex = 0;
+}
+
+void MultiTapDelayBuffer::writeBlock(const float* input, int numSamples) {
+    // Split at the wrap point; the guard tail is refreshed as needed
+    mBuffer.writeBlock(static_cast<uint32_t>(mWriteIndex), input, numSamples);
+    mWriteIndex = (mWriteIndex + numSamples) & mMask;
+}
+
 // ===================================================================
 // 1. PURE DELAY LINE IMPLEMENTATION
 // ===================================================================
 
 PureDelayLine::PureDelayLine()
-: mBufferSize(0)
-, mWriteIndexA(0)
-, mWriteIndexB(0)
+: mSharedBuffer(nullptr)
+, mBufferMask(0)
 , mSampleRate(44100.0)
 , mInitialized(false)
 , mUsingLineA(true)
@@ -22,39 +61,33 @@ PureDelayLine::PureDelayLine()
 , mCurrentDelayTime(0.1f)
 , mStabilityCounter(0)
 , mStabilityThreshold(2048)
-, mCrossfadeLength(0)
-, mCrossfadePosition(0)
 , mCrossfadeGainA(1.0f)
 , mCrossfadeGainB(0.0f) {
     mStateA.delayInSamples = 0.5f;
-    mStateA.readIndex = 0;
+    mStateA.integerDelay = 0;
     mStateA.allpassCoeff = 0.0f;
     mStateA.apInput = 0.0f;
     mStateA.lastOutput = 0.0f;
-    mStateA.doNextOut = true;
-    mStateA.nextOutput = 0.0f;
 
     mStateB.delayInSamples = 0.5f;
-    mStateB.readIndex = 0;
+    mStateB.integerDelay = 0;
     mStateB.allpassCoeff = 0.0f;
     mStateB.apInput = 0.0f;
     mStateB.lastOutput = 0.0f;
-    mStateB.doNextOut = true;
-    mStateB.nextOutput = 0.0f;
 }
 
 PureDelayLine::~PureDelayLine() = default;
 
-void PureDelayLine::initialize(double sampleRate, double maxDelaySeconds) {
+void PureDelayLine::initialize(double sampleRate, const MultiTapDelayBuffer* sharedBuffer) {
     mSampleRate = sampleRate;
+    mSharedBuffer = sharedBuffer;
 
-    // Dual-buffer sizing for crossfading
-    mBufferSize = static_cast<int>(maxDelaySeconds * sampleRate) + 1024;
-    mBufferA.resize(mBufferSize, 0.0f);
-    mBufferB.resize(mBufferSize, 0.0f);
+    if (!mSharedBuffer || !mSharedBuffer->isInitialized()) {
+        mInitialized = false;
+        return;
+    }
 
-    mWriteIndexA = 0;
-    mWriteIndexB = 0;
+    mBufferMask = mSharedBuffer->getMask();
 
     // Initialize delay states
     updateDelayState(mStateA, mCurrentDelayTime);
@@ -75,18 +108,25 @@ void PureDelayLine::setDelayTime(float delayTimeSeconds) {
     }
 }
 
-void PureDelayLine::processSample(float input, float& output) {
-    if (!mInitialized) {
-        output = input;
-        return;
-    }
+void PureDelayLine::setSourceBuffer(const MultiTapDelayBuffer* buffer) {
+    if (!mInitialized || !buffer || buffer->getMask() != mBufferMask) return;
+
+    mSharedBuffer = buffer;
+}
+
+float PureDelayLine::processSample(int timeIndex) {
+    return processSampleAt(static_cast<uint32_t>(timeIndex) & mBufferMask);
+}
+
+float PureDelayLine::processSampleAt(uint32_t timeIndex) {
+    if (!mInitialized) return 0.0f;
 
     // Check for delay time changes and manage crossfading
     if (std::abs(mTargetDelayTime - mCurrentDelayTime) > 0.001f) {
         mStabilityCounter++;
 
         if (mStabilityCounter >= mStabilityThreshold && mCrossfadeState == STABLE) {
-            startCrossfade();
+            startCrossfade(timeIndex);
         }
     } else {
         mStabilityCounter = 0;
@@ -94,149 +134,159 @@ void PureDelayLine::processSample(float input, float& output) {
 
     updateCrossfade();
 
-    // Process both delay lines
-    float outputA = processDelayLine(mBufferA, mWriteIndexA, mStateA, input);
-    float outputB = processDelayLine(mBufferB, mWriteIndexB, mStateB, input);
-
-    // Mix outputs based on crossfade state
+    // The standby head only reads while it is being faded in or out
     if (mCrossfadeState == STABLE) {
-        output = mUsingLineA ? outputA : outputB;
-    } else {
-        output = (outputA * mCrossfadeGainA) + (outputB * mCrossfadeGainB);
+        return processDelayLine(mUsingLineA ? mStateA : mStateB, timeIndex);
     }
+
+    float outputA = processDelayLine(mStateA, timeIndex);
+    float outputB = processDelayLine(mStateB, timeIndex);
+    return (outputA * mCrossfadeGainA) + (outputB * mCrossfadeGainB);
 }
 
-void PureDelayLine::reset() {
-    if (!mInitialized) return;
+void PureDelayLine::processBlock(int timeIndex, int numSamples, float* output) {
+    // Callers may start past the end; the mask wraps any start index
+    uint32_t index = static_cast<uint32_t>(timeIndex);
+
+    // Delay times only change between blocks, so a settled line stays
+    // settled for the whole block: one allpass run of the active head over a
+    // contiguous span of the (mirrored) shared buffer
+    if (mInitialized && isSettled()) {
+        mStabilityCounter = 0;
+        processHeadBlock(mUsingLineA ? mStateA : mStateB, index & mBufferMask, numSamples, output);
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i) {
+        output[i] = processSampleAt(index & mBufferMask);
+        ++index;
+    }
+}
+
+void PureDelayLine::processHeadBlock(DelayLineState& state, uint32_t timeIndex, int numSamples, float* output) {
+    const float* input = mSharedBuffer->span((timeIndex - static_cast<uint32_t>(state.integerDelay)) & mBufferMask);
+    const float coeff = state.allpassCoeff;
+    float apInput = state.apInput;
+    float lastOutput = state.lastOutput;
+
+    for (int i = 0; i < numSamples; ++i) {
+        float delayedSample = input[i];
+        lastOutput = coeff * (delayedSample - lastOutput) + apInput;
+        apInput = delayedSample;
+        output[i] = lastOutput;
+    }
+
+    state.apInput = apInput;
+    state.lastOutput = lastOutput;
+}
+
+int PureDelayLine::getMinimumReadDistance() const {
+    if (!mInitialized) return 0;
+
+    // A pending target can become the active read position mid-block
+    int distance = std::min(mStateA.integerDelay, mStateB.integerDelay);
+    return std::min(distance, calculateIntegerDelay(mTargetDelayTime));
+}
+
+int PureDelayLine::getMaximumReadDistance() const {
+    if (!mInitialized) return 0;
 
-    // Reset dual buffers
-    std::fill(mBufferA.begin(), mBufferA.end(), 0.0f);
-    std::fill(mBufferB.begin(), mBufferB.end(), 0.0f);
+    // The standby head keeps its old delay but reads nothing outside a crossfade
+    const DelayLineState& active = mUsingLineA ? mStateA : mStateB;
+    const DelayLineState& standby = mUsingLineA ? mStateB : mStateA;
+    int distance = mCrossfadeState == CROSSFADING ? std::max(active.integerDelay, standby.integerDelay) : active.integerDelay;
+    return std::max(distance, calculateIntegerDelay(mTargetDelayTime));
+}
 
-    mWriteIndexA = 0;
-    mWriteIndexB = 0;
+void PureDelayLine::reset() {
+    if (!mInitialized) return;
 
+    // Buffer contents belong to the shared buffer - only head state resets here.
+    // Heads land directly on the target delay; a reset has nothing to crossfade from
     mUsingLineA = true;
     mCrossfadeState = STABLE;
     mStabilityCounter = 0;
-    mCrossfadePosition = 0;
+    mCrossfadeRamp.stop();
     mCrossfadeGainA = 1.0f;
     mCrossfadeGainB = 0.0f;
+    mCurrentDelayTime = mTargetDelayTime;
 
-    mStateA.delayInSamples = 0.5f;
-    mStateA.readIndex = 0;
+    updateDelayState(mStateA, mTargetDelayTime);
     mStateA.apInput = 0.0f;
     mStateA.lastOutput = 0.0f;
-    mStateA.doNextOut = true;
-    mStateA.nextOutput = 0.0f;
 
-    mStateB.delayInSamples = 0.5f;
-    mStateB.readIndex = 0;
+    updateDelayState(mStateB, mTargetDelayTime);
     mStateB.apInput = 0.0f;
     mStateB.lastOutput = 0.0f;
-    mStateB.doNextOut = true;
-    mStateB.nextOutput = 0.0f;
+}
+
+bool PureDelayLine::isSettled() const {
+    return mCrossfadeState == STABLE && std::abs(mTargetDelayTime - mCurrentDelayTime) <= 0.001f;
 }
 
 // Crossfading implementation for zipper-free delay time changes
 void PureDelayLine::updateDelayState(DelayLineState& state, float delayTime) {
     float delaySamples = delayTime * static_cast<float>(mSampleRate);
-    float maxDelaySamples = static_cast<float>(mBufferSize - 1);
+    float maxDelaySamples = static_cast<float>(mSharedBuffer->getMaxDelaySamples());
 
     state.delayInSamples = std::max(0.5f, std::min(delaySamples, maxDelaySamples));
     updateAllpassCoeff(state);
 }
 
-void PureDelayLine::updateAllpassCoeff(DelayLineState& state) {
-    if (state.delayInSamples <= 0.0f) {
-        state.allpassCoeff = 0.0f;
-        return;
-    }
-
-    float integerDelay = std::floor(state.delayInSamples);
-    float fraction = state.delayInSamples - integerDelay;
+int PureDelayLine::calculateIntegerDelay(float delayTime) const {
+    float delaySamples = delayTime * static_cast<float>(mSampleRate);
+    float maxDelaySamples = static_cast<float>(mSharedBuffer->getMaxDelaySamples());
+    delaySamples = std::max(0.5f, std::min(delaySamples, maxDelaySamples));
 
-    if (fraction < 1e-6f) {
-        state.allpassCoeff = 0.0f;
-    } else {
-        // Allpass coefficient for fractional delay
-        state.allpassCoeff = (1.0f - fraction) / (1.0f + fraction);
-    }
+    return static_cast<int>(std::floor(delaySamples - 0.5f));
 }
 
-float PureDelayLine::processDelayLine(std::vector<float>& buffer, int& writeIndex, DelayLineState& state, float input) {
-    // Write input to buffer
-    buffer[writeIndex] = input;
-
-    // Calculate read position with fractional delay
-    float readPosFloat = static_cast<float>(writeIndex) - state.delayInSamples;
-    if (readPosFloat < 0.0f) {
-        readPosFloat += static_cast<float>(mBufferSize);
-    }
-
-    // Get integer and fractional parts
-    int readIndex = static_cast<int>(readPosFloat);
-    float fraction = readPosFloat - static_cast<float>(readIndex);
+void PureDelayLine::updateAllpassCoeff(DelayLineState& state) {
+    // Keep the fractional part in [0.5, 1.5) where the allpass is well behaved
+    state.integerDelay = static_cast<int>(std::floor(state.delayInSamples - 0.5f));
+    float fraction = state.delayInSamples - static_cast<float>(state.integerDelay);
 
-    // Ensure read index is in bounds
-    readIndex = readIndex % mBufferSize;
-    if (readIndex < 0) readIndex += mBufferSize;
+    // Allpass coefficient for fractional delay
+    state.allpassCoeff = (1.0f - fraction) / (1.0f + fraction);
+}
 
-    // Get delayed sample with allpass interpolation
-    float delayedSample = buffer[readIndex];
-    float output;
+float PureDelayLine::processDelayLine(DelayLineState& state, uint32_t timeIndex) {
+    // Reads only buffered input - never the live sample - so a whole block of
+    // outputs can be rendered as long as it stays within integerDelay + 1.
+    // Unsigned subtraction wraps below zero and the mask brings it back
+    uint32_t readIndex = (timeIndex - static_cast<uint32_t>(state.integerDelay)) & mBufferMask;
 
-    if (fraction > 1e-6f) {
-        // Use allpass interpolation for fractional delay
-        output = delayedSample + state.allpassCoeff * (input - state.lastOutput);
-        state.lastOutput = output;
-    } else {
-        // No interpolation needed
-        output = delayedSample;
-        state.lastOutput = output;
-    }
+    float delayedSample = mSharedBuffer->read(static_cast<int>(readIndex));
 
-    // Advance write index
-    writeIndex = (writeIndex + 1) % mBufferSize;
+    // First-order allpass: y[n] = a * (x[n] - y[n-1]) + x[n-1]
+    float output = state.allpassCoeff * (delayedSample - state.lastOutput) + state.apInput;
+    state.apInput = delayedSample;
+    state.lastOutput = output;
 
     return output;
 }
 
-float PureDelayLine::nextOut(DelayLineState& state, const std::vector<float>& buffer) {
-    // Calculate read position
-    float readPosFloat = static_cast<float>(mWriteIndexA) - state.delayInSamples;
-    if (readPosFloat < 0.0f) {
-        readPosFloat += static_cast<float>(mBufferSize);
-    }
-
-    int readIndex = static_cast<int>(readPosFloat);
-    readIndex = readIndex % mBufferSize;
-    if (readIndex < 0) readIndex += mBufferSize;
-
-    return buffer[readIndex];
-}
-
-void PureDelayLine::startCrossfade() {
+void PureDelayLine::startCrossfade(uint32_t timeIndex) {
     mCrossfadeState = CROSSFADING;
-    mCrossfadeLength = calculateCrossfadeLength(mTargetDelayTime);
-    mCrossfadePosition = 0;
-
-    // Update the standby line with new delay time
-    if (mUsingLineA) {
-        updateDelayState(mStateB, mTargetDelayTime);
-    } else {
-        updateDelayState(mStateA, mTargetDelayTime);
-    }
+    mCrossfadeRamp.start(FadeRamp::Curve::RaisedCosine, FadeRamp::Direction::Out,
+                         calculateCrossfadeLength(mTargetDelayTime));
+
+    // Update the standby line with new delay time. It has been idle, so its
+    // allpass starts from the sample before its new read position; the fade
+    // in starts at zero gain and hides what remains of that transient
+    DelayLineState& standby = mUsingLineA ? mStateB : mStateA;
+    updateDelayState(standby, mTargetDelayTime);
+
+    uint32_t previousIndex = (timeIndex - static_cast<uint32_t>(standby.integerDelay) - 1) & mBufferMask;
+    standby.apInput = mSharedBuffer->read(static_cast<int>(previousIndex));
+    standby.lastOutput = standby.apInput;
 }
 
 void PureDelayLine::updateCrossfade() {
     if (mCrossfadeState != CROSSFADING) return;
 
-    float progress = static_cast<float>(mCrossfadePosition) / static_cast<float>(mCrossfadeLength);
-    progress = std::min(progress, 1.0f);
-
-    // Exponential fade curves for smooth transitions
-    float fadeOut = 0.5f * (1.0f + cosf(progress * 3.14159265f));
+    // Raised-cosine pair, equal gain: the heads read the same signal
+    float fadeOut = mCrossfadeRamp.next();
     float fadeIn = 1.0f - fadeOut;
 
     if (mUsingLineA) {
@@ -247,9 +297,7 @@ void PureDelayLine::updateCrossfade() {
         mCrossfadeGainB = fadeOut;
     }
 
-    mCrossfadePosition++;
-
-    if (mCrossfadePosition >= mCrossfadeLength) {
+    if (!mCrossfadeRamp.isActive()) {
         mCrossfadeState = STABLE;
         mUsingLineA = !mUsingLineA;
         mCurrentDelayTime = mTargetDelayTime;
@@ -285,257 +333,130 @@ PitchCoordinator::~PitchCoordinator() = default;
 
 void PitchCoordinator::initialize(double sampleRate) {
     mSampleRate = sampleRate;
-    mSystemHealthy.store(true, std::memory_order_release);
-    mActiveTaps.store(0, std::memory_order_release);
-    mFailedTaps.store(0, std::memory_order_release);
-    mMaxProcessingTime.store(0.0, std::memory_order_release);
+    mSystemHealthy.store(true);
+    mActiveTaps.store(0);
+    mFailedTaps.store(0);
+    mMaxProcessingTime.store(0.0);
 
     // Initialize all tap states
+    mSemitones.fill(0);
+    mEnabled.reset();
+    mNeedsReset.reset();
     for (int i = 0; i < MAX_TAPS; ++i) {
-        auto& state = mTapStates[i];
-        state.semitones = 0;
-        state.pitchRatio = 1.0f;
-        state.enabled = false;
-        state.needsReset = false;
-        state.pitchWriteIndex = 0;
-        state.pitchReadPosition = 0.0f;
-        state.targetPitchRatio = 1.0f;
-        state.currentPitchRatio = 1.0f;
+        mGrainBank.setRatio(i, 1.0f);
+    }
+
+    // Allocate (or clear) the grain histories; blocks never exceed the
+    // delay buffer's write-ahead
+    mGrainBank.initialize(sampleRate, MultiTapDelayBuffer::WRITE_AHEAD_SAMPLES);
+}
 
-        // Calculate smoothing coefficient (5ms time constant)
-        const float timeConstantSec = 5.0f / 1000.0f;
-        state.smoothingCoeff = std::exp(-1.0f / (timeConstantSec * static_cast<float>(mSampleRate)));
+float PitchCoordinator::ratioForSemitones(int semitones) {
+    if (semitones == 0) return 1.0f;
 
-        // Clear pitch buffer
-        state.pitchBuffer.fill(0.0f);
-    }
+    // Calculate pitch ratio: 2^(semitones/12), clamped to safe bounds
+    float ratio = std::pow(2.0f, static_cast<float>(semitones) / 12.0f);
+    return std::max(0.25f, std::min(4.0f, ratio));
 }
 
 void PitchCoordinator::enableTap(int tapIndex, bool enable) {
     if (tapIndex < 0 || tapIndex >= MAX_TAPS) return;
 
-    auto& state = mTapStates[tapIndex];
+    if (mEnabled[tapIndex] != enable) {
+        mEnabled[tapIndex] = enable;
+        mNeedsReset[tapIndex] = true;
 
-    if (state.enabled != enable) {
-        state.enabled = enable;
-        state.needsReset = true;
-
-        if (enable) {
-            mActiveTaps.fetch_add(1, std::memory_order_acq_rel);
-        } else {
-            mActiveTaps.fetch_sub(1, std::memory_order_acq_rel);
-        }
+        mActiveTaps.store(static_cast<int>(mEnabled.count()));
     }
 }
 
 void PitchCoordinator::setPitchShift(int tapIndex, int semitones) {
     if (tapIndex < 0 || tapIndex >= MAX_TAPS) return;
 
-    auto& state = mTapStates[tapIndex];
-
-    if (state.semitones != semitones) {
-        state.semitones = std::max(-12, std::min(12, semitones));
-
-        // Calculate pitch ratio: 2^(semitones/12)
-        if (state.semitones == 0) {
-            state.targetPitchRatio = 1.0f;
-        } else {
-            state.targetPitchRatio = std::pow(2.0f, static_cast<float>(state.semitones) / 12.0f);
-        }
-
-        // Clamp to safe bounds
-        state.targetPitchRatio = std::max(0.25f, std::min(4.0f, state.targetPitchRatio));
+    if (mSemitones[tapIndex] != semitones) {
+        mSemitones[tapIndex] = std::max(-12, std::min(12, semitones));
+        mGrainBank.setRatio(tapIndex, ratioForSemitones(mSemitones[tapIndex]));
     }
 }
 
 void PitchCoordinator::processAllTaps(const float* delayOutputs, float* pitchOutputs) {
-    if (!mSystemHealthy.load(std::memory_order_acquire)) {
-        // System unhealthy - pass through delay outputs
-        for (int i = 0; i < MAX_TAPS; ++i) {
-            pitchOutputs[i] = delayOutputs[i];
-        }
-        return;
-    }
-
-    auto startTime = std::chrono::high_resolution_clock::now();
-    int processedTaps = 0;
-    int failedTaps = 0;
-
-    // Process all enabled taps
+    std::array<const float*, MAX_TAPS> inputs;
+    std::array<float*, MAX_TAPS> outputs;
     for (int i = 0; i < MAX_TAPS; ++i) {
-        auto& state = mTapStates[i];
-
-        if (!state.enabled) {
-            pitchOutputs[i] = delayOutputs[i];
-            continue;
-        }
-
-        try {
-            processSingleTap(i, delayOutputs[i], pitchOutputs[i]);
-            processedTaps++;
-
-            // Check processing time budget
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            auto elapsedUs = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                currentTime - startTime).count() / 1000.0;
-
-            if (elapsedUs > PROCESSING_TIMEOUT_US) {
-                // Budget exceeded - pass through remaining taps
-                for (int j = i + 1; j < MAX_TAPS; ++j) {
-                    pitchOutputs[j] = delayOutputs[j];
-                }
-                break;
-            }
-
-        } catch (...) {
-            // Tap failed - pass through delay output
-            pitchOutputs[i] = delayOutputs[i];
-            performTapRecovery(i);
-            failedTaps++;
-        }
+        inputs[i] = delayOutputs + i;
+        outputs[i] = pitchOutputs + i;
     }
 
-    // Update system stats
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto totalTimeUs = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        endTime - startTime).count() / 1000.0;
-
-    mMaxProcessingTime.store(
-        std::max(mMaxProcessingTime.load(std::memory_order_acquire), totalTimeUs),
-        std::memory_order_release
-    );
-
-    // Update tap counts
-    mActiveTaps.store(processedTaps, std::memory_order_release);
-    mFailedTaps.store(failedTaps, std::memory_order_release);
-
-    // Check system health
-    if (failedTaps > MAX_TAPS / 2) {
-        mSystemHealthy.store(false, std::memory_order_release);
-    }
+    processBlock(inputs.data(), outputs.data(), 1);
 }
 
-void PitchCoordinator::processSingleTap(int tapIndex, float delayOutput, float& pitchOutput) {
-    auto& state = mTapStates[tapIndex];
-
-    // Handle reset if needed
-    if (state.needsReset) {
-        resetTapBuffer(tapIndex);
-        state.needsReset = false;
+void PitchCoordinator::processBlock(const float* const* delayOutputs, float* const* pitchOutputs, int numSamples,
+                                    uint32_t awakeTaps) {
+    if (!mSystemHealthy.load()) {
+        // System unhealthy - pass through delay outputs
+        for (int i = 0; i < MAX_TAPS; ++i) {
+            std::copy(delayOutputs[i], delayOutputs[i] + numSamples, pitchOutputs[i]);
+        }
+        return;
     }
 
-    // Update parameters
-    updateTapParameters(tapIndex);
+    BlockTimer timer;
+    timer.start();
 
-    // If no pitch shift, pass through
-    if (std::abs(state.currentPitchRatio - 1.0f) < 1e-6f) {
-        pitchOutput = delayOutput;
-        return;
+    // Taps enabled or disabled since the last block restart their grains
+    if (mNeedsReset.any()) {
+        for (int i = 0; i < MAX_TAPS; ++i) {
+            if (mNeedsReset[i]) mGrainBank.resetLane(i);
+        }
+        mNeedsReset.reset();
     }
 
-    // Write to pitch buffer
-    state.pitchBuffer[state.pitchWriteIndex] = delayOutput;
-    state.pitchWriteIndex = (state.pitchWriteIndex + 1) % PITCH_BUFFER_SIZE;
+    // Lanes run in whole batches up to the highest awake tap; the bank
+    // restarts the histories of lanes it skips when they run again
+    const int numLanes = TapMask::span(awakeTaps & ((1u << MAX_TAPS) - 1));
+    mGrainBank.processBlock(delayOutputs, pitchOutputs, numSamples, numLanes);
 
-    // Calculate read position based on pitch ratio
-    state.pitchReadPosition += state.currentPitchRatio;
-
-    // Wrap read position
-    if (state.pitchReadPosition >= PITCH_BUFFER_SIZE) {
-        state.pitchReadPosition -= PITCH_BUFFER_SIZE;
+    if (!mEnabled.all()) {
+        for (int i = 0; i < MAX_TAPS; ++i) {
+            if (!mEnabled[i]) {
+                std::copy(delayOutputs[i], delayOutputs[i] + numSamples, pitchOutputs[i]);
+            }
+        }
     }
 
-    // Validate read position
-    if (!validateTapState(tapIndex)) {
-        performTapRecovery(tapIndex);
-        pitchOutput = delayOutput;
-        return;
+    if (BlockTimer::ENABLED) {
+        mMaxProcessingTime.storeMax(timer.lap());
     }
-
-    // Interpolate output
-    pitchOutput = interpolatePitchBuffer(tapIndex, state.pitchReadPosition);
-}
-
-void PitchCoordinator::updateTapParameters(int tapIndex) {
-    auto& state = mTapStates[tapIndex];
-
-    // Smooth pitch ratio changes
-    state.currentPitchRatio = state.smoothingCoeff * state.currentPitchRatio +
-                             (1.0f - state.smoothingCoeff) * state.targetPitchRatio;
-
-    // Clamp to safe bounds
-    state.currentPitchRatio = std::max(0.25f, std::min(4.0f, state.currentPitchRatio));
-}
-
-void PitchCoordinator::performTapRecovery(int tapIndex) {
-    auto& state = mTapStates[tapIndex];
-
-    // Reset pitch buffer
-    resetTapBuffer(tapIndex);
-
-    // Reset processing state
-    state.currentPitchRatio = state.targetPitchRatio;
-    state.pitchReadPosition = static_cast<float>(PITCH_BUFFER_SIZE / 2);
-}
-
-bool PitchCoordinator::validateTapState(int tapIndex) const {
-    const auto& state = mTapStates[tapIndex];
-
-    return std::isfinite(state.pitchReadPosition) &&
-           std::isfinite(state.currentPitchRatio) &&
-           state.pitchReadPosition >= 0.0f &&
-           state.pitchReadPosition < PITCH_BUFFER_SIZE &&
-           state.currentPitchRatio > 0.0f;
-}
-
-float PitchCoordinator::interpolatePitchBuffer(int tapIndex, float position) const {
-    const auto& state = mTapStates[tapIndex];
-
-    // Get integer and fractional parts
-    int intPos = static_cast<int>(position);
-    float frac = position - static_cast<float>(intPos);
-
-    // Ensure bounds
-    intPos = intPos % PITCH_BUFFER_SIZE;
-    if (intPos < 0) intPos += PITCH_BUFFER_SIZE;
-
-    int nextPos = (intPos + 1) % PITCH_BUFFER_SIZE;
-
-    // Linear interpolation
-    return state.pitchBuffer[intPos] * (1.0f - frac) + state.pitchBuffer[nextPos] * frac;
-}
-
-void PitchCoordinator::resetTapBuffer(int tapIndex) {
-    auto& state = mTapStates[tapIndex];
-
-    state.pitchBuffer.fill(0.0f);
-    state.pitchWriteIndex = 0;
-    state.pitchReadPosition = static_cast<float>(PITCH_BUFFER_SIZE / 2);
 }
 
 void PitchCoordinator::getSystemStats(int& activeTaps, int& failedTaps, double& maxProcessingTime) const {
-    activeTaps = mActiveTaps.load(std::memory_order_acquire);
-    failedTaps = mFailedTaps.load(std::memory_order_acquire);
-    maxProcessingTime = mMaxProcessingTime.load(std::memory_order_acquire);
+    activeTaps = mActiveTaps.load();
+    failedTaps = mFailedTaps.load();
+    maxProcessingTime = mMaxProcessingTime.load();
 }
 
 void PitchCoordinator::reset() {
-    mSystemHealthy.store(true, std::memory_order_release);
-    mActiveTaps.store(0, std::memory_order_release);
-    mFailedTaps.store(0, std::memory_order_release);
-    mMaxProcessingTime.store(0.0, std::memory_order_release);
-
+    mSystemHealthy.store(true);
+    mActiveTaps.store(0);
+    mFailedTaps.store(0);
+    mMaxProcessingTime.store(0.0);
+
+    mSemitones.fill(0);
+    mEnabled.reset();
+    mNeedsReset.reset();
     for (int i = 0; i < MAX_TAPS; ++i) {
-        resetTapBuffer(i);
-        auto& state = mTapStates[i];
-        state.enabled = false;
-        state.semitones = 0;
-        state.targetPitchRatio = 1.0f;
-        state.currentPitchRatio = 1.0f;
-        state.needsReset = false;
+        mGrainBank.setRatio(i, 1.0f);
+        mGrainBank.resetLane(i);
     }
 }
 
+void PitchCoordinator::resetTap(int tapIndex) {
+    if (tapIndex < 0 || tapIndex >= MAX_TAPS) return;
+
+    mGrainBank.resetLane(tapIndex);
+    mNeedsReset[tapIndex] = false;
+}
+
 // ===================================================================
 // 3. DECOUPLED TAP PROCESSOR IMPLEMENTATION
 // ===================================================================
@@ -547,15 +468,16 @@ DecoupledTapProcessor::DecoupledTapProcessor()
 , mPitchHealthy(true)
 , mPitchEnabled(false)
 , mPitchSemitones(0)
-, mLastDelayOutput(0.0f) {
+, mLastDelayOutput(0.0f)
+, mSilentSamples(0) {
     mDelayLine = std::make_unique<PureDelayLine>();
 }
 
 DecoupledTapProcessor::~DecoupledTapProcessor() = default;
 
-void DecoupledTapProcessor::initialize(double sampleRate, double maxDelaySeconds, int tapIndex) {
+void DecoupledTapProcessor::initialize(double sampleRate, const MultiTapDelayBuffer* sharedBuffer, int tapIndex) {
     mTapIndex = tapIndex;
-    mDelayLine->initialize(sampleRate, maxDelaySeconds);
+    mDelayLine->initialize(sampleRate, sharedBuffer);
     mDelayHealthy = mDelayLine->isInitialized();
     mPitchHealthy = true;
     mLastDelayOutput = 0.0f;
@@ -579,18 +501,40 @@ void DecoupledTapProcessor::setPitchShift(int semitones) {
     mPitchEnabled = (semitones != 0);
 }
 
-void DecoupledTapProcessor::processSample(float input, float& output) {
+void DecoupledTapProcessor::processBlock(int timeIndex, int numSamples, float* output) {
     if (!mEnabled || !mDelayHealthy) {
-        output = 0.0f;
+        std::fill(output, output + numSamples, 0.0f);
         mLastDelayOutput = 0.0f;
+        mSilentSamples = std::max(0, mSilentSamples - numSamples);
         return;
     }
 
+    int silent = std::min(mSilentSamples, numSamples);
+    if (silent > 0) {
+        // A silent head can follow a new delay time directly, no crossfade
+        if (!mDelayLine->isSettled()) {
+            int previousDelay = mDelayLine->getMinimumReadDistance();
+            mDelayLine->reset();
+            mSilentSamples = std::max(0, mSilentSamples + mDelayLine->getMinimumReadDistance() - previousDelay);
+            silent = std::min(mSilentSamples, numSamples);
+        }
+
+        // The head is not run while silent, so its allpass state stays clear
+        std::fill(output, output + silent, 0.0f);
+        mSilentSamples -= silent;
+        mLastDelayOutput = 0.0f;
+        if (silent == numSamples) return;
+
+        timeIndex += silent;
+        output += silent;
+        numSamples -= silent;
+    }
+
     // Process delay (always works)
-    mDelayLine->processSample(input, mLastDelayOutput);
+    mDelayLine->processBlock(timeIndex, numSamples, output);
 
     // Output is delay result - pitch processing happens at coordinator level
-    output = mLastDelayOutput;
+    mLastDelayOutput = output[numSamples - 1];
 }
 
 void DecoupledTapProcessor::reset() {
@@ -598,6 +542,14 @@ void DecoupledTapProcessor::reset() {
         mDelayLine->reset();
     }
     mLastDelayOutput = 0.0f;
+    mSilentSamples = 0;
+}
+
+void DecoupledTapProcessor::resetAndSilence(int pendingSamples) {
+    reset();
+    if (mDelayHealthy) {
+        mSilentSamples = pendingSamples + mDelayLine->getMinimumReadDistance();
+    }
 }
 
 // ===================================================================
@@ -606,37 +558,65 @@ void DecoupledTapProcessor::reset() {
 
 DecoupledDelaySystem::DecoupledDelaySystem()
 : mSampleRate(44100.0)
-, mPitchProcessingEnabled(true) {
+, mPitchProcessingEnabled(true)
+, mDelayReadMode(DelayReadMode::Crossfade)
+, mPitchRouting(PitchRouting::PerTap)
+, mPitchClassesDirty(false)
+, mMaxDelaySeconds(0.0)
+, mClassBuffersInStep(0)
+, mReadIndex(0)
+, mSleepingTaps(0)
+, mWakeOnInput(0)
+, mMaxBlockSize(0) {
     mPitchCoordinator = std::make_unique<PitchCoordinator>();
-    mDelayOutputs.fill(0.0f);
-    mPitchOutputs.fill(0.0f);
+    mTapClass.fill(-1);
+    prepareBlockProcessing(DEFAULT_MAX_BLOCK_SIZE);
 }
 
 DecoupledDelaySystem::~DecoupledDelaySystem() = default;
 
 void DecoupledDelaySystem::initialize(double sampleRate, double maxDelaySeconds) {
     mSampleRate = sampleRate;
+    mMaxDelaySeconds = maxDelaySeconds;
+
+    // One buffer for the whole channel, then attach the read heads
+    mDelayBuffer.initialize(sampleRate, maxDelaySeconds);
 
-    // Initialize delay processors
     for (int i = 0; i < NUM_TAPS; ++i) {
-        mTapProcessors[i].initialize(sampleRate, maxDelaySeconds, i);
+        mTapProcessors[i].initialize(sampleRate, &mDelayBuffer, i);
     }
+    mGlideBank.initialize(sampleRate, mDelayBuffer.getMaxDelaySamples());
+
+    // Class buffers match the main one. Only those already allocated follow
+    // the new rate; the rest wait for allocatePitchClassBuffers()
+    mClassBuffersInStep = mClassBuffersReady.load(std::memory_order_acquire);
+    for (int c = 0; c < mClassBuffersInStep; ++c) {
+        mClassBuffers[c].initialize(sampleRate, maxDelaySeconds);
+    }
+    mClassSemitones.fill(0);
+    mTapClass.fill(-1);
+    mClassShifter.initialize(sampleRate, MultiTapDelayBuffer::WRITE_AHEAD_SAMPLES);
+    mPitchClassesDirty = true;
+
+    mReadIndex = mDelayBuffer.getWriteIndex();
 
     // Initialize pitch coordinator
     mPitchCoordinator->initialize(sampleRate);
 
-    mDelayProcessingTime.store(0.0, std::memory_order_release);
-    mPitchProcessingTime.store(0.0, std::memory_order_release);
+    mDelayProcessingTime.store(0.0);
+    mPitchProcessingTime.store(0.0);
 }
 
 void DecoupledDelaySystem::setTapDelayTime(int tapIndex, float delayTimeSeconds) {
     if (tapIndex >= 0 && tapIndex < NUM_TAPS) {
         mTapProcessors[tapIndex].setDelayTime(delayTimeSeconds);
+        mGlideBank.setDelayTime(tapIndex, delayTimeSeconds);
     }
 }
 
 void DecoupledDelaySystem::setTapEnabled(int tapIndex, bool enabled) {
     if (tapIndex >= 0 && tapIndex < NUM_TAPS) {
+        mPitchClassesDirty = mPitchClassesDirty || mTapProcessors[tapIndex].mEnabled != enabled;
         mTapProcessors[tapIndex].setEnabled(enabled);
         mPitchCoordinator->enableTap(tapIndex, enabled);
     }
@@ -645,65 +625,358 @@ void DecoupledDelaySystem::setTapEnabled(int tapIndex, bool enabled) {
 void DecoupledDelaySystem::setTapPitchShift(int tapIndex, int semitones) {
     if (tapIndex >= 0 && tapIndex < NUM_TAPS) {
         mTapProcessors[tapIndex].setPitchShift(semitones);
-        mPitchCoordinator->setPitchShift(tapIndex, semitones);
+
+        // Taps served by a class have their coordinator lanes at unity
+        if (mPitchRouting == PitchRouting::Shared) {
+            mPitchClassesDirty = true;
+        } else {
+            mPitchCoordinator->setPitchShift(tapIndex, semitones);
+        }
+    }
+}
+
+void DecoupledDelaySystem::prepareBlockProcessing(int maxBlockSize) {
+    mMaxBlockSize = std::max(1, std::min(maxBlockSize, MultiTapDelayBuffer::WRITE_AHEAD_SAMPLES));
+
+    // One contiguous scratch region, sliced per tap
+    mDelayScratch.assign(static_cast<size_t>(NUM_TAPS) * mMaxBlockSize, 0.0f);
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        mDelayOutputs[i] = mDelayScratch.data() + static_cast<size_t>(i) * mMaxBlockSize;
+    }
+
+    mClassScratch.assign(static_cast<size_t>(MAX_PITCH_CLASSES) * mMaxBlockSize, 0.0f);
+    for (int c = 0; c < MAX_PITCH_CLASSES; ++c) {
+        mClassOutputs[c] = mClassScratch.data() + static_cast<size_t>(c) * mMaxBlockSize;
     }
 }
 
 void DecoupledDelaySystem::processAllTaps(float input, float* outputs) {
-    mProcessingStartTime = std::chrono::high_resolution_clock::now();
+    std::array<float*, NUM_TAPS> tapOutputs;
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        tapOutputs[i] = outputs + i;
+    }
+
+    processBlock(&input, 1, tapOutputs.data());
+}
+
+void DecoupledDelaySystem::processBlock(const float* input, int numSamples, float* const* tapOutputs) {
+    // Without a feedback loop the whole chunk can be written before it is read
+    std::array<float*, NUM_TAPS> chunkOutputs;
+    int offset = 0;
+
+    while (offset < numSamples) {
+        int chunk = std::min(numSamples - offset, mMaxBlockSize);
+
+        for (int i = 0; i < NUM_TAPS; ++i) {
+            chunkOutputs[i] = tapOutputs[i] + offset;
+        }
+
+        writeBlock(input + offset, chunk);
+        readBlock(chunk, chunkOutputs.data());
+        offset += chunk;
+    }
+}
+
+void DecoupledDelaySystem::allocatePitchClassBuffers(int count) {
+    if (!mDelayBuffer.isInitialized()) return;
+
+    int wanted = std::min(MAX_PITCH_CLASSES, std::max(count, mClassBuffersWanted.load(std::memory_order_relaxed)));
+    for (int c = mClassBuffersReady.load(std::memory_order_relaxed); c < wanted; ++c) {
+        mClassBuffers[c].initialize(mSampleRate, mMaxDelaySeconds);
+        mClassBuffersReady.store(c + 1, std::memory_order_release);
+    }
+}
+
+void DecoupledDelaySystem::writeBlock(const float* input, int numSamples) {
+    // Buffers published since the last block join at the current write
+    // position and may take classes from here on
+    int ready = mClassBuffersReady.load(std::memory_order_acquire);
+    if (ready > mClassBuffersInStep) {
+        for (int c = mClassBuffersInStep; c < ready; ++c) {
+            mClassBuffers[c].skip(mDelayBuffer.getWriteIndex());
+        }
+        mClassBuffersInStep = ready;
+        mPitchClassesDirty = true;
+    }
+
+    // Class changes take effect from this block's input on
+    if (mPitchClassesDirty) {
+        updatePitchClasses();
+    }
+
+    mDelayBuffer.writeBlock(input, numSamples);
+
+    for (int offset = 0; offset < numSamples; offset += mMaxBlockSize) {
+        writeClassBuffers(input + offset, std::min(numSamples - offset, mMaxBlockSize));
+    }
+}
+
+void DecoupledDelaySystem::writeClassBuffers(const float* input, int numSamples) {
+    // The shifter runs up to the highest class in use, one batch for a few
+    int lanes = 0;
+    for (int c = 0; c < MAX_PITCH_CLASSES; ++c) {
+        if (mClassSemitones[c] != 0) lanes = c + 1;
+    }
+
+    if (lanes > 0) {
+        std::array<const float*, MAX_PITCH_CLASSES> inputs;
+        inputs.fill(input);
+        mClassShifter.processBlock(inputs.data(), mClassOutputs.data(), numSamples, lanes);
+    }
+
+    for (int c = 0; c < mClassBuffersInStep; ++c) {
+        if (mClassSemitones[c] != 0) {
+            mClassBuffers[c].writeBlock(mClassOutputs[c], numSamples);
+        } else {
+            mClassBuffers[c].skip(numSamples);
+        }
+    }
+}
+
+void DecoupledDelaySystem::readBlock(int numSamples, float* const* tapOutputs) {
+    BlockTimer timer;
+    timer.start();
 
     // Stage 1: Process delays (always works, never fails)
-    processDelayStage(input);
+    processDelayStage(numSamples);
+    double delayTimeUs = timer.lap();
+
+    // Sleeping taps whose delay output has energy again take part in the
+    // pitch stage of this block
+    TapMask::forEach(mSleepingTaps & mWakeOnInput, [&](int i) {
+        if (TapMixKernel::peak(mDelayOutputs[i], numSamples) > SLEEP_THRESHOLD) {
+            mSleepingTaps &= ~(1u << i);
+        }
+    });
 
-    auto delayEndTime = std::chrono::high_resolution_clock::now();
-    auto delayTimeUs = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        delayEndTime - mProcessingStartTime).count() / 1000.0;
-    mDelayProcessingTime.store(delayTimeUs, std::memory_order_release);
+    // Stage 2: Process pitch (optional, can fail gracefully) into the outputs
+    processPitchStage(numSamples, tapOutputs);
+    double pitchTimeUs = timer.lap();
 
-    // Stage 2: Process pitch (optional, can fail gracefully)
-    if (mPitchProcessingEnabled) {
-        processPitchStage();
-    } else {
-        // Pitch disabled - copy delay outputs
-        mPitchOutputs = mDelayOutputs;
+    if (BlockTimer::ENABLED) {
+        mDelayProcessingTime.store(delayTimeUs);
+        mPitchProcessingTime.store(pitchTimeUs);
     }
+}
 
-    auto pitchEndTime = std::chrono::high_resolution_clock::now();
-    auto pitchTimeUs = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        pitchEndTime - delayEndTime).count() / 1000.0;
-    mPitchProcessingTime.store(pitchTimeUs, std::memory_order_release);
+int DecoupledDelaySystem::getMaxFeedbackBlockSize() const {
+    // An output may depend on input up to its tap's whole-sample delay, so the
+    // shortest active tap bounds how far ahead of the feedback path we can run
+    int maxBlock = mMaxBlockSize;
 
-    // Stage 3: Combine outputs
-    combineOutputs(outputs);
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        const auto& processor = mTapProcessors[i];
+        if (processor.mEnabled && processor.mDelayHealthy) {
+            int distance = mDelayReadMode == DelayReadMode::Glide
+                ? mGlideBank.getMinimumReadDistance(i)
+                : processor.getMinimumReadDistance();
+            maxBlock = std::min(maxBlock, distance + 1);
+        }
+    }
 
-    updatePerformanceMetrics();
+    return std::max(1, maxBlock);
 }
 
-void DecoupledDelaySystem::processDelayStage(float input) {
-    // Process all delay taps - this always works
+int DecoupledDelaySystem::getMaxReadDistance() const {
+    int distance = 0;
+
     for (int i = 0; i < NUM_TAPS; ++i) {
-        mTapProcessors[i].processSample(input, mDelayOutputs[i]);
+        const auto& processor = mTapProcessors[i];
+        if (processor.mEnabled && processor.mDelayHealthy) {
+            distance = std::max(distance, mDelayReadMode == DelayReadMode::Glide
+                ? mGlideBank.getMaximumReadDistance(i)
+                : processor.getMaximumReadDistance());
+        }
     }
+
+    return distance;
 }
 
-void DecoupledDelaySystem::processPitchStage() {
-    if (mPitchCoordinator->isHealthy()) {
-        // Coordinated pitch processing
-        mPitchCoordinator->processAllTaps(mDelayOutputs.data(), mPitchOutputs.data());
+void DecoupledDelaySystem::processDelayStage(int numSamples) {
+    // Every tap reads the same span of the shared buffer
+    if (mDelayReadMode == DelayReadMode::Glide) {
+        processGlideStage(numSamples);
     } else {
-        // Pitch coordinator unhealthy - pass through delay outputs
-        mPitchOutputs = mDelayOutputs;
+        for (int i = 0; i < NUM_TAPS; ++i) {
+            mTapProcessors[i].processBlock(mReadIndex, numSamples, mDelayOutputs[i]);
+        }
     }
+
+    mReadIndex = (mReadIndex + numSamples) & mDelayBuffer.getMask();
+}
+
+void DecoupledDelaySystem::processGlideStage(int numSamples) {
+    // Same gating as DecoupledTapProcessor::processBlock(), for the glide heads
+    std::array<int, NUM_TAPS> silentSamples;
+
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        auto& processor = mTapProcessors[i];
+
+        if (!processor.mEnabled || !processor.mDelayHealthy) {
+            silentSamples[i] = numSamples;
+            processor.mSilentSamples = std::max(0, processor.mSilentSamples - numSamples);
+            continue;
+        }
+
+        // A silent head can jump to a new delay time instead of gliding
+        if (processor.mSilentSamples > 0 && !mGlideBank.isSettled(i)) {
+            int previousDelay = mGlideBank.getMinimumReadDistance(i);
+            mGlideBank.seat(i);
+            processor.mSilentSamples = std::max(0, processor.mSilentSamples + mGlideBank.getMinimumReadDistance(i) - previousDelay);
+        }
+
+        silentSamples[i] = std::min(processor.mSilentSamples, numSamples);
+        processor.mSilentSamples -= silentSamples[i];
+    }
+
+    std::array<const float*, NUM_TAPS> buffers;
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        buffers[i] = tapSource(i).span(0);
+    }
+
+    mGlideBank.processBlock(buffers.data(), mDelayBuffer.getMask(), static_cast<uint32_t>(mReadIndex),
+                            numSamples, silentSamples.data(), mDelayOutputs.data());
+
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        mTapProcessors[i].mLastDelayOutput = mDelayOutputs[i][numSamples - 1];
+    }
+}
+
+void DecoupledDelaySystem::setDelayReadMode(DelayReadMode mode) {
+    if (mode == mDelayReadMode) return;
+
+    // The heads of the other mode have not been following the input
+    mDelayReadMode = mode;
+    reset();
+}
+
+void DecoupledDelaySystem::setPitchRouting(PitchRouting routing) {
+    if (routing == mPitchRouting) return;
+
+    // Only taps whose source changes are reset, at the next write
+    mPitchRouting = routing;
+    mPitchClassesDirty = true;
+}
+
+void DecoupledDelaySystem::setSleepingTaps(uint32_t sleeping, uint32_t wakeOnInput) {
+    mSleepingTaps = sleeping & ((1u << NUM_TAPS) - 1);
+    mWakeOnInput = wakeOnInput;
+}
+
+void DecoupledDelaySystem::setPitchInterpolation(GrainPitchBank::Interpolation interpolation) {
+    mPitchCoordinator->setInterpolation(interpolation);
+    mClassShifter.setInterpolation(interpolation);
+}
+
+int DecoupledDelaySystem::getPitchClassCount() const {
+    int count = 0;
+    for (int semitones : mClassSemitones) {
+        if (semitones != 0) count++;
+    }
+    return count;
+}
+
+int DecoupledDelaySystem::findPitchClass(int semitones) const {
+    if (semitones == 0) return -1;
+
+    for (int c = 0; c < MAX_PITCH_CLASSES; ++c) {
+        if (mClassSemitones[c] == semitones) return c;
+    }
+    return -1;
 }
 
-void DecoupledDelaySystem::combineOutputs(float* outputs) {
-    // Simply copy pitch outputs (which are delay outputs if pitch failed/disabled)
+void DecoupledDelaySystem::updatePitchClasses() {
+    mPitchClassesDirty = false;
+
+    // Enabled taps ask for a class for their interval (same clamp as the
+    // coordinator); in PerTap routing nobody does
+    bool shared = mPitchRouting == PitchRouting::Shared && mPitchProcessingEnabled;
+    std::array<int, NUM_TAPS> wanted;
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        const auto& processor = mTapProcessors[i];
+        wanted[i] = shared && processor.mEnabled && processor.mDelayHealthy
+            ? std::max(-12, std::min(12, processor.mPitchSemitones))
+            : 0;
+    }
+
+    // Ask for a buffer per distinct interval, up to the classes there are
+    int distinct = 0;
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        if (wanted[i] != 0 && std::find(wanted.begin(), wanted.begin() + i, wanted[i]) == wanted.begin() + i) {
+            distinct++;
+        }
+    }
+    distinct = std::min(distinct, MAX_PITCH_CLASSES);
+    if (distinct > mClassBuffersWanted.load(std::memory_order_relaxed)) {
+        mClassBuffersWanted.store(distinct, std::memory_order_relaxed);
+    }
+
+    // Free the classes nobody asks for, then give new intervals a free
+    // class with a buffer in tap order; existing classes keep their slots.
+    // A class freed here and taken again glides to its new interval, so a
+    // lone tap that is retuned keeps its buffer and the audio already in it
+    std::bitset<MAX_PITCH_CLASSES> retunable;
+    for (int c = 0; c < MAX_PITCH_CLASSES; ++c) {
+        if (mClassSemitones[c] != 0 &&
+            std::find(wanted.begin(), wanted.end(), mClassSemitones[c]) == wanted.end()) {
+            mClassSemitones[c] = 0;
+            retunable[c] = true;
+        }
+    }
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        if (wanted[i] == 0 || findPitchClass(wanted[i]) >= 0) continue;
+
+        int c = -1;
+        for (int k = 0; k < MAX_PITCH_CLASSES && c < 0; ++k) {
+            if (retunable[k] && mTapClass[i] == k) c = k;
+        }
+        for (int k = 0; k < mClassBuffersInStep && c < 0; ++k) {
+            if (mClassSemitones[k] == 0) c = k;
+        }
+        if (c < 0) break;  // The rest shift per tap
+
+        mClassSemitones[c] = wanted[i];
+        mClassShifter.setRatio(c, PitchCoordinator::ratioForSemitones(wanted[i]));
+        if (!retunable[c]) mClassShifter.resetLane(c);
+        retunable[c] = false;
+    }
+
     for (int i = 0; i < NUM_TAPS; ++i) {
-        outputs[i] = mPitchOutputs[i];
+        // A disabled tap stays on its class while the class keeps its
+        // interval, so enabling it again does not restart it
+        int semitones = std::max(-12, std::min(12, mTapProcessors[i].mPitchSemitones));
+        int current = mTapClass[i];
+        int target = wanted[i] != 0 ? findPitchClass(wanted[i])
+            : (shared && current >= 0 && mClassSemitones[current] == semitones ? current : -1);
+
+        mPitchCoordinator->setPitchShift(i, target >= 0 ? 0 : mTapProcessors[i].mPitchSemitones);
+
+        if (target != current) {
+            mTapClass[i] = target;
+            mTapProcessors[i].setSourceBuffer(&tapSource(i));
+            resetTap(i);
+        }
     }
 }
 
+void DecoupledDelaySystem::processPitchStage(int numSamples, float* const* tapOutputs) {
+    if (mPitchProcessingEnabled && mPitchCoordinator->isHealthy()) {
+        // Coordinated pitch processing
+        mPitchCoordinator->processBlock(mDelayOutputs.data(), tapOutputs, numSamples, ~mSleepingTaps);
+    } else {
+        // Pitch disabled or coordinator unhealthy - pass through delay outputs
+        for (int i = 0; i < NUM_TAPS; ++i) {
+            std::copy(mDelayOutputs[i], mDelayOutputs[i] + numSamples, tapOutputs[i]);
+        }
+    }
+
+    TapMask::forEach(mSleepingTaps, [&](int i) {
+        std::fill(tapOutputs[i], tapOutputs[i] + numSamples, 0.0f);
+    });
+}
+
 void DecoupledDelaySystem::enablePitchProcessing(bool enable) {
+    mPitchClassesDirty = mPitchClassesDirty || mPitchProcessingEnabled != enable;
     mPitchProcessingEnabled = enable;
 
     if (!enable) {
@@ -713,21 +986,32 @@ void DecoupledDelaySystem::enablePitchProcessing(bool enable) {
 }
 
 void DecoupledDelaySystem::reset() {
-    // Reset all tap processors
-    for (auto& processor : mTapProcessors) {
-        processor.reset();
+    // Every tap restarts on input written from here on; the shared buffer
+    // keeps its contents and is overwritten as the write head moves on
+    for (int i = 0; i < NUM_TAPS; ++i) {
+        resetTap(i);
     }
 
-    // Reset pitch coordinator
-    mPitchCoordinator->reset();
+    // Reset performance metrics
+    mDelayProcessingTime.store(0.0);
+    mPitchProcessingTime.store(0.0);
+}
 
-    // Clear buffers
-    mDelayOutputs.fill(0.0f);
-    mPitchOutputs.fill(0.0f);
+void DecoupledDelaySystem::resetTap(int tapIndex) {
+    if (tapIndex < 0 || tapIndex >= NUM_TAPS) return;
 
-    // Reset performance metrics
-    mDelayProcessingTime.store(0.0, std::memory_order_release);
-    mPitchProcessingTime.store(0.0, std::memory_order_release);
+    // Samples already written but not yet read are old audio too
+    int pendingSamples = static_cast<int>(
+        static_cast<uint32_t>(mDelayBuffer.getWriteIndex() - mReadIndex) & mDelayBuffer.getMask());
+
+    mTapProcessors[tapIndex].resetAndSilence(pendingSamples);
+    mPitchCoordinator->resetTap(tapIndex);
+    mSleepingTaps &= ~(1u << tapIndex);
+
+    mGlideBank.seat(tapIndex);
+    if (mDelayReadMode == DelayReadMode::Glide && mTapProcessors[tapIndex].mDelayHealthy) {
+        mTapProcessors[tapIndex].mSilentSamples = pendingSamples + mGlideBank.getMinimumReadDistance(tapIndex);
+    }
 }
 
 void DecoupledDelaySystem::getSystemHealth(SystemHealth& health) const {
@@ -755,14 +1039,9 @@ void DecoupledDelaySystem::getSystemHealth(SystemHealth& health) const {
     health.failedPitchTaps = failedPitchTaps;
 
     // Get performance metrics
-    health.delayProcessingTime = mDelayProcessingTime.load(std::memory_order_acquire);
-    health.pitchProcessingTime = mPitchProcessingTime.load(std::memory_order_acquire);
+    health.delayProcessingTime = mDelayProcessingTime.load();
+    health.pitchProcessingTime = mPitchProcessingTime.load();
     health.totalProcessingTime = health.delayProcessingTime + health.pitchProcessingTime;
 }
 
-void DecoupledDelaySystem::updatePerformanceMetrics() const {
-    // Performance metrics are updated in processAllTaps()
-    // This method is here for future extensions
-}
-
 } // namespace WaterStick
\ No newline at end of file
@@ -2,8 +2,21 @@
 
 #include <vector>
 #include <memory>
-#include <atomic>
 #include <array>
+#include <bitset>
+#include <atomic>
+#include <cstdint>
+#include "MirroredRingBuffer.h"
+#include "GlidingTapBank.h"
+#include "FadeEngine.h"
+#include "GrainPitchBank.h"
+#include "Instrumentation.h"
+
+// Interpolation policy of the gliding read heads (see DelayInterpolation.h):
+// Linear, Hermite, Lagrange or Allpass
+#ifndef WATERSTICK_GLIDE_INTERPOLATION
+#define WATERSTICK_GLIDE_INTERPOLATION Hermite
+#endif
 
 namespace WaterStick {
 
@@ -17,6 +30,62 @@ namespace WaterStick {
 // 3. Unified coordination: Single coordinator manages all pitch resources
 // 4. Graceful degradation: Delay always works, pitch fails safely
 // 5. Resource isolation: No competition between delay and pitch systems
+// 6. Single write head: All taps read one shared ring buffer per channel
+// 7. Block processing: Every stage has a processBlock() entry point; the
+//    per-sample calls are thin wrappers around it
+
+// ===================================================================
+// 0. SHARED MULTI-TAP DELAY BUFFER (One write per sample, 16 read heads)
+// ===================================================================
+
+class MultiTapDelayBuffer {
+public:
+    // Headroom beyond the longest delay so a block of input can be written
+    // ahead of the read heads without overwriting samples they still need
+    static constexpr int WRITE_AHEAD_SAMPLES = 1024;
+
+    // Longest contiguous read from a wrapped index: a block, or an
+    // interpolation window (blocks are at most WRITE_AHEAD_SAMPLES)
+    static constexpr int GUARD_SAMPLES = WRITE_AHEAD_SAMPLES + DelayInterpolation::MAX_POINTS;
+
+    MultiTapDelayBuffer();
+    ~MultiTapDelayBuffer();
+
+    void initialize(double sampleRate, double maxDelaySeconds);
+
+    // Clears the whole buffer (megabytes); not for the audio thread. Taps
+    // are reset individually instead, see DecoupledDelaySystem::resetTap()
+    void reset();
+
+    // Write the current input sample; read heads see it until advance()
+    void write(float input) { mBuffer.write(static_cast<uint32_t>(mWriteIndex), input); }
+    void advance() { mWriteIndex = (mWriteIndex + 1) & mMask; }
+    void writeBlock(const float* input, int numSamples);  // At most getSize() samples
+
+    // Move the write position on without writing, in step with buffers that
+    // were written; readers must not rely on what it passes over
+    void skip(int numSamples) { mWriteIndex = (mWriteIndex + numSamples) & mMask; }
+
+    float read(int index) const { return mBuffer.data()[index]; }
+
+    // Contiguous view from a wrapped index, valid for up to GUARD_SAMPLES
+    const float* span(uint32_t index) const { return mBuffer.data() + index; }
+
+    int getWriteIndex() const { return mWriteIndex; }
+    int getSize() const { return mBufferSize; }
+    // Size is a power of two; wrap any index with (index & getMask())
+    uint32_t getMask() const { return mMask; }
+    int getMaxDelaySamples() const { return mMaxDelaySamples; }
+    bool isInitialized() const { return mInitialized; }
+
+private:
+    MirroredRingBuffer mBuffer;
+    int mBufferSize;
+    uint32_t mMask;
+    int mMaxDelaySamples;
+    int mWriteIndex;
+    bool mInitialized;
+};
 
 // ===================================================================
 // 1. PURE DELAY SYSTEM (Always works, never affected by pitch)
@@ -27,25 +96,44 @@ public:
     PureDelayLine();
     ~PureDelayLine();
 
-    void initialize(double sampleRate, double maxDelaySeconds);
+    // Read heads only - the audio lives in the shared buffer owned by the system
+    void initialize(double sampleRate, const MultiTapDelayBuffer* sharedBuffer);
     void setDelayTime(float delayTimeSeconds);
-    void processSample(float input, float& output);
+
+    // Read another buffer of the same size and write position instead;
+    // reset afterwards, the heads' state belongs to the old one
+    void setSourceBuffer(const MultiTapDelayBuffer* buffer);
+
+    // Render output for consecutive buffer positions starting at timeIndex
+    // (the buffer index the input of the first output sample was written to)
+    float processSample(int timeIndex);
+    void processBlock(int timeIndex, int numSamples, float* output);
+
+    // Seats both heads on the target delay with cleared allpass state
     void reset();
 
+    // True while no delay time change is pending or crossfading
+    bool isSettled() const;
+
+    // Smallest whole-sample distance either read head (or a pending
+    // crossfade target) can reach; outputs never depend on newer input
+    int getMinimumReadDistance() const;
+
+    // Largest whole-sample distance either head (or the pending target) reads
+    int getMaximumReadDistance() const;
+
     // Pure delay has no pitch coupling whatsoever
     bool isInitialized() const { return mInitialized; }
 
 private:
-    // Dual-buffer system for zipper-free delay time changes
-    std::vector<float> mBufferA;
-    std::vector<float> mBufferB;
-    int mBufferSize;
-    int mWriteIndexA;
-    int mWriteIndexB;
+    // Dual read heads into the shared buffer for zipper-free delay time changes
+    const MultiTapDelayBuffer* mSharedBuffer;
+    uint32_t mBufferMask;
     double mSampleRate;
     bool mInitialized;
 
-    // Active/Standby line management for crossfading
+    // Active/Standby line management for crossfading; the standby head is
+    // idle (no reads, no allpass updates) outside a crossfade
     bool mUsingLineA;
     enum CrossfadeState { STABLE, CROSSFADING };
     CrossfadeState mCrossfadeState;
@@ -56,21 +144,19 @@ private:
     int mStabilityCounter;
     int mStabilityThreshold;
 
-    // Crossfade control for zipper-free modulation
-    int mCrossfadeLength;
-    int mCrossfadePosition;
+    // Crossfade control for zipper-free modulation; the ramp walks the
+    // shared raised-cosine table and yields the fade-out gain
+    FadeRamp mCrossfadeRamp;
     float mCrossfadeGainA;
     float mCrossfadeGainB;
 
-    // Per-line delay state
+    // Per-line delay state (STK-style first-order allpass interpolation)
     struct DelayLineState {
         float delayInSamples;
-        int readIndex;
+        int integerDelay;     // Whole-sample read offset
         float allpassCoeff;
-        float apInput;
+        float apInput;        // Previous delayed sample
         float lastOutput;
-        bool doNextOut;
-        float nextOutput;
     };
 
     DelayLineState mStateA;
@@ -79,11 +165,14 @@ private:
     // Core processing methods
     void updateDelayState(DelayLineState& state, float delayTime);
     void updateAllpassCoeff(DelayLineState& state);
-    float processDelayLine(std::vector<float>& buffer, int& writeIndex, DelayLineState& state, float input);
-    float nextOut(DelayLineState& state, const std::vector<float>& buffer);
+    float processSampleAt(uint32_t timeIndex);  // timeIndex already wrapped
+    float processDelayLine(DelayLineState& state, uint32_t timeIndex);
+    // Whole block of the active head while settled
+    void processHeadBlock(DelayLineState& state, uint32_t timeIndex, int numSamples, float* output);
+    int calculateIntegerDelay(float delayTime) const;
 
     // Crossfading methods for smooth delay time changes
-    void startCrossfade();
+    void startCrossfade(uint32_t timeIndex);
     void updateCrossfade();
     int calculateCrossfadeLength(float delayTime);
 };
@@ -95,61 +184,55 @@ private:
 class PitchCoordinator {
 public:
     static constexpr int MAX_TAPS = 16;
-    static constexpr int PITCH_BUFFER_SIZE = 8192;  // Dedicated pitch buffer per tap
-
-    struct TapPitchState {
-        int semitones = 0;
-        float pitchRatio = 1.0f;
-        bool enabled = false;
-        bool needsReset = false;
-
-        // Dedicated pitch processing buffer (separate from delay)
-        std::array<float, PITCH_BUFFER_SIZE> pitchBuffer{};
-        int pitchWriteIndex = 0;
-        float pitchReadPosition = 0.0f;
-
-        // Pitch-specific state
-        float smoothingCoeff = 1.0f;
-        float targetPitchRatio = 1.0f;
-        float currentPitchRatio = 1.0f;
-    };
 
     PitchCoordinator();
     ~PitchCoordinator();
 
     void initialize(double sampleRate);
 
+    // 2^(semitones / 12) within the shifter's safe range
+    static float ratioForSemitones(int semitones);
+
     // Unified tap management - no resource competition
     void enableTap(int tapIndex, bool enable);
     void setPitchShift(int tapIndex, int semitones);
 
-    // Coordinated processing - all taps processed together
+    // Read-head kernel of every tap's shifter
+    void setInterpolation(GrainPitchBank::Interpolation interpolation) { mGrainBank.setInterpolation(interpolation); }
+
+    // Coordinated processing - all taps processed together. Lanes past the
+    // highest tap in awakeTaps are not run and their outputs not written
     void processAllTaps(const float* delayOutputs, float* pitchOutputs);
+    void processBlock(const float* const* delayOutputs, float* const* pitchOutputs, int numSamples,
+                      uint32_t awakeTaps = ~0u);
 
     // System health monitoring
-    bool isHealthy() const { return mSystemHealthy; }
+    bool isHealthy() const { return mSystemHealthy.load(); }
     void getSystemStats(int& activeTaps, int& failedTaps, double& maxProcessingTime) const;
 
     void reset();
 
+    // Constant-time reset of one tap; its enable and pitch settings are kept
+    void resetTap(int tapIndex);
+
 private:
     double mSampleRate;
-    std::array<TapPitchState, MAX_TAPS> mTapStates;
-    std::atomic<bool> mSystemHealthy{true};
-    std::atomic<int> mActiveTaps{0};
-    std::atomic<int> mFailedTaps{0};
-    std::atomic<double> mMaxProcessingTime{0.0};
-
-    // Unified resource pool
-    static constexpr double PROCESSING_TIMEOUT_US = 100.0;  // 100μs total budget
-
-    void processSingleTap(int tapIndex, float delayOutput, float& pitchOutput);
-    void updateTapParameters(int tapIndex);
-    void performTapRecovery(int tapIndex);
-    bool validateTapState(int tapIndex) const;
-
-    float interpolatePitchBuffer(int tapIndex, float position) const;
-    void resetTapBuffer(int tapIndex);
+
+    // Tap settings, one field per array; ratios and grain state are the
+    // bank's lane arrays
+    std::array<int, MAX_TAPS> mSemitones;
+    std::bitset<MAX_TAPS> mEnabled;
+    std::bitset<MAX_TAPS> mNeedsReset;   // Restart grains at the next block
+
+    // Monitoring, readable from any thread
+    MonitorCounter<bool> mSystemHealthy{true};
+    MonitorCounter<int> mActiveTaps{0};
+    MonitorCounter<int> mFailedTaps{0};
+    MonitorCounter<double> mMaxProcessingTime{0.0};   // Per block, microseconds; instrumented builds only
+
+    // Dual-grain shifter across all taps; constant cost per sample, so
+    // there is no per-tap budget or recovery path
+    GrainPitchBank mGrainBank;
 };
 
 // ===================================================================
@@ -161,20 +244,25 @@ public:
     DecoupledTapProcessor();
     ~DecoupledTapProcessor();
 
-    void initialize(double sampleRate, double maxDelaySeconds, int tapIndex);
+    void initialize(double sampleRate, const MultiTapDelayBuffer* sharedBuffer, int tapIndex);
 
     // Delay control (always works)
     void setDelayTime(float delayTimeSeconds);
     void setEnabled(bool enabled);
+    void setSourceBuffer(const MultiTapDelayBuffer* buffer) { mDelayLine->setSourceBuffer(buffer); }
 
     // Pitch control (optional, never affects delay)
     void setPitchShift(int semitones);
 
     // Processing: Delay first, then optional pitch
-    void processSample(float input, float& output);
+    void processBlock(int timeIndex, int numSamples, float* output);
 
     void reset();
 
+    // Reset the read head and output silence until it reaches input written
+    // after this call; pendingSamples is how far writes run ahead of reads
+    void resetAndSilence(int pendingSamples);
+
     // Status monitoring
     bool isDelayHealthy() const { return mDelayHealthy; }
     bool isPitchHealthy() const { return mPitchHealthy; }
@@ -194,6 +282,12 @@ private:
     // Pitch processing happens at coordinator level
     float mLastDelayOutput;  // Cache for pitch coordinator
 
+    // Outputs still to be silenced after a reset (they would read old audio)
+    int mSilentSamples;
+
+    int getMinimumReadDistance() const { return mDelayLine->getMinimumReadDistance(); }
+    int getMaximumReadDistance() const { return mDelayLine->getMaximumReadDistance(); }
+
     friend class DecoupledDelaySystem;  // Allow system to access delay output
 };
 
@@ -205,6 +299,19 @@ class DecoupledDelaySystem {
 public:
     static constexpr int NUM_TAPS = 16;
 
+    using GlideInterpolation = DelayInterpolation::WATERSTICK_GLIDE_INTERPOLATION;
+
+    // How delay time changes are followed: Crossfade waits for the time to
+    // settle and crossfades to a second head per tap (PureDelayLine); Glide
+    // moves one head per tap continuously (GlidingTapBank)
+    enum class DelayReadMode { Crossfade, Glide };
+
+    // Where pitch shifting happens: PerTap shifts each tap's output after
+    // the delay; Shared shifts the input once per distinct interval into a
+    // class buffer, and the taps on that interval read it (see below)
+    enum class PitchRouting { PerTap, Shared };
+    static constexpr int MAX_PITCH_CLASSES = 4;
+
     DecoupledDelaySystem();
     ~DecoupledDelaySystem();
 
@@ -215,14 +322,68 @@ public:
     void setTapEnabled(int tapIndex, bool enabled);
     void setTapPitchShift(int tapIndex, int semitones);
 
+    // Preallocate block scratch buffers (call off the audio thread)
+    void prepareBlockProcessing(int maxBlockSize);
+
     // Batch processing - delay first, then coordinated pitch
     void processAllTaps(float input, float* outputs);
+    void processBlock(const float* input, int numSamples, float* const* tapOutputs);
+
+    // Split write/read for callers that close a feedback loop around the
+    // system: readBlock() may run at most getMaxFeedbackBlockSize() samples
+    // ahead of the newest sample passed to writeBlock()
+    void writeBlock(const float* input, int numSamples);
+    void readBlock(int numSamples, float* const* tapOutputs);
+    int getMaxFeedbackBlockSize() const;
+
+    // How far back the enabled taps' heads reach, in samples, including a
+    // delay time change still in progress: input older than this is never
+    // read again unless delay times move further out
+    int getMaxReadDistance() const;
+
+    // Switching read mode resets every tap (see reset())
+    void setDelayReadMode(DelayReadMode mode);
+    DelayReadMode getDelayReadMode() const { return mDelayReadMode; }
+    void setGlideTime(float seconds) { mGlideBank.setGlideTime(seconds); }
+
+    // Shared routing costs one shifter lane per distinct interval in use
+    // instead of one per tap. Intervals beyond MAX_PITCH_CLASSES are shifted
+    // per tap as before. A tap that moves to another buffer is reset, so it
+    // is silent until its head reaches audio written after the move.
+    void setPitchRouting(PitchRouting routing);
+    PitchRouting getPitchRouting() const { return mPitchRouting; }
+    int getPitchClassCount() const;
+
+    // Each class needs a buffer as long as the main one. They are allocated
+    // here, off the audio thread, never up front: the audio thread records
+    // the most classes it has wanted at once, and until a class has its
+    // buffer its taps are shifted per tap. count asks for at least that many
+    // (state just loaded, or the controller's taps ahead of the audio
+    // thread's). Safe while another thread processes
+    void allocatePitchClassBuffers(int count = 0);
+    int getPitchClassBuffers() const { return mClassBuffersReady.load(std::memory_order_acquire); }
+
+    // Pitch read-head quality, for both routings
+    void setPitchInterpolation(GrainPitchBank::Interpolation interpolation);
+
+    // Sleep of silent taps, decided by the caller for the next readBlock():
+    // sleeping taps still read the delay but skip the pitch stage, and their
+    // outputs are zero. A sleeping tap in wakeOnInput wakes as soon as its
+    // delay output crosses SLEEP_THRESHOLD (-120 dBFS), before that block's
+    // pitch stage, so nothing it reads is lost. resetTap() wakes a tap.
+    static constexpr float SLEEP_THRESHOLD = 1.0e-6f;
+    void setSleepingTaps(uint32_t sleeping, uint32_t wakeOnInput);
+    uint32_t getSleepingTaps() const { return mSleepingTaps; }
 
     // System control
     void enablePitchProcessing(bool enable);
     bool isPitchProcessingEnabled() const { return mPitchProcessingEnabled; }
 
+    // Both resets are constant time per tap and safe on the audio thread:
+    // the shared buffer is not cleared, reset taps are silenced until their
+    // read heads pass the old audio. resetTap() leaves the other taps alone.
     void reset();
+    void resetTap(int tapIndex);
 
     // Health monitoring
     struct SystemHealth {
@@ -242,22 +403,59 @@ private:
     bool mPitchProcessingEnabled;
 
     // Completely separate systems
+    MultiTapDelayBuffer mDelayBuffer;  // Single write head shared by all taps
     std::array<DecoupledTapProcessor, NUM_TAPS> mTapProcessors;
     std::unique_ptr<PitchCoordinator> mPitchCoordinator;
 
+    // Single gliding head per tap, used instead of the tap processors'
+    // delay lines in Glide mode; the tap processors still gate the output
+    DelayReadMode mDelayReadMode;
+    GlidingTapBank<GlideInterpolation> mGlideBank;
+
+    // Pitch classes: the input shifted once per interval, written in step
+    // with mDelayBuffer (idle classes skip). Semitones 0 marks a free class.
+    // Only the first mClassBuffersInStep classes have a buffer the audio
+    // thread uses; allocatePitchClassBuffers() publishes more through
+    // mClassBuffersReady and never touches those already published
+    PitchRouting mPitchRouting;
+    bool mPitchClassesDirty;   // Tap pitch, enable or routing changed
+    double mMaxDelaySeconds;
+    std::array<MultiTapDelayBuffer, MAX_PITCH_CLASSES> mClassBuffers;
+    std::atomic<int> mClassBuffersReady{0};
+    std::atomic<int> mClassBuffersWanted{0};
+    int mClassBuffersInStep;
+    std::array<int, MAX_PITCH_CLASSES> mClassSemitones{};
+    std::array<int, NUM_TAPS> mTapClass{};   // -1 reads mDelayBuffer
+    GrainPitchBank mClassShifter;   // Lane per class
+
+    // Read cursor: buffer index of the next output sample
+    int mReadIndex;
+
+    // Bit per tap, see setSleepingTaps()
+    uint32_t mSleepingTaps;
+    uint32_t mWakeOnInput;
+
     // Processing buffers (avoid allocations in audio thread)
-    mutable std::array<float, NUM_TAPS> mDelayOutputs{};
-    mutable std::array<float, NUM_TAPS> mPitchOutputs{};
-
-    // Performance monitoring
-    mutable std::chrono::high_resolution_clock::time_point mProcessingStartTime;
-    mutable std::atomic<double> mDelayProcessingTime{0.0};
-    mutable std::atomic<double> mPitchProcessingTime{0.0};
-
-    void processDelayStage(float input);
-    void processPitchStage();
-    void combineOutputs(float* outputs);
-    void updatePerformanceMetrics() const;
+    static constexpr int DEFAULT_MAX_BLOCK_SIZE = 1024;
+    int mMaxBlockSize;
+    std::vector<float> mDelayScratch;
+    std::array<float*, NUM_TAPS> mDelayOutputs{};
+    std::vector<float> mClassScratch;
+    std::array<float*, MAX_PITCH_CLASSES> mClassOutputs{};
+
+    // Stage times of the last block, microseconds; instrumented builds only
+    MonitorCounter<double> mDelayProcessingTime{0.0};
+    MonitorCounter<double> mPitchProcessingTime{0.0};
+
+    void processDelayStage(int numSamples);
+    void processGlideStage(int numSamples);
+    void processPitchStage(int numSamples, float* const* tapOutputs);
+    void writeClassBuffers(const float* input, int numSamples);
+    void updatePitchClasses();
+    int findPitchClass(int semitones) const;
+    const MultiTapDelayBuffer& tapSource(int tapIndex) const {
+        return mTapClass[tapIndex] < 0 ? mDelayBuffer : mClassBuffers[mTapClass[tapIndex]];
+    }
 };
 
 // ===================================================================
@@ -286,6 +484,10 @@ private:
 //    - Pitch processing budget is isolated and bounded
 //    - No cross-contamination of processing times
 //    - Clear performance attribution per subsystem
+//    - One ring buffer per channel: memory and write bandwidth do not
+//      scale with the number of taps
+//    - Shared pitch routing: shifter cost follows the distinct intervals
+//      in use, not the number of pitched taps
 //
 // 5. OPERATIONAL SIMPLICITY:
 //    - Simple interface: setDelayTime(), setPitchShift()
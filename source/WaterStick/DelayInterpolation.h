@@ -0,0 +1,144 @@
+#pragma once
+
+#include "SimdBatch.h"
+
+namespace WaterStick {
+namespace DelayInterpolation {
+
+/**
+ * @file DelayInterpolation.h
+ * @brief Fractional delay read kernels, chosen as a compile-time policy
+ *
+ * A read head at delay d (samples) splits it into an integer part
+ * k = floor(d - SPLIT) and a fraction f = d - k, then hands the policy a
+ * window of POINTS consecutive samples (oldest first) in which
+ * window[NEWEST] is the sample k behind the write position. The policy
+ * returns the signal f samples further into the past. The newest sample
+ * used is LOOKAHEAD = POINTS - 1 - NEWEST samples ahead of window[NEWEST],
+ * so a head must stay at least LOOKAHEAD + SPLIT samples behind the input.
+ *
+ * - Linear:   2 points, cheapest, dulls highs while modulating.
+ * - Hermite:  4-point, 3rd-order (Catmull-Rom); the usual tape choice.
+ * - Lagrange: 6-point, 5th-order; flattest response, most reads.
+ * - Allpass:  1 point plus state, flat magnitude, fraction kept in
+ *   [0.5, 1.5) like PureDelayLine. Best for slow modulation only, as the
+ *   recursion smears fast position changes.
+ *
+ * Every kernel is a template over float and simd::FloatBatch, so the
+ * scalar and lane-parallel versions evaluate the same expressions.
+ * Stateful policies carry a State<T>; commit() applies a lane-masked
+ * state update for the SIMD path.
+ */
+
+template <typename T> inline T splat(float x);
+template <> inline float splat<float>(float x) { return x; }
+template <> inline simd::FloatBatch splat<simd::FloatBatch>(float x) { return simd::broadcast(x); }
+
+// Stateless policies share an empty state
+template <typename T> struct NoState {};
+
+struct Linear {
+    static constexpr int POINTS = 2;
+    static constexpr int NEWEST = 1;
+    static constexpr int LOOKAHEAD = POINTS - 1 - NEWEST;
+    static constexpr float SPLIT = 0.0f;
+    template <typename T> using State = NoState<T>;
+
+    template <typename T>
+    static T interpolate(const T* window, T frac, State<T>&) {
+        return window[1] + frac * (window[0] - window[1]);
+    }
+
+    static void commit(simd::MaskBatch, State<simd::FloatBatch>&, const State<simd::FloatBatch>&) {}
+};
+
+struct Hermite {
+    static constexpr int POINTS = 4;
+    static constexpr int NEWEST = 2;
+    static constexpr int LOOKAHEAD = POINTS - 1 - NEWEST;
+    static constexpr float SPLIT = 0.0f;
+    template <typename T> using State = NoState<T>;
+
+    template <typename T>
+    static T interpolate(const T* window, T frac, State<T>&) {
+        // Catmull-Rom between window[1] and window[2], t measured forward in time
+        T t = splat<T>(1.0f) - frac;
+        T c1 = splat<T>(0.5f) * (window[2] - window[0]);
+        T c2 = window[0] - splat<T>(2.5f) * window[1] + splat<T>(2.0f) * window[2] - splat<T>(0.5f) * window[3];
+        T c3 = splat<T>(0.5f) * (window[3] - window[0]) + splat<T>(1.5f) * (window[1] - window[2]);
+        return ((c3 * t + c2) * t + c1) * t + window[1];
+    }
+
+    static void commit(simd::MaskBatch, State<simd::FloatBatch>&, const State<simd::FloatBatch>&) {}
+};
+
+struct Lagrange {
+    static constexpr int POINTS = 6;
+    static constexpr int NEWEST = 3;
+    static constexpr int LOOKAHEAD = POINTS - 1 - NEWEST;
+    static constexpr float SPLIT = 0.0f;
+    template <typename T> using State = NoState<T>;
+
+    template <typename T>
+    static T interpolate(const T* window, T frac, State<T>&) {
+        // Lagrange basis over nodes 0..5 evaluated at s = NEWEST - frac
+        T s = splat<T>(static_cast<float>(NEWEST)) - frac;
+        T d0 = s;
+        T d1 = s - splat<T>(1.0f);
+        T d2 = s - splat<T>(2.0f);
+        T d3 = s - splat<T>(3.0f);
+        T d4 = s - splat<T>(4.0f);
+        T d5 = s - splat<T>(5.0f);
+
+        T d01 = d0 * d1;
+        T d45 = d4 * d5;
+        T d012 = d01 * d2;
+        T d345 = d3 * d45;
+
+        return window[0] * (d1 * d2 * d345) * splat<T>(-1.0f / 120.0f)
+             + window[1] * (d0 * d2 * d345) * splat<T>(1.0f / 24.0f)
+             + window[2] * (d01 * d345) * splat<T>(-1.0f / 12.0f)
+             + window[3] * (d012 * d45) * splat<T>(1.0f / 12.0f)
+             + window[4] * (d012 * d3 * d5) * splat<T>(-1.0f / 24.0f)
+             + window[5] * (d012 * d3 * d4) * splat<T>(1.0f / 120.0f);
+    }
+
+    static void commit(simd::MaskBatch, State<simd::FloatBatch>&, const State<simd::FloatBatch>&) {}
+};
+
+struct Allpass {
+    static constexpr int POINTS = 1;
+    static constexpr int NEWEST = 0;
+    static constexpr int LOOKAHEAD = POINTS - 1 - NEWEST;
+    static constexpr float SPLIT = 0.5f;
+
+    template <typename T>
+    struct State {
+        T input = splat<T>(0.0f);    // Previous sample fed to the allpass
+        T output = splat<T>(0.0f);   // Previous output
+    };
+
+    template <typename T>
+    static T interpolate(const T* window, T frac, State<T>& state) {
+        // First-order allpass: y[n] = a * (x[n] - y[n-1]) + x[n-1]
+        T coeff = (splat<T>(1.0f) - frac) / (splat<T>(1.0f) + frac);
+        T output = coeff * (window[0] - state.output) + state.input;
+        state.input = window[0];
+        state.output = output;
+        return output;
+    }
+
+    static void commit(simd::MaskBatch active, State<simd::FloatBatch>& state, const State<simd::FloatBatch>& next) {
+        state.input = simd::select(active, next.input, state.input);
+        state.output = simd::select(active, next.output, state.output);
+    }
+};
+
+// Widest window of the policies above: how far past a wrapped index a
+// head reads in one go
+constexpr int MAX_POINTS = Lagrange::POINTS;
+static_assert(Linear::POINTS <= MAX_POINTS && Hermite::POINTS <= MAX_POINTS && Allpass::POINTS <= MAX_POINTS,
+              "MAX_POINTS must cover every policy");
+
+} // namespace DelayInterpolation
+} // namespace WaterStick
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define WATERSTICK_DENORMAL_GUARD_MXCSR 1
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define WATERSTICK_DENORMAL_GUARD_FPCR 1
+#elif defined(__arm__) && defined(__ARM_FP) && (defined(__GNUC__) || defined(__clang__))
+#define WATERSTICK_DENORMAL_GUARD_FPSCR 1
+#endif
+
+namespace WaterStick {
+
+/**
+ * @file DenormalGuard.h
+ * @brief Flush-to-zero floating point for the lifetime of a scope
+ *
+ * Decaying state (the delay feedback tail, SVF integrators, the damping
+ * pole) passes through subnormal floats on its way to zero, and with a
+ * loop gain above one half it never leaves them: rounding holds the
+ * smallest subnormal in place. x86 cores take a microcode assist on every
+ * operation touching one, tens of times the cost of a normal multiply.
+ *
+ * While a DenormalGuard lives, subnormal results are flushed to zero and
+ * subnormal operands read as zero. The constructor saves the thread's
+ * control register and the destructor puts it back, so the host's mode is
+ * left as found:
+ *
+ * - x86: MXCSR FTZ (bit 15) and DAZ (bit 6); covers SSE and AVX, not x87.
+ * - AArch64: FPCR FZ (bit 24), both directions.
+ * - 32-bit ARM: FPSCR FZ (bit 24).
+ *
+ * ENABLED is false on other targets, where the guard does nothing.
+ */
+class DenormalGuard {
+public:
+#if defined(WATERSTICK_DENORMAL_GUARD_MXCSR)
+    static constexpr bool ENABLED = true;
+
+    DenormalGuard() : mPrevious(_mm_getcsr()) { _mm_setcsr(mPrevious | FLUSH_BITS); }
+    ~DenormalGuard() { _mm_setcsr(mPrevious); }
+
+    static bool isFlushing() { return (_mm_getcsr() & FLUSH_BITS) == FLUSH_BITS; }
+
+private:
+    static constexpr unsigned int FLUSH_BITS = 0x8040;   // FTZ | DAZ
+    unsigned int mPrevious;
+
+#elif defined(WATERSTICK_DENORMAL_GUARD_FPCR)
+    static constexpr bool ENABLED = true;
+
+    DenormalGuard() : mPrevious(read()) { write(mPrevious | FLUSH_BITS); }
+    ~DenormalGuard() { write(mPrevious); }
+
+    static bool isFlushing() { return (read() & FLUSH_BITS) != 0; }
+
+private:
+    static constexpr uint64_t FLUSH_BITS = uint64_t(1) << 24;   // FZ
+    uint64_t mPrevious;
+
+    static uint64_t read() {
+        uint64_t value;
+        asm volatile("mrs %0, fpcr" : "=r"(value));
+        return value;
+    }
+    static void write(uint64_t value) { asm volatile("msr fpcr, %0" : : "r"(value)); }
+
+#elif defined(WATERSTICK_DENORMAL_GUARD_FPSCR)
+    static constexpr bool ENABLED = true;
+
+    DenormalGuard() : mPrevious(read()) { write(mPrevious | FLUSH_BITS); }
+    ~DenormalGuard() { write(mPrevious); }
+
+    static bool isFlushing() { return (read() & FLUSH_BITS) != 0; }
+
+private:
+    static constexpr uint32_t FLUSH_BITS = uint32_t(1) << 24;   // FZ
+    uint32_t mPrevious;
+
+    static uint32_t read() {
+        uint32_t value;
+        asm volatile("vmrs %0, fpscr" : "=r"(value));
+        return value;
+    }
+    static void write(uint32_t value) { asm volatile("vmsr fpscr, %0" : : "r"(value)); }
+
+#else
+    static constexpr bool ENABLED = false;
+
+    static bool isFlushing() { return false; }
+#endif
+
+public:
+    DenormalGuard(const DenormalGuard&) = delete;
+    DenormalGuard& operator=(const DenormalGuard&) = delete;
+};
+
+} // namespace WaterStick
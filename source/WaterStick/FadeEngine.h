@@ -0,0 +1,141 @@
+#pragma once
+
+#include "SimdBatch.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace WaterStick {
+
+/**
+ * @file FadeEngine.h
+ * @brief Table-driven fade envelopes for crossfades, tap and bypass fades
+ *
+ * The fade-out curves are tabulated once per process and shared by every
+ * ramp, so a running fade costs a table walk (one multiply, one truncation,
+ * one linear interpolation) instead of a cosf or std::exp per sample:
+ *
+ * - RaisedCosine: 0.5 * (1 + cos(pi * x)), the delay head crossfade.
+ * - Exponential:  exp(-6 * x), about -52 dB at the end; tap and bypass fades.
+ *
+ * Fade-ins are 1 minus the fade-out, so a crossfade pair sums to unity.
+ * With 1024 segments the interpolated tables stay within 1e-6 (raised
+ * cosine) and 5e-6 (exponential) of the exact curves.
+ *
+ * A FadeRamp yields the gain for sample k of an n-sample fade as
+ * curve(k / n), either one sample at a time or as a block of gains that
+ * applyGains() multiplies into a signal with SIMD.
+ */
+class FadeCurveTables {
+public:
+    static constexpr int SEGMENTS = 1024;
+
+    enum class Curve { RaisedCosine, Exponential };
+
+    // Built on first use; FadeRamp resolves it at construction, off the
+    // audio thread
+    static const FadeCurveTables& shared() {
+        static const FadeCurveTables tables;
+        return tables;
+    }
+
+    // SEGMENTS + 1 points, so interpolation at x < 1 never reads past the end
+    const float* table(Curve curve) const {
+        return curve == Curve::RaisedCosine ? mRaisedCosine.data() : mExponential.data();
+    }
+
+    // Fade-out gain at progress x in [0, 1]
+    float fadeOut(Curve curve, float x) const {
+        return lookup(table(curve), std::max(0.0f, std::min(x, 1.0f)) * static_cast<float>(SEGMENTS));
+    }
+
+    // position in [0, SEGMENTS]
+    static float lookup(const float* table, float position) {
+        int index = std::min(static_cast<int>(position), SEGMENTS - 1);
+        float frac = position - static_cast<float>(index);
+        return table[index] + frac * (table[index + 1] - table[index]);
+    }
+
+private:
+    FadeCurveTables() {
+        for (int i = 0; i <= SEGMENTS; ++i) {
+            double x = static_cast<double>(i) / SEGMENTS;
+            mRaisedCosine[i] = static_cast<float>(0.5 * (1.0 + std::cos(x * 3.14159265358979323846)));
+            mExponential[i] = static_cast<float>(std::exp(-6.0 * x));
+        }
+    }
+
+    std::array<float, SEGMENTS + 1> mRaisedCosine;
+    std::array<float, SEGMENTS + 1> mExponential;
+};
+
+class FadeRamp {
+public:
+    using Curve = FadeCurveTables::Curve;
+    enum class Direction { Out, In };
+
+    FadeRamp() : mTables(&FadeCurveTables::shared()) {}
+
+    // Starts a fade of length samples (at least 1); restarting mid-fade
+    // jumps to the start of the new curve
+    void start(Curve curve, Direction direction, int length) {
+        mTable = mTables->table(curve);
+        mLength = std::max(1, length);
+        mPosition = 0;
+        mStep = static_cast<float>(FadeCurveTables::SEGMENTS) / static_cast<float>(mLength);
+
+        // Gain = mOffset + mSign * fadeOut, branch-free for both directions
+        mOffset = direction == Direction::In ? 1.0f : 0.0f;
+        mSign = direction == Direction::In ? -1.0f : 1.0f;
+    }
+
+    void stop() { mPosition = mLength; }
+
+    bool isActive() const { return mPosition < mLength; }
+
+    // Samples left, counting the next one
+    int getRemaining() const { return mLength - mPosition; }
+
+    // Gain for the next sample; the last call of a fade leaves it inactive
+    float next() {
+        float gain = mOffset + mSign * FadeCurveTables::lookup(mTable, static_cast<float>(mPosition) * mStep);
+        ++mPosition;
+        return gain;
+    }
+
+    // next() for numSamples samples; past the end of the fade gains are
+    // unity. Returns how many samples the fade itself covered
+    int render(float* gains, int numSamples) {
+        int fadeSamples = std::min(numSamples, std::max(0, getRemaining()));
+        for (int i = 0; i < fadeSamples; ++i) {
+            gains[i] = next();
+        }
+        std::fill(gains + fadeSamples, gains + numSamples, 1.0f);
+        return fadeSamples;
+    }
+
+    // signal[i] *= gains[i]; neither pointer needs to be aligned
+    static void applyGains(float* signal, const float* gains, int numSamples) {
+        using namespace simd;
+        constexpr int WIDTH = FloatBatch::WIDTH;
+
+        int i = 0;
+        for (; i + WIDTH <= numSamples; i += WIDTH) {
+            storeUnaligned(signal + i, loadUnaligned(signal + i) * loadUnaligned(gains + i));
+        }
+        for (; i < numSamples; ++i) {
+            signal[i] *= gains[i];
+        }
+    }
+
+private:
+    const FadeCurveTables* mTables;
+    const float* mTable = nullptr;
+    int mLength = 0;
+    int mPosition = 0;
+    float mStep = 0.0f;
+    float mOffset = 0.0f;
+    float mSign = 1.0f;
+};
+
+} // namespace WaterStick
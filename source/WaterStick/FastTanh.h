@@ -0,0 +1,113 @@
+#pragma once
+
+#include "SimdBatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace WaterStick {
+namespace FastTanh {
+
+/**
+ * @file FastTanh.h
+ * @brief Bounded-error rational tanh kernels, scalar and SIMD
+ *
+ * Two kernels, both bounded by +-1 and monotonic (up to float rounding).
+ * Both are evaluated on |x| and take the sign of x back at the end, so they
+ * are exactly odd however the compiler contracts the polynomials (FMA):
+ *
+ * - pade(): [7/6] Padé approximant (Lambert's continued fraction) clamped
+ *   at +-4.97, where it reaches 1. Max abs error vs std::tanh:
+ *   1.1e-8 for |x| <= 2, 9.4e-7 for |x| <= 3, 9.6e-5 overall.
+ *   Cheapest; used by the input and comb feedback limiters, whose inputs
+ *   sit well inside |x| <= 2.
+ *
+ * - rational(): [13/6] minimax rational clamped at +-7.905. Max abs error
+ *   2.6e-7 over the whole real line. Used for the SVF integrator
+ *   saturation, where the state recirculates and is driven hard by
+ *   resonance.
+ *
+ * Errors above are for double evaluation; float adds up to ~2e-7 of rounding.
+ * The scalar templates work for float and double; the FloatBatch overloads
+ * evaluate the same polynomials lane-parallel. Errors are documented and
+ * checked by test_fast_tanh.
+ */
+
+static constexpr double PADE_CLAMP = 4.97;
+static constexpr double RATIONAL_CLAMP = 7.90531110763549805;
+
+// ===================================================================
+// Scalar kernels
+// ===================================================================
+
+template <typename T>
+inline T pade(T x) {
+    T a = std::min(std::abs(x), T(PADE_CLAMP));
+    T a2 = a * a;
+
+    T numerator = a * (T(135135) + a2 * (T(17325) + a2 * (T(378) + a2)));
+    T denominator = T(135135) + a2 * (T(62370) + a2 * (T(3150) + a2 * T(28)));
+
+    return std::copysign(std::min(numerator / denominator, T(1)), x);
+}
+
+template <typename T>
+inline T rational(T x) {
+    T a = std::min(std::abs(x), T(RATIONAL_CLAMP));
+    T x2 = a * a;
+
+    T p = T(-2.76076847742355e-16);
+    p = p * x2 + T(2.00018790482477e-13);
+    p = p * x2 + T(-8.60467152213735e-11);
+    p = p * x2 + T(5.12229709037114e-08);
+    p = p * x2 + T(1.48572235717979e-05);
+    p = p * x2 + T(6.37261928875436e-04);
+    p = p * x2 + T(4.89352455891786e-03);
+
+    T q = T(1.19825839466702e-06);
+    q = q * x2 + T(1.18534705686654e-04);
+    q = q * x2 + T(2.26843463243900e-03);
+    q = q * x2 + T(4.89352518554385e-03);
+
+    return std::copysign(a * p / q, x);
+}
+
+// ===================================================================
+// SIMD kernels
+// ===================================================================
+
+inline simd::FloatBatch pade(simd::FloatBatch x) {
+    using simd::broadcast;
+
+    simd::FloatBatch a = simd::min(simd::abs(x), broadcast(static_cast<float>(PADE_CLAMP)));
+    simd::FloatBatch a2 = a * a;
+
+    simd::FloatBatch numerator = a * (broadcast(135135.0f) + a2 * (broadcast(17325.0f) + a2 * (broadcast(378.0f) + a2)));
+    simd::FloatBatch denominator = broadcast(135135.0f) + a2 * (broadcast(62370.0f) + a2 * (broadcast(3150.0f) + a2 * broadcast(28.0f)));
+
+    return simd::copySign(simd::min(numerator / denominator, broadcast(1.0f)), x);
+}
+
+inline simd::FloatBatch rational(simd::FloatBatch x) {
+    using simd::broadcast;
+
+    simd::FloatBatch a = simd::min(simd::abs(x), broadcast(static_cast<float>(RATIONAL_CLAMP)));
+    simd::FloatBatch x2 = a * a;
+
+    simd::FloatBatch p = broadcast(-2.76076847742355e-16f);
+    p = p * x2 + broadcast(2.00018790482477e-13f);
+    p = p * x2 + broadcast(-8.60467152213735e-11f);
+    p = p * x2 + broadcast(5.12229709037114e-08f);
+    p = p * x2 + broadcast(1.48572235717979e-05f);
+    p = p * x2 + broadcast(6.37261928875436e-04f);
+    p = p * x2 + broadcast(4.89352455891786e-03f);
+
+    simd::FloatBatch q = broadcast(1.19825839466702e-06f);
+    q = q * x2 + broadcast(1.18534705686654e-04f);
+    q = q * x2 + broadcast(2.26843463243900e-03f);
+    q = q * x2 + broadcast(4.89352518554385e-03f);
+
+    return simd::copySign(a * p / q, x);
+}
+
+} // namespace FastTanh
+} // namespace WaterStick
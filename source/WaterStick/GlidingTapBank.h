@@ -0,0 +1,177 @@
+#pragma once
+
+#include "DelayInterpolation.h"
+#include "SimdBatch.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace WaterStick {
+
+/**
+ * @file GlidingTapBank.h
+ * @brief Continuous read heads for all 16 taps of one channel, lane-parallel
+ *
+ * Instead of waiting for a delay time to settle and crossfading to a second
+ * head (PureDelayLine), each tap has a single head whose position glides
+ * towards its target along a one-pole curve, like a tape transport
+ * following a new speed. Tempo ramps and automation are followed
+ * continuously and modulation costs one head per tap.
+ *
+ * Interpolation is a compile-time policy from DelayInterpolation.h. Per
+ * sample, the interpolation runs across all taps at once in
+ * simd::FloatBatch lanes; the glide update and the window gather are per
+ * tap. Positions are doubles: as floats, a head 20 s back resolves only
+ * 1/32 sample, and a glide's last steps round to nothing. The gather reads the policy's window contiguously,
+ * which relies on the ring buffer's start repeating after its end for at
+ * least POINTS samples (a MirroredRingBuffer guard).
+ *
+ * Heads that are silent (tap disabled or just reset) do not update their
+ * interpolation state and output zero; their positions keep gliding.
+ */
+template <typename Interpolation>
+class GlidingTapBank {
+public:
+    static constexpr int NUM_LANES = 16;
+    static constexpr float DEFAULT_GLIDE_SECONDS = 0.05f;
+    static constexpr double SETTLE_SAMPLES = 1e-3;  // Snap to the target within this
+
+    // Closest a head may sit to the write position without reading ahead of it
+    static constexpr float MIN_DELAY_SAMPLES = Interpolation::LOOKAHEAD + Interpolation::SPLIT;
+
+    GlidingTapBank() {
+        mPosition.fill(MIN_DELAY_SAMPLES);
+        mTarget.fill(MIN_DELAY_SAMPLES);
+        mClearState.fill(0.0f);
+    }
+
+    void initialize(double sampleRate, int maxDelaySamples) {
+        mSampleRate = sampleRate;
+        mMaxDelaySamples = maxDelaySamples;
+        setGlideTime(DEFAULT_GLIDE_SECONDS);
+        for (int lane = 0; lane < NUM_LANES; ++lane) seat(lane);
+    }
+
+    // Time constant of the glide; 0 jumps straight to each new delay
+    void setGlideTime(float seconds) {
+        mGlideCoeff = seconds > 0.0f
+            ? 1.0 - std::exp(-1.0 / (seconds * mSampleRate))
+            : 1.0;
+    }
+
+    void setDelayTime(int lane, float delayTimeSeconds) {
+        double samples = delayTimeSeconds * mSampleRate;
+        mTarget[lane] = std::max(static_cast<double>(MIN_DELAY_SAMPLES), std::min(samples, mMaxDelaySamples));
+    }
+
+    // Put the head on its target with cleared state (applied on next block)
+    void seat(int lane) {
+        mPosition[lane] = mTarget[lane];
+        mClearState[lane] = 1.0f;
+    }
+
+    bool isSettled(int lane) const { return mPosition[lane] == mTarget[lane]; }
+
+    // Whole-sample distance to the newest sample the head can read before
+    // it reaches its target; positions move monotonically towards it
+    int getMinimumReadDistance(int lane) const {
+        double nearest = std::min(mPosition[lane], mTarget[lane]);
+        return static_cast<int>(nearest - Interpolation::SPLIT) - Interpolation::LOOKAHEAD;
+    }
+
+    // Whole-sample distance to the oldest sample the head can read on its
+    // way to the target
+    int getMaximumReadDistance(int lane) const {
+        double farthest = std::max(mPosition[lane], mTarget[lane]);
+        return static_cast<int>(farthest - Interpolation::SPLIT) + Interpolation::NEWEST + 1;
+    }
+
+    // Render numSamples outputs per lane starting at buffer index timeIndex.
+    // buffer must repeat its first Interpolation::POINTS samples past
+    // mask + 1; outputs[lane] receives
+    // zeros for its first silentSamples[lane] samples.
+    void processBlock(const float* buffer, uint32_t mask, uint32_t timeIndex, int numSamples,
+                      const int* silentSamples, float* const* outputs) {
+        std::array<const float*, NUM_LANES> buffers;
+        buffers.fill(buffer);
+        processBlock(buffers.data(), mask, timeIndex, numSamples, silentSamples, outputs);
+    }
+
+    // As above, each lane reading its own buffer; all share one size and
+    // write position
+    void processBlock(const float* const* buffers, uint32_t mask, uint32_t timeIndex, int numSamples,
+                      const int* silentSamples, float* const* outputs) {
+        using namespace simd;
+        using State = typename Interpolation::template State<FloatBatch>;
+
+        alignas(ALIGNMENT) float silentUntil[NUM_LANES];
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            silentUntil[lane] = static_cast<float>(silentSamples[lane]);
+        }
+
+        // Heads seated since the last block start from cleared state
+        for (int b = 0; b < NUM_BATCHES; ++b) {
+            MaskBatch clear = load(mClearState.data() + b * WIDTH) > broadcast(0.5f);
+            Interpolation::commit(clear, mState[b], State{});
+        }
+        mClearState.fill(0.0f);
+
+        for (int i = 0; i < numSamples; ++i, ++timeIndex) {
+            alignas(ALIGNMENT) float frac[NUM_LANES];
+            alignas(ALIGNMENT) float window[Interpolation::POINTS][NUM_LANES];
+            alignas(ALIGNMENT) float output[NUM_LANES];
+
+            // Glide every head one sample towards its target, then gather
+            // its window from the mirrored buffer
+            for (int lane = 0; lane < NUM_LANES; ++lane) {
+                double distance = mTarget[lane] - mPosition[lane];
+                mPosition[lane] = std::abs(distance) < SETTLE_SAMPLES ? mTarget[lane] : mPosition[lane] + mGlideCoeff * distance;
+
+                int whole = static_cast<int>(mPosition[lane] - Interpolation::SPLIT);
+                frac[lane] = static_cast<float>(mPosition[lane] - whole);
+
+                const float* samples = buffers[lane] + ((timeIndex - static_cast<uint32_t>(whole + Interpolation::NEWEST)) & mask);
+                for (int p = 0; p < Interpolation::POINTS; ++p) {
+                    window[p][lane] = samples[p];
+                }
+            }
+
+            // Interpolate all heads together
+            const FloatBatch now = broadcast(static_cast<float>(i));
+            for (int b = 0; b < NUM_BATCHES; ++b) {
+                FloatBatch points[Interpolation::POINTS];
+                for (int p = 0; p < Interpolation::POINTS; ++p) {
+                    points[p] = load(window[p] + b * WIDTH);
+                }
+
+                State next = mState[b];
+                FloatBatch value = Interpolation::interpolate(points, load(frac + b * WIDTH), next);
+
+                MaskBatch active = now >= load(silentUntil + b * WIDTH);
+                Interpolation::commit(active, mState[b], next);
+                store(output + b * WIDTH, select(active, value, broadcast(0.0f)));
+            }
+
+            for (int lane = 0; lane < NUM_LANES; ++lane) {
+                outputs[lane][i] = output[lane];
+            }
+        }
+    }
+
+private:
+    static constexpr int WIDTH = simd::FloatBatch::WIDTH;
+    static constexpr int NUM_BATCHES = NUM_LANES / WIDTH;
+    static_assert(NUM_LANES % WIDTH == 0, "Lanes must fill whole batches");
+
+    double mSampleRate = 44100.0;
+    double mMaxDelaySamples = 0.0;
+    double mGlideCoeff = 1.0;
+
+    std::array<double, NUM_LANES> mPosition;     // Current delay, samples
+    std::array<double, NUM_LANES> mTarget;       // Delay gliding towards
+    alignas(simd::ALIGNMENT) std::array<float, NUM_LANES> mClearState;   // 1 = clear state next block
+    std::array<typename Interpolation::template State<simd::FloatBatch>, NUM_BATCHES> mState{};
+};
+
+} // namespace WaterStick
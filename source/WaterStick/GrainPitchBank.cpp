@@ -0,0 +1,279 @@
+#include "GrainPitchBank.h"
+#include "DelayInterpolation.h"
+#include "FadeEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace WaterStick {
+
+namespace {
+
+// Non-negative x only, as delays and table positions are
+inline simd::FloatBatch floorOf(simd::FloatBatch x) {
+    simd::FloatBatch nearest = simd::roundNearest(x);
+    return simd::select(nearest > x, nearest - simd::broadcast(1.0f), nearest);
+}
+
+} // namespace
+
+GrainPitchBank::GrainPitchBank()
+: mSampleRate(44100.0)
+, mSmoothingCoeff(0.0f)
+, mInterpolation(Interpolation::Linear)
+, mSincTable(&PolyphaseSincTable::shared())
+, mHistorySize(0)
+, mLaneStride(0)
+, mHistoryMask(0)
+, mWriteIndex(0) {
+    mFilled.fill(0.0f);
+    mRatio.fill(1.0f);
+    mTargetRatio.fill(1.0f);
+    mGrain.fill(0.0f);
+    mTargetGrain.fill(0.0f);
+    mPhase.fill(0.0f);
+    mMix.fill(0.0f);
+    mTargetMix.fill(0.0f);
+}
+
+void GrainPitchBank::initialize(double sampleRate, int maxBlockSize) {
+    mSampleRate = sampleRate;
+    mSmoothingCoeff = std::exp(-1.0f / (SMOOTHING_SECONDS * static_cast<float>(sampleRate)));
+
+    // The longest grain plus the widest window behind it, behind a whole
+    // block written ahead of the reads
+    int longestRead = static_cast<int>(std::ceil(MAX_GRAIN_SECONDS * sampleRate)) + PolyphaseSincTable::POINTS + 1;
+    mHistorySize = 1;
+    while (mHistorySize < longestRead + maxBlockSize) {
+        mHistorySize <<= 1;
+    }
+    mLaneStride = mHistorySize + HISTORY_GUARD;
+    mHistoryMask = static_cast<uint32_t>(mHistorySize - 1);
+    mHistory.assign(static_cast<size_t>(NUM_LANES) * mLaneStride, 0.0f);
+    mWriteIndex = 0;
+
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        setRatio(lane, mTargetRatio[lane]);
+        resetLane(lane);
+    }
+}
+
+float GrainPitchBank::grainLengthFor(float ratio) const {
+    float sampleRate = static_cast<float>(mSampleRate);
+    float length = std::abs(1.0f - ratio) * sampleRate / GRAIN_RATE_HZ;
+    return std::max(MIN_GRAIN_SECONDS * sampleRate, std::min(length, MAX_GRAIN_SECONDS * sampleRate));
+}
+
+void GrainPitchBank::setRatio(int lane, float ratio) {
+    mTargetRatio[lane] = ratio;
+    mTargetGrain[lane] = grainLengthFor(ratio);
+    mTargetMix[lane] = ratio == 1.0f ? 0.0f : 1.0f;
+}
+
+void GrainPitchBank::resetLane(int lane) {
+    mRatio[lane] = mTargetRatio[lane];
+    mGrain[lane] = mTargetGrain[lane];
+    mMix[lane] = mTargetMix[lane];
+    mPhase[lane] = 0.0f;
+    mFilled[lane] = 0.0f;
+}
+
+void GrainPitchBank::writeHistory(int lane, const float* input, int numSamples) {
+    float* history = mHistory.data() + static_cast<size_t>(lane) * mLaneStride;
+
+    int firstRun = std::min(numSamples, mHistorySize - static_cast<int>(mWriteIndex));
+    std::copy(input, input + firstRun, history + mWriteIndex);
+    std::copy(input + firstRun, input + numSamples, history);
+
+    // Keep the guard equal to the start of the ring
+    std::copy(history, history + HISTORY_GUARD, history + mHistorySize);
+}
+
+void GrainPitchBank::processBlock(const float* const* inputs, float* const* outputs, int numSamples,
+                                  int numLanes) {
+    const int batches = std::min((std::max(numLanes, 0) + WIDTH - 1) / WIDTH, NUM_BATCHES);
+    const int lanes = batches * WIDTH;
+
+    // The whole block goes in first; heads read no newer than their own sample
+    bool allUnity = true;
+    for (int lane = 0; lane < lanes; ++lane) {
+        writeHistory(lane, inputs[lane], numSamples);
+        allUnity = allUnity && mMix[lane] == 0.0f && mTargetMix[lane] == 0.0f;
+    }
+
+    // Nothing pitched: histories keep following the input for the next
+    // interval, and every lane is its input
+    if (allUnity) {
+        for (int lane = 0; lane < lanes; ++lane) {
+            std::copy(inputs[lane], inputs[lane] + numSamples, outputs[lane]);
+        }
+    } else if (mInterpolation == Interpolation::Sinc) {
+        processGrains<PolyphaseSincTable>(inputs, outputs, numSamples, batches);
+    } else if (mInterpolation == Interpolation::Hermite) {
+        processGrains<DelayInterpolation::Hermite>(inputs, outputs, numSamples, batches);
+    } else {
+        processGrains<DelayInterpolation::Linear>(inputs, outputs, numSamples, batches);
+    }
+
+    advance(numSamples, lanes);
+}
+
+template <typename Window>
+void GrainPitchBank::processGrains(const float* const* inputs, float* const* outputs, int numSamples, int batches) {
+    using namespace simd;
+
+    // The sinc kernel is a dot product per head; the others run across lanes
+    constexpr bool PER_LANE = std::is_same<Window, PolyphaseSincTable>::value;
+    constexpr int GATHERED = PER_LANE ? 1 : Window::POINTS;
+    const int lanes = batches * WIDTH;
+
+    const float* hann = FadeCurveTables::shared().table(FadeCurveTables::Curve::RaisedCosine);
+    const FloatBatch coeff = broadcast(mSmoothingCoeff);
+    const FloatBatch slew = broadcast(GRAIN_SLEW);
+    const FloatBatch zero = broadcast(0.0f);
+    const FloatBatch one = broadcast(1.0f);
+    const FloatBatch half = broadcast(0.5f);
+    const FloatBatch base = broadcast(static_cast<float>(Window::LOOKAHEAD) + Window::SPLIT);
+    const FloatBatch segments = broadcast(static_cast<float>(FadeCurveTables::SEGMENTS));
+    const FloatBatch lastIndex = broadcast(static_cast<float>(FadeCurveTables::SEGMENTS - 1));
+
+    for (int i = 0; i < numSamples; ++i) {
+        const uint32_t now = (mWriteIndex + static_cast<uint32_t>(i)) & mHistoryMask;
+        const FloatBatch elapsed = broadcast(static_cast<float>(i + 1));
+
+        alignas(ALIGNMENT) float whole[2][NUM_LANES];
+        alignas(ALIGNMENT) float frac[2][NUM_LANES];
+        alignas(ALIGNMENT) float windowIndex[NUM_LANES];
+        alignas(ALIGNMENT) float windowFrac[NUM_LANES];
+        alignas(ALIGNMENT) float points[2][GATHERED][NUM_LANES];   // Head outputs when PER_LANE
+        alignas(ALIGNMENT) float windowPoints[2][NUM_LANES];
+        alignas(ALIGNMENT) float input[NUM_LANES];
+        alignas(ALIGNMENT) float output[NUM_LANES];
+
+        // Glide ratio, grain length and mix; advance both heads and split
+        // their delays and the window position into index and fraction
+        for (int b = 0; b < batches; ++b) {
+            const int o = b * WIDTH;
+
+            FloatBatch target = load(mTargetRatio.data() + o);
+            FloatBatch ratio = target + coeff * (load(mRatio.data() + o) - target);
+            ratio = select(max(ratio - target, target - ratio) < broadcast(1e-6f), target, ratio);
+            store(mRatio.data() + o, ratio);
+
+            FloatBatch grain = load(mGrain.data() + o);
+            grain = grain + min(max(load(mTargetGrain.data() + o) - grain, zero - slew), slew);
+            store(mGrain.data() + o, grain);
+
+            FloatBatch targetMix = load(mTargetMix.data() + o);
+            FloatBatch mix = targetMix + coeff * (load(mMix.data() + o) - targetMix);
+            mix = select(max(mix - targetMix, targetMix - mix) < broadcast(1e-4f), targetMix, mix);
+            store(mMix.data() + o, mix);
+
+            // Delay = phase * grain moves by 1 - ratio per sample
+            FloatBatch phase = load(mPhase.data() + o) + (one - ratio) / grain;
+            phase = select(phase < zero, phase + one, phase);
+            phase = select(phase >= one, phase - one, phase);
+            store(mPhase.data() + o, phase);
+
+            FloatBatch other = phase + half;
+            other = select(other >= one, other - one, other);
+
+            FloatBatch delays[2] = {phase * grain + base, other * grain + base};
+            for (int head = 0; head < 2; ++head) {
+                FloatBatch floor = floorOf(delays[head]);
+                store(whole[head] + o, floor);
+                store(frac[head] + o, delays[head] - floor);
+            }
+
+            // hann(phase) = raisedCosine(|1 - 2 * phase|)
+            FloatBatch centred = one - (phase + phase);
+            FloatBatch position = max(centred, zero - centred) * segments;
+            FloatBatch index = min(floorOf(position), lastIndex);
+            store(windowIndex + o, index);
+            store(windowFrac + o, position - index);
+        }
+
+        // Gather: the only per-lane step
+        for (int lane = 0; lane < lanes; ++lane) {
+            const float* history = mHistory.data() + static_cast<size_t>(lane) * mLaneStride;
+
+            for (int head = 0; head < 2; ++head) {
+                uint32_t offset = static_cast<uint32_t>(whole[head][lane]) + Window::NEWEST;
+                const float* samples = history + ((now - offset) & mHistoryMask);
+
+                if constexpr (PER_LANE) {
+                    // History from before the last reset reads as zero
+                    int valid = static_cast<int>(mFilled[lane]) + i + 1 - static_cast<int>(whole[head][lane]);
+                    int stale = Window::NEWEST + 1 - valid;
+                    int band = PolyphaseSincTable::bandFor(mRatio[lane]);
+                    if (stale > 0) {
+                        alignas(ALIGNMENT) float masked[Window::POINTS];
+                        for (int p = 0; p < Window::POINTS; ++p) masked[p] = p < stale ? 0.0f : samples[p];
+                        points[head][0][lane] = mSincTable->interpolate(masked, frac[head][lane], band);
+                    } else {
+                        points[head][0][lane] = mSincTable->interpolate(samples, frac[head][lane], band);
+                    }
+                } else {
+                    for (int p = 0; p < Window::POINTS; ++p) points[head][p][lane] = samples[p];
+                }
+            }
+
+            int index = static_cast<int>(windowIndex[lane]);
+            windowPoints[0][lane] = hann[index];
+            windowPoints[1][lane] = hann[index + 1];
+
+            input[lane] = inputs[lane][i];
+        }
+
+        // Mask history from before the lane's last reset, overlap-add, then
+        // mix against the untouched input
+        for (int b = 0; b < batches; ++b) {
+            const int o = b * WIDTH;
+
+            FloatBatch heads[2];
+            if constexpr (PER_LANE) {
+                heads[0] = load(points[0][0] + o);
+                heads[1] = load(points[1][0] + o);
+            } else {
+                DelayInterpolation::NoState<FloatBatch> noState;
+                const FloatBatch written = load(mFilled.data() + o) + elapsed;
+
+                for (int head = 0; head < 2; ++head) {
+                    // Point p is whole + NEWEST - p samples old
+                    FloatBatch newest = load(whole[head] + o);
+                    FloatBatch window[Window::POINTS];
+                    for (int p = 0; p < Window::POINTS; ++p) {
+                        FloatBatch age = newest + broadcast(static_cast<float>(Window::NEWEST - p));
+                        window[p] = select(age < written, load(points[head][p] + o), zero);
+                    }
+                    heads[head] = Window::interpolate(window, load(frac[head] + o), noState);
+                }
+            }
+
+            FloatBatch w0 = load(windowPoints[0] + o);
+            FloatBatch window = w0 + load(windowFrac + o) * (load(windowPoints[1] + o) - w0);
+            FloatBatch shifted = heads[1] + window * (heads[0] - heads[1]);
+
+            FloatBatch in = load(input + o);
+            FloatBatch mix = load(mMix.data() + o);
+            store(output + o, select(mix == zero, in, in + mix * (shifted - in)));
+        }
+
+        for (int lane = 0; lane < lanes; ++lane) {
+            outputs[lane][i] = output[lane];
+        }
+    }
+}
+
+void GrainPitchBank::advance(int numSamples, int numLanes) {
+    for (int lane = 0; lane < numLanes; ++lane) {
+        mFilled[lane] = std::min(mFilled[lane] + static_cast<float>(numSamples), static_cast<float>(mHistorySize));
+    }
+    // Skipped lanes' histories fall behind the shared write index
+    for (int lane = numLanes; lane < NUM_LANES; ++lane) {
+        mFilled[lane] = 0.0f;
+    }
+    mWriteIndex = (mWriteIndex + static_cast<uint32_t>(numSamples)) & mHistoryMask;
+}
+
+} // namespace WaterStick
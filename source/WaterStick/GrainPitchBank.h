@@ -0,0 +1,130 @@
+#pragma once
+
+#include "SimdBatch.h"
+#include "PolyphaseSinc.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace WaterStick {
+
+/**
+ * @file GrainPitchBank.h
+ * @brief Dual-grain overlap-add pitch shifter for all 16 taps of one channel
+ *
+ * Each lane keeps a short history of its tap's output and reads it with two
+ * heads half a grain apart. A head's delay moves through a grain of D
+ * samples at 1 - ratio samples per sample, so it plays the history back at
+ * the pitch ratio; leaving the grain, it jumps by D where its Hann window
+ * is zero. Two Hann windows half a period apart sum to one, so the output
+ * keeps unity gain and the jumps are never heard. The read head never
+ * crosses the write head.
+ *
+ * The window is the shared raised-cosine table (FadeEngine.h) read at
+ * |1 - 2 * phase|; one lookup serves both heads, the second window being
+ * one minus the first.
+ *
+ * Grain length follows the ratio, D = |1 - ratio| * sampleRate /
+ * GRAIN_RATE_HZ within [MIN_GRAIN_SECONDS, MAX_GRAIN_SECONDS], so grains
+ * restart at about GRAIN_RATE_HZ: short grains for small intervals (less
+ * doubling), long ones for octaves (less roughness). D moves towards a new
+ * length by at most GRAIN_SLEW samples per sample, bending the pitch by at
+ * most that fraction while it does.
+ *
+ * Ratios glide with a 5 ms one-pole. A lane at unity passes its input
+ * through untouched and crossfades to and from the grains with the same
+ * time constant. State updates, windows and the mix run across lanes in
+ * simd::FloatBatch; only history and table reads are per lane, and the
+ * cost per sample does not depend on the ratios. With every lane at unity
+ * a block only copies.
+ *
+ * Heads read the history through one of three kernels: Linear (2 points),
+ * Hermite (4) or Sinc (16, PolyphaseSinc.h, band-limited against aliasing
+ * on upward shifts). Linear and Hermite run across lanes like the rest;
+ * Sinc is a dot product per head and lane. Each kernel's heads sit its
+ * LOOKAHEAD samples further back so no window reaches past the input, so
+ * a change of kernel moves the heads by a few samples.
+ *
+ * Lane state is one aligned array per field, so a sample's update touches
+ * a few cache lines for all 16 lanes. The histories share one allocation,
+ * lane after lane; each ends in a guard line repeating its first samples,
+ * so a head's interpolation pair never wraps.
+ *
+ * After resetLane() history older than the reset reads as zero, so a reset
+ * lane behaves like a new one without its buffer being cleared.
+ *
+ * A block may run only the first lanes (whole batches of them), for callers
+ * that use fewer than 16; the rest are left alone and lose their history,
+ * so a lane brought back into use needs resetLane() first.
+ */
+class GrainPitchBank {
+public:
+    static constexpr int NUM_LANES = 16;
+    static constexpr float GRAIN_RATE_HZ = 20.0f;
+    static constexpr float MIN_GRAIN_SECONDS = 0.02f;
+    static constexpr float MAX_GRAIN_SECONDS = 0.06f;
+    static constexpr float GRAIN_SLEW = 0.03f;
+    static constexpr float SMOOTHING_SECONDS = 0.005f;
+
+    enum class Interpolation { Linear, Hermite, Sinc };
+
+    GrainPitchBank();
+
+    // Allocates the lane histories; not for the audio thread
+    void initialize(double sampleRate, int maxBlockSize);
+
+    void setRatio(int lane, float ratio);
+
+    // Applies from the next block
+    void setInterpolation(Interpolation interpolation) { mInterpolation = interpolation; }
+    Interpolation getInterpolation() const { return mInterpolation; }
+
+    // Lands the lane on its target ratio and grain with no history
+    void resetLane(int lane);
+
+    // numSamples (at most maxBlockSize) per lane from inputs to outputs, for
+    // the first numLanes lanes rounded up to a whole batch
+    void processBlock(const float* const* inputs, float* const* outputs, int numSamples,
+                      int numLanes = NUM_LANES);
+
+private:
+    static constexpr int WIDTH = simd::FloatBatch::WIDTH;
+    static constexpr int NUM_BATCHES = NUM_LANES / WIDTH;
+    static_assert(NUM_LANES % WIDTH == 0, "Lanes must fill whole batches");
+
+    // One cache line after each history; at least the widest window less one
+    static constexpr int HISTORY_GUARD = 16;
+    static_assert(HISTORY_GUARD >= PolyphaseSincTable::POINTS - 1, "Windows must not wrap");
+
+    float grainLengthFor(float ratio) const;
+    void writeHistory(int lane, const float* input, int numSamples);
+
+    // Grains and mix of the first batches * WIDTH lanes, reading through
+    // Window: a DelayInterpolation policy or PolyphaseSincTable
+    template <typename Window>
+    void processGrains(const float* const* inputs, float* const* outputs, int numSamples, int batches);
+    void advance(int numSamples, int numLanes);  // Write index and filled counts past a block
+
+    double mSampleRate;
+    float mSmoothingCoeff;
+    Interpolation mInterpolation;
+    const PolyphaseSincTable* mSincTable;
+
+    std::vector<float> mHistory;   // NUM_LANES * mLaneStride
+    int mHistorySize;
+    int mLaneStride;               // mHistorySize + HISTORY_GUARD
+    uint32_t mHistoryMask;
+    uint32_t mWriteIndex;
+
+    // Lane state, one entry per tap
+    alignas(simd::ALIGNMENT) std::array<float, NUM_LANES> mFilled;       // Samples since reset, saturating
+    alignas(simd::ALIGNMENT) std::array<float, NUM_LANES> mRatio;
+    alignas(simd::ALIGNMENT) std::array<float, NUM_LANES> mTargetRatio;
+    alignas(simd::ALIGNMENT) std::array<float, NUM_LANES> mGrain;         // Grain length, samples
+    alignas(simd::ALIGNMENT) std::array<float, NUM_LANES> mTargetGrain;
+    alignas(simd::ALIGNMENT) std::array<float, NUM_LANES> mPhase;         // First head, [0, 1)
+    alignas(simd::ALIGNMENT) std::array<float, NUM_LANES> mMix;           // 0 = input, 1 = grains
+    alignas(simd::ALIGNMENT) std::array<float, NUM_LANES> mTargetMix;
+};
+
+} // namespace WaterStick
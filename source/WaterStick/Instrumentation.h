@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+// Processing-time measurement on the audio thread. Off by default: with it
+// off no clock is read while processing and every reported time is zero
+#ifndef WATERSTICK_INSTRUMENT_TIMING
+#define WATERSTICK_INSTRUMENT_TIMING 0
+#endif
+
+namespace WaterStick {
+
+/**
+ * @file Instrumentation.h
+ * @brief Block-granularity timing and cross-thread monitoring counters
+ *
+ * BlockTimer measures a whole block or one stage of it; per-sample timing
+ * costs more than most of what it measures. With
+ * WATERSTICK_INSTRUMENT_TIMING off it is empty and elapsed() and lap() are
+ * constant zero, so code under `if (BlockTimer::ENABLED)` compiles away.
+ *
+ * MonitorCounter holds a value the audio thread publishes for other
+ * threads to read. It sits alone on its cache line, so a reader polling one
+ * counter never invalidates the line holding another or the processing
+ * state next to it, and it is written with relaxed stores: readers want a
+ * recent value, not an ordering.
+ */
+class BlockTimer {
+public:
+    static constexpr bool ENABLED = WATERSTICK_INSTRUMENT_TIMING != 0;
+
+#if WATERSTICK_INSTRUMENT_TIMING
+    void start() { mStart = Clock::now(); }
+
+    // Microseconds since start() or the previous lap()
+    double elapsed() const {
+        return std::chrono::duration<double, std::micro>(Clock::now() - mStart).count();
+    }
+
+    // elapsed(), then restarts
+    double lap() {
+        Clock::time_point now = Clock::now();
+        double elapsedUs = std::chrono::duration<double, std::micro>(now - mStart).count();
+        mStart = now;
+        return elapsedUs;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point mStart;
+#else
+    void start() {}
+    double elapsed() const { return 0.0; }
+    double lap() { return 0.0; }
+#endif
+};
+
+constexpr int CACHE_LINE_SIZE = 64;
+
+template <typename T>
+class alignas(CACHE_LINE_SIZE) MonitorCounter {
+public:
+    MonitorCounter(T initial = T()) : mValue(initial) {}
+
+    T load() const { return mValue.load(std::memory_order_relaxed); }
+    void store(T value) { mValue.store(value, std::memory_order_relaxed); }
+
+    // Single writer only
+    void storeMax(T value) {
+        if (value > load()) store(value);
+    }
+
+private:
+    std::atomic<T> mValue;
+};
+
+} // namespace WaterStick
@@ -0,0 +1,176 @@
+#include "MirroredRingBuffer.h"
+#include <algorithm>
+#include <cstdlib>
+
+#if WATERSTICK_VIRTUAL_MIRROR && defined(__APPLE__)
+#include <mach/mach.h>
+#elif WATERSTICK_VIRTUAL_MIRROR
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace WaterStick {
+
+MirroredRingBuffer::~MirroredRingBuffer() {
+    release();
+}
+
+void MirroredRingBuffer::allocate(int minSize, int guardSamples, Mirror mirror) {
+    int size = 1;
+    while (size < minSize) {
+        size <<= 1;
+    }
+    guardSamples = std::max(0, std::min(guardSamples, size));
+
+    if (mData && size == mSize && guardSamples == mGuardSamples && mirror == mMirror) {
+        // Untouched storage is still zeros and its pages stay uncommitted
+        if (mWritten) clear();
+        return;
+    }
+
+    release();
+
+    const size_t bytes = static_cast<size_t>(size) * sizeof(float);
+    if (mirror != Mirror::Virtual || !mapVirtualMirror(bytes)) {
+        // Heap storage with the guard tail; write() keeps it in step
+        mData = static_cast<float*>(std::calloc(static_cast<size_t>(size) + guardSamples, sizeof(float)));
+        mVirtualMirror = false;
+        mCopied = guardSamples;
+    }
+
+    mSize = mData ? size : 0;
+    mMask = mData ? static_cast<uint32_t>(size - 1) : 0;
+    mGuardSamples = guardSamples;
+    mMirror = mirror;
+}
+
+bool MirroredRingBuffer::mapVirtualMirror(size_t bytes) {
+#if WATERSTICK_VIRTUAL_MIRROR && defined(__APPLE__)
+    // Each half must be whole pages to be mapped on its own
+    if (bytes % static_cast<size_t>(vm_page_size) != 0) return false;
+
+    // Allocate both halves, then remap the first over the second
+    const mach_port_t task = mach_task_self();
+    vm_address_t base = 0;
+    if (vm_allocate(task, &base, 2 * bytes, VM_FLAGS_ANYWHERE) != KERN_SUCCESS) return false;
+
+    vm_address_t mirror = base + bytes;
+    vm_prot_t currentProtection, maximumProtection;
+    kern_return_t result = vm_remap(task, &mirror, bytes, 0, VM_FLAGS_FIXED | VM_FLAGS_OVERWRITE,
+                                    task, base, FALSE, &currentProtection, &maximumProtection,
+                                    VM_INHERIT_DEFAULT);
+    if (result != KERN_SUCCESS || mirror != base + bytes) {
+        vm_deallocate(task, base, 2 * bytes);
+        return false;
+    }
+
+    // vm_allocate hands out zeroed pages
+    mData = reinterpret_cast<float*>(base);
+    mVirtualMirror = true;
+    mCopied = 0;
+    mMappedBytes = 2 * bytes;
+    return true;
+#elif WATERSTICK_VIRTUAL_MIRROR
+    // Each half must be whole pages to be mapped on its own; smaller
+    // buffers keep their size and use the guard tail instead
+    if (bytes % static_cast<size_t>(sysconf(_SC_PAGESIZE)) != 0) return false;
+
+    int fd = static_cast<int>(syscall(SYS_memfd_create, "waterstick-ring", 0));
+    if (fd < 0) return false;
+
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    // Reserve both halves, then map the same file over each of them
+    void* base = mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+
+    char* first = static_cast<char*>(base);
+    bool mapped = mmap(first, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == first &&
+                  mmap(first + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == first + bytes;
+    close(fd);
+
+    if (!mapped) {
+        munmap(base, 2 * bytes);
+        return false;
+    }
+
+    // A fresh memfd reads as zeros
+    mData = static_cast<float*>(base);
+    mVirtualMirror = true;
+    mCopied = 0;
+    mMappedBytes = 2 * bytes;
+    return true;
+#else
+    (void)bytes;
+    return false;
+#endif
+}
+
+void MirroredRingBuffer::release() {
+    if (!mData) return;
+
+#if WATERSTICK_VIRTUAL_MIRROR && defined(__APPLE__)
+    if (mVirtualMirror) {
+        vm_deallocate(mach_task_self(), reinterpret_cast<vm_address_t>(mData), mMappedBytes);
+    } else {
+        std::free(mData);
+    }
+#elif WATERSTICK_VIRTUAL_MIRROR
+    if (mVirtualMirror) {
+        munmap(mData, mMappedBytes);
+    } else {
+        std::free(mData);
+    }
+#else
+    std::free(mData);
+#endif
+
+    mData = nullptr;
+    mWritten = false;
+    mSize = 0;
+    mCopied = 0;
+    mMask = 0;
+    mVirtualMirror = false;
+    mMappedBytes = 0;
+}
+
+void MirroredRingBuffer::clear() {
+    if (!mData) return;
+
+    // Clearing the buffer clears a mapped mirror too
+    std::fill(mData, mData + mSize + mCopied, 0.0f);
+    mWritten = false;
+}
+
+void MirroredRingBuffer::writeBlock(uint32_t index, const float* input, int numSamples) {
+    mWritten = true;
+
+    if (mVirtualMirror) {
+        // The mapping makes the destination contiguous across the wrap point
+        std::copy(input, input + numSamples, mData + index);
+        return;
+    }
+
+    const int firstRun = std::min(numSamples, mSize - static_cast<int>(index));
+    std::copy(input, input + firstRun, mData + index);
+    std::copy(input + firstRun, input + numSamples, mData);
+
+    // Refresh the guard tail wherever the block touched the start
+    if (static_cast<int>(index) < mCopied) {
+        int end = std::min(static_cast<int>(index) + firstRun, mCopied);
+        std::copy(mData + index, mData + end, mData + mSize + index);
+    }
+    if (numSamples > firstRun) {
+        int end = std::min(numSamples - firstRun, mCopied);
+        std::copy(mData, mData + end, mData + mSize);
+    }
+}
+
+} // namespace WaterStick
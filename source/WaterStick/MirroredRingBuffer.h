@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Back-to-back mapping of the same pages is available: memfd_create and
+// two mmap calls on Linux, vm_remap on macOS
+#ifndef WATERSTICK_VIRTUAL_MIRROR
+#if defined(__linux__) || defined(__APPLE__)
+#define WATERSTICK_VIRTUAL_MIRROR 1
+#else
+#define WATERSTICK_VIRTUAL_MIRROR 0
+#endif
+#endif
+
+namespace WaterStick {
+
+/**
+ * @file MirroredRingBuffer.h
+ * @brief Power-of-two ring buffer whose start repeats after its end
+ *
+ * data()[i + size()] is data()[i] for every i below guard(), so any read
+ * of up to guard() consecutive samples starting at an index below size()
+ * is contiguous in memory: interpolation kernels read their neighbours
+ * without wrapping and block reads are a single copy.
+ *
+ * Two ways to keep that, chosen per buffer:
+ *
+ * - Mirror::GuardTail (default): the first guardSamples are copied after
+ *   the end. Storage is size() + guard() floats, and only writes landing
+ *   in the first guard() samples are written twice. Callers ask for the
+ *   longest read they make, typically a block plus a kernel.
+ * - Mirror::Virtual: with WATERSTICK_VIRTUAL_MIRROR the whole buffer is
+ *   mapped a second time right after itself, so guard() is size() and
+ *   writes land once. Only worth it for reads that can span the whole
+ *   buffer. Where the platform has no mapping, the mapping fails, or the
+ *   buffer is smaller than a page, it falls back to a guard tail of
+ *   guardSamples; isVirtualMirror() tells which one is in use.
+ *
+ * Sizes are rounded up to a power of two, never further. Allocation and
+ * release are not for the audio thread.
+ */
+class MirroredRingBuffer {
+public:
+    enum class Mirror { GuardTail, Virtual };
+
+    MirroredRingBuffer() = default;
+    ~MirroredRingBuffer();
+
+    MirroredRingBuffer(const MirroredRingBuffer&) = delete;
+    MirroredRingBuffer& operator=(const MirroredRingBuffer&) = delete;
+
+    // Allocates at least minSize samples, cleared, with guardSamples (at
+    // most the size) readable past the end; reuses the current storage
+    // when it was allocated the same way, clearing it only if written since
+    void allocate(int minSize, int guardSamples, Mirror mirror = Mirror::GuardTail);
+    void release();
+
+    void clear();
+
+    // Valid for size() + guard() samples
+    float* data() { return mData; }
+    const float* data() const { return mData; }
+
+    int size() const { return mSize; }
+    int guard() const { return mVirtualMirror ? mSize : mCopied; }
+    uint32_t mask() const { return mMask; }
+    bool isVirtualMirror() const { return mVirtualMirror; }
+
+    // index must already be wrapped
+    void write(uint32_t index, float value) {
+        mWritten = true;
+        mData[index] = value;
+        if (index < static_cast<uint32_t>(mCopied)) mData[index + mSize] = value;
+    }
+
+    // Writes numSamples (at most size()) starting at a wrapped index
+    void writeBlock(uint32_t index, const float* input, int numSamples);
+
+private:
+    float* mData = nullptr;
+    int mSize = 0;
+    int mCopied = 0;   // Samples copied after the end; 0 when mapped
+    uint32_t mMask = 0;
+    bool mVirtualMirror = false;
+    bool mWritten = false;   // Since allocated or cleared; fresh pages are zeros
+    size_t mMappedBytes = 0;
+
+    // As requested, to tell whether allocate() can reuse the storage
+    int mGuardSamples = 0;
+    Mirror mMirror = Mirror::GuardTail;
+
+    bool mapVirtualMirror(size_t bytes);
+};
+
+} // namespace WaterStick
@@ -0,0 +1,129 @@
+#include "ParameterEventScheduler.h"
+#include <cmath>
+
+namespace WaterStick {
+
+// ===================================================================
+// PARAMETER EVENT SCHEDULER IMPLEMENTATION
+// ===================================================================
+
+void ParameterEventScheduler::prepare(int maxEvents) {
+    mMaxEvents = std::max(1, maxEvents);
+
+    // Either stream may hold every event of a block
+    mStepEvents.reserve(mMaxEvents);
+    mRampEvents.reserve(mMaxEvents);
+    mStepEvents.clear();
+    mRampEvents.clear();
+    mStepCursor = 0;
+    mRampCursor = 0;
+}
+
+void ParameterEventScheduler::push(std::vector<Event>& events, const Event& event) {
+    // Capacity was checked per queue, so this never reallocates
+    if (static_cast<int>(events.size()) < mMaxEvents) {
+        events.push_back(event);
+    }
+}
+
+void ParameterEventScheduler::sortEvents() {
+    // Queues arrive one parameter at a time; order by time, then arrival
+    auto earlier = [](const Event& a, const Event& b) {
+        return a.sampleOffset != b.sampleOffset ? a.sampleOffset < b.sampleOffset : a.order < b.order;
+    };
+
+    std::sort(mStepEvents.begin(), mStepEvents.end(), earlier);
+    std::sort(mRampEvents.begin(), mRampEvents.end(), earlier);
+}
+
+// ===================================================================
+// PARAMETER RAMP BANK IMPLEMENTATION
+// ===================================================================
+
+void ParameterRampBank::start(float* target, float endValue, int length, const Mapping& mapping) {
+    if (!target) return;
+
+    // Replace any ramp already driving this target
+    int slot = mNumActive;
+    for (int i = 0; i < mNumActive; ++i) {
+        if (mRamps[i].target == target) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (length <= 1) {
+        // Immediate: lands on the next advance()
+        length = 1;
+    }
+
+    if (slot == mNumActive) {
+        if (mNumActive >= MAX_RAMPS) {
+            *target = endValue;
+            return;
+        }
+        mNumActive++;
+    }
+
+    Ramp& ramp = mRamps[slot];
+    ramp.target = target;
+    ramp.endValue = endValue;
+    ramp.remaining = length;
+    ramp.curve = mapping.curve;
+
+    switch (mapping.curve) {
+        case Curve::Exponential:
+            // Constant ratio per sample; the mapping never reaches zero
+            if (*target > 0.0f && endValue > 0.0f) {
+                ramp.increment = std::pow(endValue / *target, 1.0f / static_cast<float>(length));
+                break;
+            }
+            ramp.curve = Curve::Linear;
+            ramp.increment = (endValue - *target) / static_cast<float>(length);
+            break;
+        case Curve::Mapped:
+            ramp.normalized = mapping.toNormalized(*target);
+            ramp.normalizedStep = (mapping.toNormalized(endValue) - ramp.normalized) / length;
+            ramp.toPlain = mapping.toPlain;
+            break;
+        case Curve::Linear:
+            ramp.increment = (endValue - *target) / static_cast<float>(length);
+            break;
+    }
+}
+
+void ParameterRampBank::advanceActive() {
+    for (int i = 0; i < mNumActive; ) {
+        Ramp& ramp = mRamps[i];
+
+        if (--ramp.remaining <= 0) {
+            // Land exactly on the queue point, then compact the active list
+            *ramp.target = ramp.endValue;
+            mRamps[i] = mRamps[--mNumActive];
+            continue;
+        }
+
+        switch (ramp.curve) {
+            case Curve::Linear:
+                *ramp.target += ramp.increment;
+                break;
+            case Curve::Exponential:
+                *ramp.target *= ramp.increment;
+                break;
+            case Curve::Mapped:
+                ramp.normalized += ramp.normalizedStep;
+                *ramp.target = ramp.toPlain(ramp.normalized);
+                break;
+        }
+        ++i;
+    }
+}
+
+void ParameterRampBank::finish() {
+    for (int i = 0; i < mNumActive; ++i) {
+        *mRamps[i].target = mRamps[i].endValue;
+    }
+    mNumActive = 0;
+}
+
+} // namespace WaterStick
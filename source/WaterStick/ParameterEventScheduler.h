@@ -0,0 +1,211 @@
+#pragma once
+
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+#include <vector>
+#include <array>
+#include <algorithm>
+
+namespace WaterStick {
+
+/**
+ * @class ParameterEventScheduler
+ * @brief Merges every IParamValueQueue point of a process() call into one timeline
+ *
+ * Points are split into two sorted streams:
+ * - Step events change a parameter at their sample offset. They end the
+ *   current sub-block so the processor can rebuild derived state.
+ * - Ramp events start a ramp towards a queue point, linear in the
+ *   normalized value (see ParameterRampBank). They are consumed inside
+ *   sub-blocks, one sample at a time, so dense automation does not
+ *   fragment rendering.
+ *
+ * A ramp event starts the sample after the previous point of its queue
+ * (or at sample 0 for the first point) and reaches its value exactly on
+ * the point's own offset.
+ *
+ * Real-time safe: storage is reserved in prepare(), and collect() never
+ * allocates. When the reserve is exhausted, the remaining queues fall
+ * back to a single step at their last point.
+ */
+class ParameterEventScheduler {
+public:
+    struct Event {
+        Steinberg::int32 sampleOffset;   // Sample the event takes effect
+        Steinberg::int32 rampLength;     // Samples to reach value (0 = step)
+        Steinberg::Vst::ParamID id;
+        Steinberg::Vst::ParamValue value;
+        Steinberg::int32 order;          // Arrival order, keeps sorting stable
+    };
+
+    static constexpr int DEFAULT_MAX_EVENTS = 4096;
+
+    ParameterEventScheduler() { prepare(DEFAULT_MAX_EVENTS); }
+
+    /**
+     * @brief Reserve event storage (call off the audio thread)
+     */
+    void prepare(int maxEvents);
+
+    /**
+     * @brief Gather and sort all points for one process() call
+     * @param isRamped Predicate selecting parameters that ramp
+     */
+    template <typename IsRamped>
+    void collect(Steinberg::Vst::IParameterChanges* changes, Steinberg::int32 numSamples, IsRamped isRamped);
+
+    /**
+     * @brief Next step event due at or before sampleOffset, or nullptr
+     */
+    const Event* popStepEvent(Steinberg::int32 sampleOffset) {
+        if (mStepCursor < static_cast<int>(mStepEvents.size()) &&
+            mStepEvents[mStepCursor].sampleOffset <= sampleOffset) {
+            return &mStepEvents[mStepCursor++];
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Next ramp event starting at or before sampleOffset, or nullptr
+     */
+    const Event* popRampEvent(Steinberg::int32 sampleOffset) {
+        if (mRampCursor < static_cast<int>(mRampEvents.size()) &&
+            mRampEvents[mRampCursor].sampleOffset <= sampleOffset) {
+            return &mRampEvents[mRampCursor++];
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Offset of the next pending step event (numSamples if none)
+     */
+    Steinberg::int32 getNextStepOffset() const {
+        return mStepCursor < static_cast<int>(mStepEvents.size())
+            ? mStepEvents[mStepCursor].sampleOffset
+            : mNumSamples;
+    }
+
+    bool hasPendingRampEvents() const { return mRampCursor < static_cast<int>(mRampEvents.size()); }
+
+private:
+    std::vector<Event> mStepEvents;
+    std::vector<Event> mRampEvents;
+    int mMaxEvents = 0;
+    int mStepCursor = 0;
+    int mRampCursor = 0;
+    Steinberg::int32 mNumSamples = 0;
+
+    void push(std::vector<Event>& events, const Event& event);
+    void sortEvents();
+};
+
+/**
+ * @class ParameterRampBank
+ * @brief Per-sample ramps applied directly to plain parameter members
+ *
+ * Host queue points are linear in the normalized value, so a ramp follows
+ * the parameter's mapping between consecutive points: plain values of
+ * linear mappings step by a constant increment, those of exponential
+ * mappings (a * b^v: gains, cutoff) by a constant ratio, and any other
+ * mapping is converted from the normalized value every sample. A new ramp
+ * on a target replaces the one already running there.
+ */
+class ParameterRampBank {
+public:
+    static constexpr int MAX_RAMPS = 128;
+
+    enum class Curve { Linear, Exponential, Mapped };
+
+    struct Mapping {
+        Curve curve = Curve::Linear;
+        float (*toPlain)(double normalized) = nullptr;   // Mapped only
+        double (*toNormalized)(float plain) = nullptr;
+    };
+
+    void start(float* target, float endValue, int length, const Mapping& mapping);
+
+    // Advance every active ramp by one sample
+    void advance() {
+        if (mNumActive == 0) return;
+        advanceActive();
+    }
+
+    // Jump all ramps to their end values
+    void finish();
+    void clear() { mNumActive = 0; }
+
+    bool isActive() const { return mNumActive > 0; }
+
+private:
+    struct Ramp {
+        float* target;
+        float increment;       // Ratio for Exponential
+        float endValue;
+        int remaining;
+        Curve curve;
+        double normalized;     // Mapped only
+        double normalizedStep;
+        float (*toPlain)(double normalized);
+    };
+
+    std::array<Ramp, MAX_RAMPS> mRamps{};
+    int mNumActive = 0;
+
+    void advanceActive();
+};
+
+// ===================================================================
+// Template implementation
+// ===================================================================
+
+template <typename IsRamped>
+void ParameterEventScheduler::collect(Steinberg::Vst::IParameterChanges* changes, Steinberg::int32 numSamples, IsRamped isRamped) {
+    mStepEvents.clear();
+    mRampEvents.clear();
+    mStepCursor = 0;
+    mRampCursor = 0;
+    mNumSamples = numSamples;
+
+    if (!changes || numSamples <= 0) return;
+
+    const Steinberg::int32 lastOffset = numSamples - 1;
+    Steinberg::int32 order = 0;
+
+    Steinberg::int32 numQueues = changes->getParameterCount();
+    for (Steinberg::int32 q = 0; q < numQueues; ++q) {
+        Steinberg::Vst::IParamValueQueue* queue = changes->getParameterData(q);
+        if (!queue) continue;
+
+        const Steinberg::Vst::ParamID id = queue->getParameterId();
+        const Steinberg::int32 numPoints = queue->getPointCount();
+        const bool ramped = isRamped(id);
+        const int used = static_cast<int>(mStepEvents.size() + mRampEvents.size());
+
+        // Out of reserve: keep the legacy last-point behaviour for this queue
+        Steinberg::int32 firstPoint = (used + numPoints > mMaxEvents) ? numPoints - 1 : 0;
+        Steinberg::int32 previousOffset = -1;
+
+        for (Steinberg::int32 p = firstPoint; p < numPoints; ++p) {
+            Steinberg::int32 offset;
+            Steinberg::Vst::ParamValue value;
+            if (queue->getPoint(p, offset, value) != Steinberg::kResultTrue) continue;
+
+            offset = std::max<Steinberg::int32>(0, std::min(offset, lastOffset));
+
+            Event event{offset, 0, id, value, order++};
+            if (ramped && firstPoint == 0) {
+                Steinberg::int32 start = std::min(previousOffset + 1, offset);
+                event.sampleOffset = start;
+                event.rampLength = offset - start + 1;
+                push(mRampEvents, event);
+            } else {
+                push(mStepEvents, event);
+            }
+
+            previousOffset = offset;
+        }
+    }
+
+    sortEvents();
+}
+
+} // namespace WaterStick
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "SimdBatch.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace WaterStick {
+
+/**
+ * @file PolyphaseSinc.h
+ * @brief Kaiser-windowed sinc fractional delay, tabulated once per process
+ *
+ * Same window convention as DelayInterpolation.h: POINTS samples oldest
+ * first, window[NEWEST] k samples behind the write position, result the
+ * signal frac samples further back. Rows are tabulated at PHASES + 1
+ * fractions and interpolated linearly; each row is one cache line.
+ *
+ * A head reading faster than real time (pitch ratio r > 1) raises every
+ * frequency by r, so content above Nyquist / r would alias. The table has
+ * BANDS sets of rows with the cutoff lowered for ratios up to 2^(1/3),
+ * 2^(2/3) and 2; bandFor() picks the set for a head's ratio. Band 0 (down
+ * to unity) passes up to about 0.35 * sampleRate within 0.1 dB.
+ *
+ * interpolate() is one dot product of the window against the row, in
+ * simd::FloatBatch steps (two with AVX2, four with SSE2 or NEON) plus a
+ * horizontal sum. Rows are normalised to unity DC gain.
+ */
+class PolyphaseSincTable {
+public:
+    static constexpr int POINTS = 16;
+    static constexpr int NEWEST = POINTS / 2;
+    static constexpr int LOOKAHEAD = POINTS - 1 - NEWEST;
+    static constexpr float SPLIT = 0.0f;
+    static constexpr int PHASES = 256;
+    static constexpr int BANDS = 4;
+
+    static_assert(POINTS % simd::FloatBatch::WIDTH == 0, "Rows must fill whole batches");
+
+    // Built on first use; callers resolve it off the audio thread
+    static const PolyphaseSincTable& shared() {
+        static const PolyphaseSincTable table;
+        return table;
+    }
+
+    static int bandFor(float ratio) {
+        return (ratio > 1.0001f) + (ratio > 1.2600f) + (ratio > 1.5875f);
+    }
+
+    // window: POINTS samples, any alignment; frac in [0, 1]
+    float interpolate(const float* window, float frac, int band) const {
+        using namespace simd;
+        constexpr int WIDTH = FloatBatch::WIDTH;
+
+        float position = frac * static_cast<float>(PHASES);
+        int phase = std::min(static_cast<int>(position), PHASES - 1);
+        const FloatBatch t = broadcast(position - static_cast<float>(phase));
+        const float* row = mRows.data() + (static_cast<size_t>(band) * (PHASES + 1) + phase) * POINTS;
+
+        FloatBatch acc = broadcast(0.0f);
+        for (int p = 0; p < POINTS; p += WIDTH) {
+            FloatBatch a = load(row + p);
+            FloatBatch coeff = mulAdd(t, load(row + POINTS + p) - a, a);
+            acc = mulAdd(loadUnaligned(window + p), coeff, acc);
+        }
+        return sum(acc);
+    }
+
+private:
+    PolyphaseSincTable() {
+        constexpr double PI = 3.14159265358979323846;
+        constexpr double BETA = 7.0;
+        constexpr double PASSBAND = 0.9;   // Of Nyquist, band 0
+
+        for (int band = 0; band < BANDS; ++band) {
+            double cutoff = PASSBAND / std::pow(2.0, band / 3.0);
+
+            for (int phase = 0; phase <= PHASES; ++phase) {
+                double frac = static_cast<double>(phase) / PHASES;
+                float* row = mRows.data() + (static_cast<size_t>(band) * (PHASES + 1) + phase) * POINTS;
+
+                double gain = 0.0;
+                std::array<double, POINTS> taps;
+                for (int p = 0; p < POINTS; ++p) {
+                    double x = NEWEST - p - frac;   // Distance from the read position
+                    double sinc = std::abs(x) < 1e-9 ? cutoff : std::sin(PI * cutoff * x) / (PI * x);
+                    double u = x / NEWEST;
+                    double window = besselI0(BETA * std::sqrt(std::max(0.0, 1.0 - u * u))) / besselI0(BETA);
+                    taps[p] = sinc * window;
+                    gain += taps[p];
+                }
+                for (int p = 0; p < POINTS; ++p) {
+                    row[p] = static_cast<float>(taps[p] / gain);
+                }
+            }
+        }
+    }
+
+    static double besselI0(double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; term > 1e-12 * sum; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    alignas(64) std::array<float, BANDS * (PHASES + 1) * POINTS> mRows;
+};
+
+} // namespace WaterStick
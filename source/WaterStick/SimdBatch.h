@@ -0,0 +1,321 @@
+#pragma once
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace WaterStick {
+namespace simd {
+
+/**
+ * @file SimdBatch.h
+ * @brief Minimal float batch wrapper for lane-parallel DSP kernels
+ *
+ * FloatBatch holds WIDTH floats: 8 with AVX2, 4 with SSE2 or NEON, and
+ * 1 in the portable scalar build. SSE2 is part of every x86-64 target, so
+ * x86 builds get the 4-lane kernels without extra compiler flags. MaskBatch is the matching lane mask
+ * produced by comparisons and consumed by select().
+ *
+ * mulAdd() fuses where the target has FMA, so its rounding may differ
+ * between builds; sum() adds the lanes of one batch.
+ *
+ * Loads and stores expect pointers aligned to ALIGNMENT bytes; the
+ * Unaligned variants are for caller-owned buffers of any alignment. Kernels
+ * written against this interface stay identical across instruction sets;
+ * only this header knows about intrinsics.
+ */
+
+static constexpr int ALIGNMENT = 32;
+
+// ===================================================================
+// AVX2: 8 lanes
+// ===================================================================
+
+#if defined(__AVX2__)
+
+struct FloatBatch {
+    static constexpr int WIDTH = 8;
+    __m256 v;
+};
+
+struct MaskBatch {
+    __m256 v;
+};
+
+inline FloatBatch load(const float* p) { return {_mm256_load_ps(p)}; }
+inline void store(float* p, FloatBatch a) { _mm256_store_ps(p, a.v); }
+inline FloatBatch loadUnaligned(const float* p) { return {_mm256_loadu_ps(p)}; }
+inline void storeUnaligned(float* p, FloatBatch a) { _mm256_storeu_ps(p, a.v); }
+inline FloatBatch broadcast(float x) { return {_mm256_set1_ps(x)}; }
+
+inline FloatBatch operator+(FloatBatch a, FloatBatch b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline FloatBatch operator-(FloatBatch a, FloatBatch b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline FloatBatch operator*(FloatBatch a, FloatBatch b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline FloatBatch operator/(FloatBatch a, FloatBatch b) { return {_mm256_div_ps(a.v, b.v)}; }
+inline FloatBatch min(FloatBatch a, FloatBatch b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline FloatBatch max(FloatBatch a, FloatBatch b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline FloatBatch abs(FloatBatch a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+inline FloatBatch copySign(FloatBatch magnitude, FloatBatch sign) {  // |magnitude| with the sign of sign
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    return {_mm256_or_ps(_mm256_andnot_ps(signBit, magnitude.v), _mm256_and_ps(signBit, sign.v))};
+}
+
+inline MaskBatch operator<(FloatBatch a, FloatBatch b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+inline MaskBatch operator>(FloatBatch a, FloatBatch b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+inline MaskBatch operator>=(FloatBatch a, FloatBatch b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+inline MaskBatch operator==(FloatBatch a, FloatBatch b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ)}; }
+
+inline MaskBatch operator&(MaskBatch a, MaskBatch b) { return {_mm256_and_ps(a.v, b.v)}; }
+inline MaskBatch operator|(MaskBatch a, MaskBatch b) { return {_mm256_or_ps(a.v, b.v)}; }
+inline MaskBatch andNot(MaskBatch a, MaskBatch b) { return {_mm256_andnot_ps(b.v, a.v)}; }  // a & ~b
+inline bool any(MaskBatch m) { return _mm256_movemask_ps(m.v) != 0; }
+
+inline FloatBatch select(MaskBatch m, FloatBatch a, FloatBatch b) { return {_mm256_blendv_ps(b.v, a.v, m.v)}; }
+
+inline FloatBatch mulAdd(FloatBatch a, FloatBatch b, FloatBatch c) {  // a * b + c
+#if defined(__FMA__)
+    return {_mm256_fmadd_ps(a.v, b.v, c.v)};
+#else
+    return {_mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v)};
+#endif
+}
+inline float sum(FloatBatch a) {  // Across lanes
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+}
+
+inline FloatBatch roundNearest(FloatBatch a) { return {_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+inline FloatBatch exp2Integer(FloatBatch n) {  // 2^n for integral n in [-126, 127]
+    __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n.v), _mm256_set1_epi32(127)), 23);
+    return {_mm256_castsi256_ps(bits)};
+}
+
+// ===================================================================
+// SSE2: 4 lanes
+// ===================================================================
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+struct FloatBatch {
+    static constexpr int WIDTH = 4;
+    __m128 v;
+};
+
+struct MaskBatch {
+    __m128 v;
+};
+
+inline FloatBatch load(const float* p) { return {_mm_load_ps(p)}; }
+inline void store(float* p, FloatBatch a) { _mm_store_ps(p, a.v); }
+inline FloatBatch loadUnaligned(const float* p) { return {_mm_loadu_ps(p)}; }
+inline void storeUnaligned(float* p, FloatBatch a) { _mm_storeu_ps(p, a.v); }
+inline FloatBatch broadcast(float x) { return {_mm_set1_ps(x)}; }
+
+inline FloatBatch operator+(FloatBatch a, FloatBatch b) { return {_mm_add_ps(a.v, b.v)}; }
+inline FloatBatch operator-(FloatBatch a, FloatBatch b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline FloatBatch operator*(FloatBatch a, FloatBatch b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline FloatBatch operator/(FloatBatch a, FloatBatch b) { return {_mm_div_ps(a.v, b.v)}; }
+inline FloatBatch min(FloatBatch a, FloatBatch b) { return {_mm_min_ps(a.v, b.v)}; }
+inline FloatBatch max(FloatBatch a, FloatBatch b) { return {_mm_max_ps(a.v, b.v)}; }
+inline FloatBatch abs(FloatBatch a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+inline FloatBatch copySign(FloatBatch magnitude, FloatBatch sign) {  // |magnitude| with the sign of sign
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    return {_mm_or_ps(_mm_andnot_ps(signBit, magnitude.v), _mm_and_ps(signBit, sign.v))};
+}
+
+inline MaskBatch operator<(FloatBatch a, FloatBatch b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline MaskBatch operator>(FloatBatch a, FloatBatch b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline MaskBatch operator>=(FloatBatch a, FloatBatch b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+inline MaskBatch operator==(FloatBatch a, FloatBatch b) { return {_mm_cmpeq_ps(a.v, b.v)}; }
+
+inline MaskBatch operator&(MaskBatch a, MaskBatch b) { return {_mm_and_ps(a.v, b.v)}; }
+inline MaskBatch operator|(MaskBatch a, MaskBatch b) { return {_mm_or_ps(a.v, b.v)}; }
+inline MaskBatch andNot(MaskBatch a, MaskBatch b) { return {_mm_andnot_ps(b.v, a.v)}; }  // a & ~b
+inline bool any(MaskBatch m) { return _mm_movemask_ps(m.v) != 0; }
+
+inline FloatBatch select(MaskBatch m, FloatBatch a, FloatBatch b) {
+    return {_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v))};
+}
+
+inline FloatBatch mulAdd(FloatBatch a, FloatBatch b, FloatBatch c) { return {_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)}; }
+inline float sum(FloatBatch a) {
+    __m128 s = _mm_add_ps(a.v, _mm_movehl_ps(a.v, a.v));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+}
+
+inline FloatBatch roundNearest(FloatBatch a) { return {_mm_cvtepi32_ps(_mm_cvtps_epi32(a.v))}; }  // MXCSR default: nearest
+inline FloatBatch exp2Integer(FloatBatch n) {  // 2^n for integral n in [-126, 127]
+    __m128i bits = _mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n.v), _mm_set1_epi32(127)), 23);
+    return {_mm_castsi128_ps(bits)};
+}
+
+// ===================================================================
+// NEON: 4 lanes
+// ===================================================================
+
+#elif defined(__ARM_NEON__)
+
+struct FloatBatch {
+    static constexpr int WIDTH = 4;
+    float32x4_t v;
+};
+
+struct MaskBatch {
+    uint32x4_t v;
+};
+
+inline FloatBatch load(const float* p) { return {vld1q_f32(p)}; }
+inline void store(float* p, FloatBatch a) { vst1q_f32(p, a.v); }
+inline FloatBatch loadUnaligned(const float* p) { return {vld1q_f32(p)}; }
+inline void storeUnaligned(float* p, FloatBatch a) { vst1q_f32(p, a.v); }
+inline FloatBatch broadcast(float x) { return {vdupq_n_f32(x)}; }
+
+inline FloatBatch operator+(FloatBatch a, FloatBatch b) { return {vaddq_f32(a.v, b.v)}; }
+inline FloatBatch operator-(FloatBatch a, FloatBatch b) { return {vsubq_f32(a.v, b.v)}; }
+inline FloatBatch operator*(FloatBatch a, FloatBatch b) { return {vmulq_f32(a.v, b.v)}; }
+inline FloatBatch operator/(FloatBatch a, FloatBatch b) {
+#if defined(__aarch64__)
+    return {vdivq_f32(a.v, b.v)};
+#else
+    // ARMv7 has no divide: reciprocal estimate plus two Newton steps
+    float32x4_t r = vrecpeq_f32(b.v);
+    r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+    r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+    return {vmulq_f32(a.v, r)};
+#endif
+}
+inline FloatBatch min(FloatBatch a, FloatBatch b) { return {vminq_f32(a.v, b.v)}; }
+inline FloatBatch max(FloatBatch a, FloatBatch b) { return {vmaxq_f32(a.v, b.v)}; }
+inline FloatBatch abs(FloatBatch a) { return {vabsq_f32(a.v)}; }
+inline FloatBatch copySign(FloatBatch magnitude, FloatBatch sign) {  // |magnitude| with the sign of sign
+    return {vbslq_f32(vdupq_n_u32(0x80000000u), sign.v, magnitude.v)};
+}
+
+inline MaskBatch operator<(FloatBatch a, FloatBatch b) { return {vcltq_f32(a.v, b.v)}; }
+inline MaskBatch operator>(FloatBatch a, FloatBatch b) { return {vcgtq_f32(a.v, b.v)}; }
+inline MaskBatch operator>=(FloatBatch a, FloatBatch b) { return {vcgeq_f32(a.v, b.v)}; }
+inline MaskBatch operator==(FloatBatch a, FloatBatch b) { return {vceqq_f32(a.v, b.v)}; }
+
+inline MaskBatch operator&(MaskBatch a, MaskBatch b) { return {vandq_u32(a.v, b.v)}; }
+inline MaskBatch operator|(MaskBatch a, MaskBatch b) { return {vorrq_u32(a.v, b.v)}; }
+inline MaskBatch andNot(MaskBatch a, MaskBatch b) { return {vbicq_u32(a.v, b.v)}; }  // a & ~b
+inline bool any(MaskBatch m) {
+    uint32x2_t folded = vorr_u32(vget_low_u32(m.v), vget_high_u32(m.v));
+    return (vget_lane_u32(folded, 0) | vget_lane_u32(folded, 1)) != 0;
+}
+
+inline FloatBatch select(MaskBatch m, FloatBatch a, FloatBatch b) { return {vbslq_f32(m.v, a.v, b.v)}; }
+
+inline FloatBatch mulAdd(FloatBatch a, FloatBatch b, FloatBatch c) {
+#if defined(__aarch64__)
+    return {vfmaq_f32(c.v, a.v, b.v)};
+#else
+    return {vmlaq_f32(c.v, a.v, b.v)};
+#endif
+}
+inline float sum(FloatBatch a) {
+#if defined(__aarch64__)
+    return vaddvq_f32(a.v);
+#else
+    float32x2_t s = vadd_f32(vget_low_f32(a.v), vget_high_f32(a.v));
+    return vget_lane_f32(vpadd_f32(s, s), 0);
+#endif
+}
+
+inline FloatBatch roundNearest(FloatBatch a) {
+    // Round half away from zero; ties never matter for range reduction
+    float32x4_t half = vbslq_f32(vdupq_n_u32(0x80000000u), a.v, vdupq_n_f32(0.5f));
+    return {vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(a.v, half)))};
+}
+inline FloatBatch exp2Integer(FloatBatch n) {  // 2^n for integral n in [-126, 127]
+    int32x4_t bits = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n.v), vdupq_n_s32(127)), 23);
+    return {vreinterpretq_f32_s32(bits)};
+}
+
+// ===================================================================
+// Portable scalar fallback: 1 lane
+// ===================================================================
+
+#else
+
+struct FloatBatch {
+    static constexpr int WIDTH = 1;
+    float v;
+};
+
+struct MaskBatch {
+    bool v;
+};
+
+inline FloatBatch load(const float* p) { return {*p}; }
+inline void store(float* p, FloatBatch a) { *p = a.v; }
+inline FloatBatch loadUnaligned(const float* p) { return {*p}; }
+inline void storeUnaligned(float* p, FloatBatch a) { *p = a.v; }
+inline FloatBatch broadcast(float x) { return {x}; }
+
+inline FloatBatch operator+(FloatBatch a, FloatBatch b) { return {a.v + b.v}; }
+inline FloatBatch operator-(FloatBatch a, FloatBatch b) { return {a.v - b.v}; }
+inline FloatBatch operator*(FloatBatch a, FloatBatch b) { return {a.v * b.v}; }
+inline FloatBatch operator/(FloatBatch a, FloatBatch b) { return {a.v / b.v}; }
+inline FloatBatch min(FloatBatch a, FloatBatch b) { return {a.v < b.v ? a.v : b.v}; }
+inline FloatBatch max(FloatBatch a, FloatBatch b) { return {a.v > b.v ? a.v : b.v}; }
+inline FloatBatch abs(FloatBatch a) { return {std::fabs(a.v)}; }
+inline FloatBatch copySign(FloatBatch magnitude, FloatBatch sign) { return {std::copysign(magnitude.v, sign.v)}; }
+
+inline MaskBatch operator<(FloatBatch a, FloatBatch b) { return {a.v < b.v}; }
+inline MaskBatch operator>(FloatBatch a, FloatBatch b) { return {a.v > b.v}; }
+inline MaskBatch operator>=(FloatBatch a, FloatBatch b) { return {a.v >= b.v}; }
+inline MaskBatch operator==(FloatBatch a, FloatBatch b) { return {a.v == b.v}; }
+
+inline MaskBatch operator&(MaskBatch a, MaskBatch b) { return {a.v && b.v}; }
+inline MaskBatch operator|(MaskBatch a, MaskBatch b) { return {a.v || b.v}; }
+inline MaskBatch andNot(MaskBatch a, MaskBatch b) { return {a.v && !b.v}; }
+inline bool any(MaskBatch m) { return m.v; }
+
+inline FloatBatch select(MaskBatch m, FloatBatch a, FloatBatch b) { return m.v ? a : b; }
+
+inline FloatBatch mulAdd(FloatBatch a, FloatBatch b, FloatBatch c) { return {a.v * b.v + c.v}; }
+inline float sum(FloatBatch a) { return a.v; }
+
+inline FloatBatch roundNearest(FloatBatch a) { return {std::nearbyint(a.v)}; }
+inline FloatBatch exp2Integer(FloatBatch n) { return {std::ldexp(1.0f, static_cast<int>(n.v))}; }
+
+#endif
+
+// ===================================================================
+// Lane-wise helpers shared by every backend
+// ===================================================================
+
+/**
+ * @brief e^x, Cephes-style range reduction and degree-6 polynomial
+ *
+ * Accurate to about 2 ulp over the clamped range [-87, 87].
+ */
+inline FloatBatch exp(FloatBatch x) {
+    x = min(max(x, broadcast(-87.0f)), broadcast(87.0f));
+
+    // x = n ln2 + r, |r| <= ln2 / 2, with ln2 split for an exact product
+    FloatBatch n = roundNearest(x * broadcast(1.44269504088896341f));
+    FloatBatch r = x - n * broadcast(0.693359375f);
+    r = r - n * broadcast(-2.12194440e-4f);
+
+    FloatBatch p = broadcast(1.9875691500e-4f);
+    p = p * r + broadcast(1.3981999507e-3f);
+    p = p * r + broadcast(8.3334519073e-3f);
+    p = p * r + broadcast(4.1665795894e-2f);
+    p = p * r + broadcast(1.6666665459e-1f);
+    p = p * r + broadcast(5.0000001201e-1f);
+    p = p * r * r + r + broadcast(1.0f);
+
+    return p * exp2Integer(n);
+}
+
+} // namespace simd
+} // namespace WaterStick
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace WaterStick {
+
+/**
+ * @file TailTracker.h
+ * @brief When the delay has gone quiet, and how long its tail may last
+ *
+ * Two answers with different jobs:
+ *
+ * - isDecayed() is measured. observe() is handed the peak of everything
+ *   written into the delay and of the wet output, stretch by stretch. Once
+ *   both have stayed below SILENCE_THRESHOLD for the longest read distance
+ *   plus SETTLE_SECONDS (pitch grains and tap filters running out), no read
+ *   head can find anything but silence, so silent input cannot produce
+ *   output and the caller may stop processing until input returns.
+ * - estimateTailSamples() is the figure reported to the host, from the
+ *   settings alone: the longest tap repeats until the feedback loop gain
+ *   has taken it below the threshold, each pass held back by the damping
+ *   filter's group delay. A loop gain of one or more never decays. Resonant
+ *   tap filters can exceed unity gain, so this is an estimate; the
+ *   decision to stop processing never relies on it.
+ */
+class TailTracker {
+public:
+    static constexpr float SILENCE_THRESHOLD = 1.0e-6f;   // -120 dBFS
+    static constexpr double SETTLE_SECONDS = 0.25;
+    static constexpr uint32_t INFINITE_TAIL = std::numeric_limits<uint32_t>::max();
+
+    void setSampleRate(double sampleRate) {
+        mSettleSamples = static_cast<int>(SETTLE_SECONDS * sampleRate);
+    }
+
+    // Nothing is known to be quiet any more
+    void reset() { mQuietSamples = 0; }
+
+    // Farthest back any read head reaches, in samples; may change any time
+    void setLongestReadDistance(int samples) { mHoldSamples = samples + mSettleSamples; }
+
+    void observe(float peak, int numSamples) {
+        if (peak > SILENCE_THRESHOLD) {
+            mQuietSamples = 0;
+        } else if (mQuietSamples < mHoldSamples) {
+            mQuietSamples += numSamples;
+        }
+    }
+
+    bool isDecayed() const { return mQuietSamples >= mHoldSamples; }
+
+    // loopGain: gain once round the feedback loop at the loudest tap
+    // combination; dampingCoeff: pole of the feedback low-pass, 0 without
+    static uint32_t estimateTailSamples(double sampleRate, double longestDelaySeconds,
+                                        double loopGain, double dampingCoeff) {
+        if (loopGain >= 1.0) return INFINITE_TAIL;
+
+        const double threshold = SILENCE_THRESHOLD;
+        double repeats = loopGain > threshold ? std::ceil(std::log(threshold) / std::log(loopGain)) : 0.0;
+
+        // Each pass is held back by the low-pass group delay, the last one
+        // rings out
+        double lag = 0.0, ring = 0.0;
+        if (dampingCoeff > 0.0 && dampingCoeff < 1.0) {
+            lag = dampingCoeff / (1.0 - dampingCoeff);
+            ring = std::log(threshold) / std::log(dampingCoeff);
+        }
+
+        double samples = (repeats + 1.0) * (longestDelaySeconds * sampleRate + lag) + ring + SETTLE_SECONDS * sampleRate;
+        return static_cast<uint32_t>(std::min(std::ceil(samples), static_cast<double>(INFINITE_TAIL - 1)));
+    }
+
+private:
+    int mSettleSamples = 0;
+    int mHoldSamples = 0;
+    int mQuietSamples = 0;
+};
+
+} // namespace WaterStick
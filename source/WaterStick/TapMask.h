@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace WaterStick {
+
+/**
+ * @file TapMask.h
+ * @brief Iteration over a bit-per-tap mask
+ *
+ * Per-block tap sets (taps to process, taps asleep) are uint32_t masks, bit
+ * n for tap n. forEach() visits the set bits lowest first with one
+ * count-trailing-zeros per tap, so sparse sets cost only their own taps.
+ */
+namespace TapMask {
+
+// Index of the lowest set bit; mask must not be zero
+inline int lowest(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Highest set bit plus one, zero for an empty mask
+inline int span(uint32_t mask) {
+    int count = 0;
+    while (mask >> count) count++;
+    return count;
+}
+
+template <typename Visit>
+inline void forEach(uint32_t mask, Visit&& visit) {
+    while (mask) {
+        visit(lowest(mask));
+        mask &= mask - 1;
+    }
+}
+
+} // namespace TapMask
+} // namespace WaterStick
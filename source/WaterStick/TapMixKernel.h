@@ -0,0 +1,112 @@
+#pragma once
+
+#include "SimdBatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace WaterStick {
+
+/**
+ * @file TapMixKernel.h
+ * @brief Block mixing of tap outputs into the wet bus and the feedback sends
+ *
+ * Each tap's gains arrive as per-sample lanes (parameter history can move
+ * within a block): level and send from the tap's settings, and one gain
+ * per output side with pan and fade folded in. Callers run the kernels for
+ * the taps in their active mask only; nothing inside branches on tap state.
+ *
+ * The pre-effects send is taken before the tap filters and the main bus
+ * after them, so mixing is two passes over a tap:
+ *
+ * - applyLevel():  tap *= level; preSend += tap * send
+ * - mixToBuses():  main = source * gain per side; bus += main;
+ *                  postSend += main * send
+ *
+ * where the source of both sides is L + R when crossSum is set (classic
+ * pan of a summed tap) and each side's own channel otherwise (balance).
+ * Both run along the block in simd::FloatBatch steps with unaligned
+ * access, so callers slice their buffers freely. peak() measures a tap
+ * block the same way, for the sleep decisions of silent taps.
+ */
+namespace TapMixKernel {
+
+inline void applyLevel(float* tap, const float* level, const float* send, float* preSend, int numSamples) {
+    using namespace simd;
+    constexpr int WIDTH = FloatBatch::WIDTH;
+
+    int i = 0;
+    for (; i + WIDTH <= numSamples; i += WIDTH) {
+        FloatBatch leveled = loadUnaligned(tap + i) * loadUnaligned(level + i);
+        storeUnaligned(tap + i, leveled);
+        storeUnaligned(preSend + i, loadUnaligned(preSend + i) + leveled * loadUnaligned(send + i));
+    }
+    for (; i < numSamples; ++i) {
+        tap[i] *= level[i];
+        preSend[i] += tap[i] * send[i];
+    }
+}
+
+inline void mixToBuses(const float* tapL, const float* tapR, bool crossSum,
+                       const float* gainL, const float* gainR, const float* send,
+                       float* busL, float* busR, float* postSendL, float* postSendR, int numSamples) {
+    using namespace simd;
+    constexpr int WIDTH = FloatBatch::WIDTH;
+
+    int i = 0;
+    for (; i + WIDTH <= numSamples; i += WIDTH) {
+        FloatBatch left = loadUnaligned(tapL + i);
+        FloatBatch right = loadUnaligned(tapR + i);
+        if (crossSum) {
+            left = left + right;
+            right = left;
+        }
+
+        FloatBatch mainL = left * loadUnaligned(gainL + i);
+        FloatBatch mainR = right * loadUnaligned(gainR + i);
+        FloatBatch amount = loadUnaligned(send + i);
+
+        storeUnaligned(busL + i, loadUnaligned(busL + i) + mainL);
+        storeUnaligned(busR + i, loadUnaligned(busR + i) + mainR);
+        storeUnaligned(postSendL + i, loadUnaligned(postSendL + i) + mainL * amount);
+        storeUnaligned(postSendR + i, loadUnaligned(postSendR + i) + mainR * amount);
+    }
+    for (; i < numSamples; ++i) {
+        float left = tapL[i];
+        float right = tapR[i];
+        if (crossSum) {
+            left = left + right;
+            right = left;
+        }
+
+        float mainL = left * gainL[i];
+        float mainR = right * gainR[i];
+        busL[i] += mainL;
+        busR[i] += mainR;
+        postSendL[i] += mainL * send[i];
+        postSendR[i] += mainR * send[i];
+    }
+}
+
+// Largest magnitude in the block
+inline float peak(const float* signal, int numSamples) {
+    using namespace simd;
+    constexpr int WIDTH = FloatBatch::WIDTH;
+
+    const FloatBatch zero = broadcast(0.0f);
+    FloatBatch acc = zero;
+    int i = 0;
+    for (; i + WIDTH <= numSamples; i += WIDTH) {
+        FloatBatch x = loadUnaligned(signal + i);
+        acc = max(acc, max(x, zero - x));
+    }
+
+    alignas(ALIGNMENT) float lanes[WIDTH];
+    store(lanes, acc);
+    float result = 0.0f;
+    for (int lane = 0; lane < WIDTH; ++lane) result = std::max(result, lanes[lane]);
+    for (; i < numSamples; ++i) result = std::max(result, std::abs(signal[i]));
+    return result;
+}
+
+} // namespace TapMixKernel
+} // namespace WaterStick
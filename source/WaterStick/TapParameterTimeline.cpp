@@ -0,0 +1,204 @@
+#include "TapParameterTimeline.h"
+#include <algorithm>
+#include <cmath>
+
+namespace WaterStick {
+
+// ===================================================================
+// TAP PARAMETER TIMELINE IMPLEMENTATION
+// ===================================================================
+
+TapParameterTimeline::TapParameterTimeline()
+: mEntries(CAPACITY)
+, mSpans(CAPACITY)
+, mNewest(0)
+, mCount(0)
+, mCursor(0)
+, mLast{}
+, mLastTime(0)
+{
+    reset(Snapshot{}, 0);
+}
+
+void TapParameterTimeline::reset(const Snapshot& initial, int64_t time)
+{
+    mNewest = -1;
+    mCount = 0;
+    openEntry(time, initial);
+    mCursor = mNewest;
+}
+
+void TapParameterTimeline::openEntry(int64_t time, const Snapshot& current)
+{
+    if (mCount == CAPACITY) {
+        // The oldest entry may go once its successor already started beyond
+        // the horizon; otherwise it may still be looked up
+        const int64_t oldest = mNewest - mCount + 1;
+        if (entryAt(oldest + 1).time <= time - mHorizon) {
+            mCount--;
+        } else {
+            compact();
+        }
+    }
+
+    mNewest++;
+    mCount++;
+
+    Entry& entry = entryAt(mNewest);
+    entry.time = time;
+    entry.start = current;
+    entry.levelStep = 0.0f;
+    entry.panStep = 0.0f;
+    entry.cutoffStep = 0.0f;
+    entry.resonanceStep = 0.0f;
+    entry.feedbackSendStep = 0.0f;
+    entry.stepsKnown = false;
+
+    mLast = current;
+    mLastTime = time;
+}
+
+TapParameterTimeline::Snapshot TapParameterTimeline::evaluate(const Entry& entry, int64_t time)
+{
+    Snapshot snapshot = entry.start;
+    if (!entry.stepsKnown) return snapshot;
+
+    float elapsed = static_cast<float>(time - entry.time);
+    snapshot.level += entry.levelStep * elapsed;
+    snapshot.pan += entry.panStep * elapsed;
+    snapshot.filterCutoff += entry.cutoffStep * elapsed;
+    snapshot.filterResonance += entry.resonanceStep * elapsed;
+    snapshot.feedbackSend += entry.feedbackSendStep * elapsed;
+    return snapshot;
+}
+
+TapParameterTimeline::Entry TapParameterTimeline::merge(const Entry& first, const Entry& second, int64_t end)
+{
+    // One line from the first entry's start to where the second one ends
+    Entry merged = first;
+    Snapshot target = evaluate(second, end);
+    float span = static_cast<float>(end - first.time);
+
+    merged.levelStep = (target.level - first.start.level) / span;
+    merged.panStep = (target.pan - first.start.pan) / span;
+    merged.cutoffStep = (target.filterCutoff - first.start.filterCutoff) / span;
+    merged.resonanceStep = (target.filterResonance - first.start.filterResonance) / span;
+    merged.feedbackSendStep = (target.feedbackSend - first.start.feedbackSend) / span;
+    merged.stepsKnown = true;
+
+    // Discrete values of whichever entry was live longer
+    if (end - second.time > second.time - first.time) {
+        merged.start.filterType = second.start.filterType;
+        merged.start.pitchShift = second.start.pitchShift;
+        merged.start.enabled = second.start.enabled;
+    }
+    return merged;
+}
+
+void TapParameterTimeline::compact()
+{
+    // Merge the shortest neighbouring pairs, so entry spans even out and
+    // resolution ends up the same across the horizon. The newest entry may
+    // still grow and is left alone
+    const int64_t oldest = mNewest - mCount + 1;
+    const int64_t candidates = mCount - 2;
+    for (int64_t i = 0; i < candidates; ++i) {
+        mSpans[static_cast<size_t>(i)] = entryAt(oldest + i + 2).time - entryAt(oldest + i).time;
+    }
+    std::nth_element(mSpans.begin(), mSpans.begin() + candidates / 2, mSpans.begin() + candidates);
+    const int64_t longestMerged = mSpans[static_cast<size_t>(candidates / 2)];
+    const int64_t wanted = mCount / 4;
+
+    // One pass oldest first; the cursor follows its entry (or the pair it
+    // went into)
+    int64_t write = oldest;
+    int64_t read = oldest;
+    int64_t freed = 0;
+    int64_t cursor = mCursor;
+    while (read <= mNewest) {
+        if (freed < wanted && read + 2 <= mNewest &&
+            entryAt(read + 2).time - entryAt(read).time <= longestMerged) {
+            Entry merged = merge(entryAt(read), entryAt(read + 1), entryAt(read + 2).time);
+            if (mCursor == read || mCursor == read + 1) cursor = write;
+            entryAt(write++) = merged;
+            read += 2;
+            freed++;
+        } else {
+            if (mCursor == read) cursor = write;
+            entryAt(write++) = entryAt(read++);
+        }
+    }
+
+    mCursor = std::max(cursor, oldest);
+    mNewest = write - 1;
+    mCount = mNewest - oldest + 1;
+    mCompactions++;
+}
+
+void TapParameterTimeline::record(int64_t time, const Snapshot& current)
+{
+    Entry& entry = entryAt(mNewest);
+
+    bool discreteSame = current.filterType == mLast.filterType &&
+                        current.pitchShift == mLast.pitchShift &&
+                        current.enabled == mLast.enabled;
+
+    if (discreteSame) {
+        if (!entry.stepsKnown) {
+            // Second sample of an entry fixes its per-sample step (zero if steady)
+            entry.levelStep = current.level - entry.start.level;
+            entry.panStep = current.pan - entry.start.pan;
+            entry.cutoffStep = current.filterCutoff - entry.start.filterCutoff;
+            entry.resonanceStep = current.filterResonance - entry.start.filterResonance;
+            entry.feedbackSendStep = current.feedbackSend - entry.start.feedbackSend;
+            entry.stepsKnown = (time == entry.time + 1);
+
+            if (entry.stepsKnown) {
+                mLast = current;
+                mLastTime = time;
+                return;
+            }
+        } else {
+            // Still on the entry's line? Ramps accumulate in float, so allow
+            // a small relative error before opening a new entry
+            Snapshot predicted = evaluate(entry, time);
+            auto close = [](float a, float b) {
+                return std::abs(a - b) <= 1.0e-4f * std::max(1.0f, std::abs(b));
+            };
+
+            if (close(predicted.level, current.level) &&
+                close(predicted.pan, current.pan) &&
+                close(predicted.filterCutoff, current.filterCutoff) &&
+                close(predicted.filterResonance, current.filterResonance) &&
+                close(predicted.feedbackSend, current.feedbackSend)) {
+                mLast = current;
+                mLastTime = time;
+                return;
+            }
+        }
+    }
+
+    openEntry(time, current);
+}
+
+TapParameterTimeline::Snapshot TapParameterTimeline::lookup(int64_t time)
+{
+    const int64_t oldest = mNewest - mCount + 1;
+    mCursor = std::max(mCursor, oldest);
+
+    // Walk forward with playback, or back a little when a block is re-read
+    while (mCursor < mNewest && entryAt(mCursor + 1).time <= time) {
+        mCursor++;
+    }
+    while (mCursor > oldest && entryAt(mCursor).time > time) {
+        mCursor--;
+    }
+
+    const Entry& entry = entryAt(mCursor);
+    if (time <= entry.time) return entry.start;
+
+    // Ramps only hold up to the newest recorded sample
+    return evaluate(entry, mCursor == mNewest ? std::min(time, mLastTime) : time);
+}
+
+} // namespace WaterStick
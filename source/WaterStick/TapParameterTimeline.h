@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+namespace WaterStick {
+
+/**
+ * @file TapParameterTimeline.h
+ * @brief Change-log of one tap's parameters, read back at the tap's delay time
+ *
+ * Only changes are stored; a run of samples whose continuous values move by
+ * a constant step (a linear ramp) is kept as a single entry. Entries live
+ * in a fixed ring of CAPACITY, so recording never allocates.
+ *
+ * Lookups reach at most the horizon (setHorizon(), the longest delay plus
+ * a block) behind the newest recorded sample. While the ring holds every
+ * entry inside the horizon, lookups are exact. Dense automation can open
+ * more entries than that: once the ring is full and its oldest entry can
+ * still be looked up, a quarter of the ring is freed instead by merging the
+ * shortest neighbouring pairs, each into one line from the first entry's
+ * values to the values where the pair ends. The whole horizon stays
+ * covered and entry spans even out towards horizon / CAPACITY, the finest
+ * resolution the ring can give it. getCompactions() counts how often that
+ * happened; each costs one pass over the ring.
+ */
+class TapParameterTimeline {
+public:
+    struct Snapshot {
+        float level;
+        float pan;
+        float filterCutoff;
+        float filterResonance;
+        int filterType;
+        int pitchShift;
+        float feedbackSend;
+        bool enabled;
+    };
+
+    static constexpr int CAPACITY = 2048;  // Power of two
+
+    TapParameterTimeline();
+
+    void reset(const Snapshot& initial, int64_t time);
+
+    // Farthest behind the newest recorded sample lookups will go; entries
+    // older than that may be dropped. Unbounded until set
+    void setHorizon(int64_t samples) { mHorizon = samples; }
+
+    // Called once per sample with the live values
+    void record(int64_t time, const Snapshot& current);
+
+    // Values that were live at the given time; amortised O(1) while the
+    // query time moves forward with playback
+    Snapshot lookup(int64_t time);
+
+    // Times the ring filled inside the horizon and lost resolution
+    int64_t getCompactions() const { return mCompactions; }
+
+private:
+    struct Entry {
+        int64_t time;
+        Snapshot start;
+        float levelStep;
+        float panStep;
+        float cutoffStep;
+        float resonanceStep;
+        float feedbackSendStep;
+        bool stepsKnown;  // False until the sample after the entry was opened
+    };
+
+    std::vector<Entry> mEntries;
+    std::vector<int64_t> mSpans;   // Compaction scratch
+    int64_t mNewest;     // Sequence number of the newest entry
+    int64_t mCount;      // Entries currently held (<= CAPACITY)
+    int64_t mCursor;     // Sequence number of the last lookup result
+    Snapshot mLast;
+    int64_t mLastTime;
+    int64_t mHorizon = std::numeric_limits<int64_t>::max();
+    int64_t mCompactions = 0;
+
+    Entry& entryAt(int64_t sequence) { return mEntries[static_cast<size_t>(sequence & (CAPACITY - 1))]; }
+    static Snapshot evaluate(const Entry& entry, int64_t time);
+    static Entry merge(const Entry& first, const Entry& second, int64_t end);
+    void openEntry(int64_t time, const Snapshot& current);
+    void compact();
+};
+
+} // namespace WaterStick
@@ -1,5 +1,6 @@
 #include "ThreeSistersFilter.h"
 #include "WaterStickParameters.h"
+#include "FastTanh.h"
 
 namespace WaterStick {
 
@@ -29,6 +30,12 @@ void SVFUnit::setParameters(double frequency, double resonance) {
     updateCoefficients();
 }
 
+void SVFUnit::setCoefficients(double g, double g1, double d) {
+    g_ = g;
+    g1_ = g1;
+    d_ = d;
+}
+
 void SVFUnit::setSaturationAmount(double saturationAmount) {
     saturationAmount_ = saturationAmount;
 }
@@ -52,13 +59,13 @@ SVFUnit::Outputs SVFUnit::process(double input) {
 
     // Apply tanh saturation to first integrator state for smooth limiting
     // Threshold chosen to prevent harsh clipping while allowing musical resonance
-    s1_ = saturationAmount_ * std::tanh((BP + v1) / saturationAmount_);
+    s1_ = saturationAmount_ * FastTanh::rational((BP + v1) / saturationAmount_);
 
     double v2 = g_ * BP;
     double LP = v2 + s2_;
 
     // Apply tanh saturation to second integrator state
-    s2_ = saturationAmount_ * std::tanh((LP + v2) / saturationAmount_);
+    s2_ = saturationAmount_ * FastTanh::rational((LP + v2) / saturationAmount_);
 
     return {LP, BP, HP};
 }
@@ -81,8 +88,16 @@ ThreeSistersFilter::ThreeSistersFilter()
     , currentMix_(1.0)
     , previousMix_(0.0)
     , previousOutput_(0.0)
+    , coefficientsDirty_(false)
+    , targetG_(0.0)
+    , targetDamping_(0.5)
+    , currentG_(0.0)
+    , currentDamping_(0.5)
+    , gStep_(0.0)
+    , dampingStep_(0.0)
+    , rampRemaining_(0)
 {
-    updateFilterChains();
+    snapCoefficients();
 }
 
 void ThreeSistersFilter::setSampleRate(double sampleRate) {
@@ -100,45 +115,121 @@ void ThreeSistersFilter::setSampleRate(double sampleRate) {
         notchChain_[i].setSampleRate(sampleRate);
     }
 
-    updateFilterChains();
+    snapCoefficients();
 }
 
 void ThreeSistersFilter::setParameters(double frequency, double resonance, int filterType) {
-    frequency_ = frequency;
-    resonance_ = resonance;
+    // Dirty flag only - coefficients follow at control rate in process()
+    if (frequency != frequency_ || resonance != resonance_) {
+        frequency_ = frequency;
+        resonance_ = resonance;
+        coefficientsDirty_ = true;
+    }
 
     // Check if filter type changed
     if (filterType != filterType_) {
         startTransition(filterType);
     }
-
-    updateFilterChains();
 }
 
 void ThreeSistersFilter::updateFilterChains() {
+    // All units share the same pre-warped coefficients (same clamps as SVFUnit)
+    double frequency = std::max(20.0, std::min(frequency_, sampleRate_ * 0.49));
+    targetG_ = tanWarp(frequency / sampleRate_);
+    targetDamping_ = resonanceToDamping(resonance_);
+}
+
+double ThreeSistersFilter::resonanceToDamping(double resonance) {
     // Convert Three Sisters style resonance (-1.0 to +1.0) to SVF damping
     double dampingFactor;
 
-    if (resonance_ >= 0.0) {
+    if (resonance >= 0.0) {
         // Positive resonance: reduce damping for traditional resonance
         // Map 0.0->1.0 to 0.5->0.0005 (moderate damping to very high resonance)
         // Increased resonance range for broader palette of ringing tones
-        dampingFactor = 0.5 * (1.0 - resonance_) + 0.0005 * resonance_;
+        dampingFactor = 0.5 * (1.0 - resonance) + 0.0005 * resonance;
     } else {
         // Negative resonance: use moderate damping for clean filtering
         // We'll implement anti-resonance mixing in the process function
         dampingFactor = 0.5;
     }
 
-    // Update all filter chains with the same parameters
+    return std::max(0.001, std::min(dampingFactor, 50.0));
+}
+
+double ThreeSistersFilter::tanWarp(double normalizedFrequency) {
+    // tan(pi * f / fs) from a table over [0, 0.5) with linear interpolation;
+    // cutoffs are clamped to 0.49 fs, where the table is still well behaved
+    static constexpr int TABLE_SIZE = 4096;
+    static constexpr double TABLE_RANGE = 0.5;
+
+    struct TanTable {
+        double values[TABLE_SIZE + 1];
+        TanTable() {
+            for (int i = 0; i <= TABLE_SIZE; ++i) {
+                double x = std::min(TABLE_RANGE * i / TABLE_SIZE, 0.4999);
+                values[i] = std::tan(M_PI * x);
+            }
+        }
+    };
+    static const TanTable table;
+
+    double position = normalizedFrequency * (TABLE_SIZE / TABLE_RANGE);
+    position = std::max(0.0, std::min(position, static_cast<double>(TABLE_SIZE - 1)));
+    int index = static_cast<int>(position);
+    double fraction = position - index;
+
+    return table.values[index] + fraction * (table.values[index + 1] - table.values[index]);
+}
+
+void ThreeSistersFilter::applyCoefficients(double g, double damping) {
+    // Zero-delay feedback terms computed once for all 8 units
+    double g1 = 2.0 * damping + g;
+    double d = 1.0 / (1.0 + 2.0 * damping * g + g * g);
+
     for (int i = 0; i < 2; ++i) {
-        lpChain_[i].setParameters(frequency_, dampingFactor);
-        hpChain_[i].setParameters(frequency_, dampingFactor);
-        bpChain_[i].setParameters(frequency_, dampingFactor);
-        notchChain_[i].setParameters(frequency_, dampingFactor);
+        lpChain_[i].setCoefficients(g, g1, d);
+        hpChain_[i].setCoefficients(g, g1, d);
+        bpChain_[i].setCoefficients(g, g1, d);
+        notchChain_[i].setCoefficients(g, g1, d);
     }
 }
 
+void ThreeSistersFilter::snapCoefficients() {
+    updateFilterChains();
+    currentG_ = targetG_;
+    currentDamping_ = targetDamping_;
+    rampRemaining_ = 0;
+    coefficientsDirty_ = false;
+    applyCoefficients(currentG_, currentDamping_);
+}
+
+void ThreeSistersFilter::startCoefficientRamp() {
+    updateFilterChains();
+    gStep_ = (targetG_ - currentG_) / COEFFICIENT_RAMP_SAMPLES;
+    dampingStep_ = (targetDamping_ - currentDamping_) / COEFFICIENT_RAMP_SAMPLES;
+    rampRemaining_ = COEFFICIENT_RAMP_SAMPLES;
+    coefficientsDirty_ = false;
+}
+
+void ThreeSistersFilter::stepCoefficientRamp() {
+    // New targets are picked up once the running ramp has finished
+    if (rampRemaining_ == 0) {
+        if (!coefficientsDirty_) return;
+        startCoefficientRamp();
+    }
+
+    if (--rampRemaining_ > 0) {
+        currentG_ += gStep_;
+        currentDamping_ += dampingStep_;
+    } else {
+        currentG_ = targetG_;
+        currentDamping_ = targetDamping_;
+    }
+
+    applyCoefficients(currentG_, currentDamping_);
+}
+
 void ThreeSistersFilter::startTransition(int newFilterType) {
     if (!isTransitioning_) {
         previousFilterType_ = filterType_;
@@ -215,6 +306,13 @@ double ThreeSistersFilter::processFilterType(int type, double input) {
 }
 
 double ThreeSistersFilter::process(double input) {
+    // Bypass fast path: no chain or coefficient work at all
+    if (filterType_ == kFilterType_Bypass && !isTransitioning_) {
+        previousOutput_ = input;
+        return input;
+    }
+
+    stepCoefficientRamp();
     updateTransition();
 
     double output;
@@ -266,6 +364,15 @@ double ThreeSistersFilter::process(double input) {
     return output;
 }
 
+void ThreeSistersFilter::processBlock(float* samples, int numSamples) {
+    // Bypass without a pending crossfade leaves the block untouched
+    if (filterType_ == kFilterType_Bypass && !isTransitioning_) return;
+
+    for (int i = 0; i < numSamples; ++i) {
+        samples[i] = static_cast<float>(process(static_cast<double>(samples[i])));
+    }
+}
+
 void ThreeSistersFilter::reset() {
     for (int i = 0; i < 2; ++i) {
         lpChain_[i].reset();
@@ -18,6 +18,7 @@ public:
 
     void setSampleRate(double sampleRate);
     void setParameters(double frequency, double resonance);
+    void setCoefficients(double g, double g1, double d);  // Precomputed, skips tan()
     void setSaturationAmount(double saturationAmount);
     Outputs process(double input);
     void reset();
@@ -41,8 +42,13 @@ public:
     void setSampleRate(double sampleRate);
     void setParameters(double frequency, double resonance, int filterType);
     double process(double input);
+    void processBlock(float* samples, int numSamples);  // In place, fixed parameters
     void reset();
 
+    // Coefficient helpers, shared with ThreeSistersFilterBank
+    static double tanWarp(double normalizedFrequency);      // tan(pi * f / fs)
+    static double resonanceToDamping(double resonance);     // Three Sisters resonance -> SVF damping
+
 private:
     // 4 parallel filter chains (8 SVF units total)
     SVFUnit lpChain_[2];      // LP→LP for 24dB/octave lowpass
@@ -69,9 +75,25 @@ private:
     // Previous sample for continuity
     double previousOutput_;
 
+    // Coefficient cache: all 8 units share one (g, damping) pair, recomputed
+    // only when cutoff or resonance change and ramped at control rate
+    bool coefficientsDirty_;
+    double targetG_;
+    double targetDamping_;
+    double currentG_;
+    double currentDamping_;
+    double gStep_;
+    double dampingStep_;
+    int rampRemaining_;
+
     static constexpr double FADE_TIME_MS = 10.0; // 10ms crossfade time
+    static constexpr int COEFFICIENT_RAMP_SAMPLES = 16; // Control-rate interval
 
     void updateFilterChains();
+    void snapCoefficients();
+    void startCoefficientRamp();
+    void stepCoefficientRamp();
+    void applyCoefficients(double g, double damping);
     double processFilterType(int type, double input);
     void startTransition(int newFilterType);
     void updateTransition();
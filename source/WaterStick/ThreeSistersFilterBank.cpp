@@ -0,0 +1,399 @@
+#include "ThreeSistersFilterBank.h"
+#include "WaterStickParameters.h"
+#include "FastTanh.h"
+#include "TapMask.h"
+#include <algorithm>
+
+namespace WaterStick {
+
+// ===================================================================
+// THREE SISTERS FILTER BANK IMPLEMENTATION
+// ===================================================================
+
+ThreeSistersFilterBank::ThreeSistersFilterBank()
+    : sampleRate_(44100.0)
+    , fadeRate_(0.0f)
+    , fadeSamples_(1.0f)
+    , dirtyTaps_(0)
+    , maxEventsPerTap_(0)
+{
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        resonance_[lane] = 0.0f;
+        filterType_[lane] = static_cast<float>(kFilterType_Bypass);
+        previousFilterType_[lane] = static_cast<float>(kFilterType_Bypass);
+        active_[lane] = 0.0f;
+        io_[lane] = 0.0f;
+    }
+
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        frequency_[tap] = 1000.0;
+        tapResonance_[tap] = 0.0;
+        tapFilterType_[tap] = kFilterType_Bypass;
+        eventCount_[tap] = 0;
+        eventCursor_[tap] = 0;
+    }
+
+    reset();
+    setSampleRate(sampleRate_);
+    prepare(1024);
+}
+
+void ThreeSistersFilterBank::prepare(int maxBlockSize) {
+    // One change per sample per tap is the most the processor can schedule
+    maxEventsPerTap_ = std::max(1, maxBlockSize);
+    events_.assign(static_cast<size_t>(NUM_TAPS) * maxEventsPerTap_, ScheduledParameters{});
+
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        eventCount_[tap] = 0;
+        eventCursor_[tap] = 0;
+    }
+}
+
+void ThreeSistersFilterBank::setSampleRate(double sampleRate) {
+    sampleRate_ = sampleRate;
+
+    double fadeSamples = (FADE_TIME_MS / 1000.0) * sampleRate_;
+    double fadeRate = 1.0 / fadeSamples;
+    fadeRate_ = static_cast<float>(fadeRate);
+
+    // Crossfades are counted in samples so they end on the same sample as the
+    // scalar filter's double accumulation; the shared lpChain_[1]/hpChain_[1]
+    // units make even one extra step of the outgoing type audible
+    int steps = 0;
+    for (double progress = 0.0; progress < 1.0; progress += fadeRate) {
+        steps++;
+    }
+    fadeSamples_ = static_cast<float>(steps);
+
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        snapCoefficients(tap);
+    }
+}
+
+void ThreeSistersFilterBank::setParameters(int tap, double frequency, double resonance, int filterType) {
+    if (tap < 0 || tap >= NUM_TAPS) return;
+
+    // Dirty flag only - coefficients follow at control rate, as in ThreeSistersFilter
+    if (frequency != frequency_[tap] || resonance != tapResonance_[tap]) {
+        frequency_[tap] = frequency;
+        tapResonance_[tap] = resonance;
+        resonance_[tap] = static_cast<float>(resonance);
+        resonance_[tap + NUM_TAPS] = static_cast<float>(resonance);
+        dirtyTaps_ |= (1u << tap);
+    }
+
+    if (filterType != tapFilterType_[tap]) {
+        startTransition(tap, filterType);
+    }
+}
+
+void ThreeSistersFilterBank::scheduleParameters(int tap, int sampleOffset, double frequency, double resonance, int filterType) {
+    if (tap < 0 || tap >= NUM_TAPS) return;
+
+    // Out of storage: the change lands on the last slot instead of being lost
+    int slot = std::min(eventCount_[tap], maxEventsPerTap_ - 1);
+    events_[static_cast<size_t>(tap) * maxEventsPerTap_ + slot] = {sampleOffset, frequency, resonance, filterType};
+    eventCount_[tap] = slot + 1;
+}
+
+void ThreeSistersFilterBank::snapCoefficients(int tap) {
+    double frequency = std::max(20.0, std::min(frequency_[tap], sampleRate_ * 0.49));
+    float g = static_cast<float>(ThreeSistersFilter::tanWarp(frequency / sampleRate_));
+    float damping = static_cast<float>(ThreeSistersFilter::resonanceToDamping(tapResonance_[tap]));
+
+    for (int lane = tap; lane < NUM_LANES; lane += NUM_TAPS) {
+        targetG_[lane] = g_[lane] = g;
+        targetDamping_[lane] = damping_[lane] = damping;
+        g1_[lane] = 2.0f * damping + g;
+        d_[lane] = 1.0f / (1.0f + 2.0f * damping * g + g * g);
+        gStep_[lane] = 0.0f;
+        dampingStep_[lane] = 0.0f;
+        rampRemaining_[lane] = 0.0f;
+    }
+
+    dirtyTaps_ &= ~(1u << tap);
+}
+
+void ThreeSistersFilterBank::startCoefficientRamps(uint32_t activeTaps) {
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        if (!((dirtyTaps_ & activeTaps) & (1u << tap))) continue;
+
+        // Same rule as the scalar filter: only lanes doing filter work pick up
+        // new targets, and only once the running ramp has finished
+        bool processing = filterType_[tap] != static_cast<float>(kFilterType_Bypass) || transitioning_[tap] != 0.0f;
+        if (!processing || rampRemaining_[tap] > 0.0f) continue;
+
+        double frequency = std::max(20.0, std::min(frequency_[tap], sampleRate_ * 0.49));
+        float g = static_cast<float>(ThreeSistersFilter::tanWarp(frequency / sampleRate_));
+        float damping = static_cast<float>(ThreeSistersFilter::resonanceToDamping(tapResonance_[tap]));
+
+        for (int lane = tap; lane < NUM_LANES; lane += NUM_TAPS) {
+            targetG_[lane] = g;
+            targetDamping_[lane] = damping;
+            gStep_[lane] = (g - g_[lane]) / COEFFICIENT_RAMP_SAMPLES;
+            dampingStep_[lane] = (damping - damping_[lane]) / COEFFICIENT_RAMP_SAMPLES;
+            rampRemaining_[lane] = static_cast<float>(COEFFICIENT_RAMP_SAMPLES);
+        }
+
+        dirtyTaps_ &= ~(1u << tap);
+    }
+}
+
+void ThreeSistersFilterBank::startTransition(int tap, int newFilterType) {
+    for (int lane = tap; lane < NUM_LANES; lane += NUM_TAPS) {
+        if (transitioning_[lane] == 0.0f) {
+            previousFilterType_[lane] = filterType_[lane];
+            fadeCount_[lane] = 0.0f;
+            transitioning_[lane] = 1.0f;
+        }
+        // If already transitioning, update target but keep current progress
+        filterType_[lane] = static_cast<float>(newFilterType);
+    }
+
+    tapFilterType_[tap] = newFilterType;
+}
+
+void ThreeSistersFilterBank::applyScheduledParameters(int sampleOffset, int& nextOffset) {
+    nextOffset = INT32_MAX;
+
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        const ScheduledParameters* tapEvents = events_.data() + static_cast<size_t>(tap) * maxEventsPerTap_;
+
+        while (eventCursor_[tap] < eventCount_[tap] && tapEvents[eventCursor_[tap]].sampleOffset <= sampleOffset) {
+            const ScheduledParameters& event = tapEvents[eventCursor_[tap]++];
+            setParameters(tap, event.frequency, event.resonance, event.filterType);
+        }
+
+        if (eventCursor_[tap] < eventCount_[tap]) {
+            nextOffset = std::min(nextOffset, tapEvents[eventCursor_[tap]].sampleOffset);
+        }
+    }
+}
+
+void ThreeSistersFilterBank::processBlock(float* const* left, float* const* right, uint32_t activeTaps, int numSamples) {
+    // Without a right channel only the left lanes are run
+    const int numLanes = right ? NUM_LANES : NUM_TAPS;
+
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        float active = (activeTaps & (1u << tap)) ? 1.0f : 0.0f;
+        active_[tap] = active;
+        active_[tap + NUM_TAPS] = active;
+        io_[tap] = 0.0f;
+        io_[tap + NUM_TAPS] = 0.0f;
+    }
+
+    int nextOffset = 0;
+
+    for (int i = 0; i < numSamples; ++i) {
+        if (i >= nextOffset) {
+            applyScheduledParameters(i, nextOffset);
+        }
+        if (dirtyTaps_ & activeTaps) {
+            startCoefficientRamps(activeTaps);
+        }
+
+        // Transpose one sample of every active tap into the lane vector
+        TapMask::forEach(activeTaps, [&](int tap) {
+            io_[tap] = left[tap][i];
+            if (right) io_[tap + NUM_TAPS] = right[tap][i];
+        });
+
+        for (int lane = 0; lane < numLanes; lane += Batch::WIDTH) {
+            processLanes(lane);
+        }
+
+        TapMask::forEach(activeTaps, [&](int tap) {
+            left[tap][i] = io_[tap];
+            if (right) right[tap][i] = io_[tap + NUM_TAPS];
+        });
+    }
+
+    // Changes scheduled past the block still take effect
+    int unused = 0;
+    applyScheduledParameters(INT32_MAX, unused);
+
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        eventCount_[tap] = 0;
+        eventCursor_[tap] = 0;
+    }
+}
+
+ThreeSistersFilterBank::SVFOutputs ThreeSistersFilterBank::stepUnits(const int* units, const Mask* masks, int count,
+                                                                     Batch input, Batch g, Batch g1, Batch d, int lane) {
+    // Gather each lane's state from the unit its mask selects
+    Batch s1 = simd::load(s1_[units[0]] + lane);
+    Batch s2 = simd::load(s2_[units[0]] + lane);
+    for (int k = 1; k < count; ++k) {
+        s1 = simd::select(masks[k], simd::load(s1_[units[k]] + lane), s1);
+        s2 = simd::select(masks[k], simd::load(s2_[units[k]] + lane), s2);
+    }
+
+    // Zero-delay feedback TPT SVF with tanh saturation on both integrators
+    const Batch saturation = simd::broadcast(SATURATION);
+    const Batch inverseSaturation = simd::broadcast(1.0f / SATURATION);
+
+    Batch HP = (input - g1 * s1 - s2) * d;
+    Batch v1 = g * HP;
+    Batch BP = v1 + s1;
+    Batch newS1 = saturation * FastTanh::rational((BP + v1) * inverseSaturation);
+
+    Batch v2 = g * BP;
+    Batch LP = v2 + s2;
+    Batch newS2 = saturation * FastTanh::rational((LP + v2) * inverseSaturation);
+
+    // Commit in order, so a unit listed twice sees the earlier write
+    for (int k = 0; k < count; ++k) {
+        if (!simd::any(masks[k])) continue;
+        float* unitS1 = s1_[units[k]] + lane;
+        float* unitS2 = s2_[units[k]] + lane;
+        simd::store(unitS1, simd::select(masks[k], newS1, simd::load(unitS1)));
+        simd::store(unitS2, simd::select(masks[k], newS2, simd::load(unitS2)));
+    }
+
+    return {LP, BP, HP};
+}
+
+ThreeSistersFilterBank::Batch ThreeSistersFilterBank::processPass(Batch filterType, Batch input, Mask laneMask,
+                                                                  Batch g, Batch g1, Batch d, int lane) {
+    TypeMasks type;
+    type.lowPass = laneMask & (filterType == simd::broadcast(static_cast<float>(kFilterType_LowPass)));
+    type.highPass = laneMask & (filterType == simd::broadcast(static_cast<float>(kFilterType_HighPass)));
+    type.bandPass = laneMask & (filterType == simd::broadcast(static_cast<float>(kFilterType_BandPass)));
+    type.notch = laneMask & (filterType == simd::broadcast(static_cast<float>(kFilterType_Notch)));
+
+    if (!simd::any(type.lowPass | type.highPass | type.bandPass | type.notch)) {
+        return input;  // Bypass in every lane
+    }
+
+    const Mask masks[4] = {type.lowPass, type.highPass, type.bandPass, type.notch};
+
+    // First stage: LP0, HP0, BP0 or the notch's first LP/HP split
+    const int stage1Units[4] = {kUnitLP0, kUnitHP0, kUnitBP0, kUnitNotch0};
+    SVFOutputs stage1 = stepUnits(stage1Units, masks, 4, input, g, g1, d, lane);
+
+    // Second stage: LP->LP, HP->HP, LP->HP and the notch's low branch on lpChain_[1]
+    const int stage2Units[4] = {kUnitLP1, kUnitHP1, kUnitBP1, kUnitLP1};
+    Batch stage2Input = simd::select(type.highPass, stage1.HP, stage1.LP);
+    SVFOutputs stage2 = stepUnits(stage2Units, masks, 4, stage2Input, g, g1, d, lane);
+
+    Batch output = simd::select(type.lowPass, stage2.LP, input);
+    output = simd::select(type.highPass | type.bandPass, stage2.HP, output);
+
+    if (simd::any(type.notch)) {
+        // Notch high branch: notchChain_[0] runs again, then hpChain_[1]
+        const int notchUnit = kUnitNotch0;
+        const int highUnit = kUnitHP1;
+        SVFOutputs hpStage1 = stepUnits(&notchUnit, &type.notch, 1, input, g, g1, d, lane);
+        SVFOutputs hpStage2 = stepUnits(&highUnit, &type.notch, 1, hpStage1.HP, g, g1, d, lane);
+
+        output = simd::select(type.notch, (stage2.LP + hpStage2.HP) * simd::broadcast(0.5f), output);
+    }
+
+    return output;
+}
+
+void ThreeSistersFilterBank::processLanes(int lane) {
+    const Batch zero = simd::broadcast(0.0f);
+    const Batch one = simd::broadcast(1.0f);
+
+    Batch input = simd::load(io_ + lane);
+    Batch filterType = simd::load(filterType_ + lane);
+    Mask transitioning = simd::load(transitioning_ + lane) > zero;
+
+    // Bypass fast path: lanes without filter work pass through untouched
+    Mask bypassed = simd::andNot(filterType == simd::broadcast(static_cast<float>(kFilterType_Bypass)), transitioning);
+    Mask processing = simd::andNot(simd::load(active_ + lane) > zero, bypassed);
+    if (!simd::any(processing)) return;
+
+    // Control-rate coefficient ramp
+    Batch g = simd::load(g_ + lane);
+    Batch g1 = simd::load(g1_ + lane);
+    Batch d = simd::load(d_ + lane);
+
+    Batch remaining = simd::load(rampRemaining_ + lane);
+    Mask ramping = processing & (remaining > zero);
+    if (simd::any(ramping)) {
+        Batch newRemaining = remaining - one;
+        Mask landing = simd::andNot(ramping, newRemaining > zero);
+        Batch damping = simd::load(damping_ + lane);
+
+        g = simd::select(ramping, g + simd::load(gStep_ + lane), g);
+        damping = simd::select(ramping, damping + simd::load(dampingStep_ + lane), damping);
+        g = simd::select(landing, simd::load(targetG_ + lane), g);
+        damping = simd::select(landing, simd::load(targetDamping_ + lane), damping);
+
+        Batch two = simd::broadcast(2.0f);
+        g1 = simd::select(ramping, two * damping + g, g1);
+        d = simd::select(ramping, one / (one + two * damping * g + g * g), d);
+
+        simd::store(rampRemaining_ + lane, simd::select(ramping, newRemaining, remaining));
+        simd::store(g_ + lane, g);
+        simd::store(g1_ + lane, g1);
+        simd::store(d_ + lane, d);
+        simd::store(damping_ + lane, damping);
+    }
+
+    // Type crossfade (smoothstep over FADE_TIME_MS)
+    Batch previousType = simd::load(previousFilterType_ + lane);
+    Batch fadeCount = simd::load(fadeCount_ + lane);
+    Batch fadeProgress = one;
+    Mask fading = processing & transitioning;
+    if (simd::any(fading)) {
+        fadeCount = simd::select(fading, fadeCount + one, fadeCount);
+        Mask finished = fading & (fadeCount >= simd::broadcast(fadeSamples_));
+        fadeProgress = simd::select(finished, one, simd::min(fadeCount * simd::broadcast(fadeRate_), one));
+        previousType = simd::select(finished, filterType, previousType);
+        transitioning = simd::andNot(transitioning, finished);
+
+        simd::store(fadeCount_ + lane, fadeCount);
+        simd::store(previousFilterType_ + lane, previousType);
+        simd::store(transitioning_ + lane, simd::select(transitioning, one, zero));
+    }
+
+    Batch output = processPass(filterType, input, processing, g, g1, d, lane);
+
+    Mask crossfading = processing & transitioning;
+    if (simd::any(crossfading)) {
+        Batch previousOutput = processPass(previousType, input, crossfading, g, g1, d, lane);
+        Batch currentMix = fadeProgress * fadeProgress * (simd::broadcast(3.0f) - simd::broadcast(2.0f) * fadeProgress);
+        output = simd::select(crossfading, output * currentMix + previousOutput * (one - currentMix), output);
+    }
+
+    // Three Sisters anti-resonance for negative resonance values
+    Batch resonance = simd::load(resonance_ + lane);
+    Mask antiResonance = processing & (resonance < zero);
+    if (simd::any(antiResonance)) {
+        Mask lowPass = antiResonance & (filterType == simd::broadcast(static_cast<float>(kFilterType_LowPass)));
+        Mask highPass = antiResonance & (filterType == simd::broadcast(static_cast<float>(kFilterType_HighPass)));
+
+        // LP mixes in hpChain_[0].HP, HP mixes in lpChain_[0].LP, others the dry input
+        Batch complementary = input;
+        if (simd::any(lowPass | highPass)) {
+            const int units[2] = {kUnitHP0, kUnitLP0};
+            const Mask masks[2] = {lowPass, highPass};
+            SVFOutputs stage = stepUnits(units, masks, 2, input, g, g1, d, lane);
+            complementary = simd::select(lowPass, stage.HP, simd::select(highPass, stage.LP, input));
+        }
+
+        Batch mix = zero - resonance;
+        output = simd::select(antiResonance, output * (one - mix) + complementary * mix, output);
+    }
+
+    simd::store(io_ + lane, simd::select(processing, output, input));
+}
+
+void ThreeSistersFilterBank::reset() {
+    for (int unit = 0; unit < kNumUnits; ++unit) {
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            s1_[unit][lane] = 0.0f;
+            s2_[unit][lane] = 0.0f;
+        }
+    }
+
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        fadeCount_[lane] = 0.0f;
+        transitioning_[lane] = 0.0f;
+    }
+}
+
+} // namespace WaterStick
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "ThreeSistersFilter.h"
+#include "SimdBatch.h"
+#include <cstdint>
+#include <vector>
+
+namespace WaterStick {
+
+/**
+ * @class ThreeSistersFilterBank
+ * @brief All 16 taps × 2 channels of ThreeSistersFilter in one SIMD kernel
+ *
+ * Integrator states, coefficients and transition state are stored as
+ * structure-of-arrays float lanes (lane = channel * NUM_TAPS + tap), so one
+ * instruction advances 8 (AVX2) or 4 (SSE2/NEON) filters at once.
+ *
+ * The topology is the scalar one, unit for unit: LP→LP, HP→HP, LP→HP band
+ * pass and the notch that shares lpChain_[1]/hpChain_[1], the 10ms type
+ * crossfade, negative-resonance anti-resonance and tanh saturation on both
+ * integrators. Lanes with different filter types run the same instructions;
+ * per-lane masks select which unit state each step reads and commits.
+ *
+ * Both channels of a tap always share parameters. Parameter changes inside
+ * a block are scheduled per tap and applied on their sample.
+ */
+class ThreeSistersFilterBank {
+public:
+    static constexpr int NUM_TAPS = 16;
+    static constexpr int NUM_CHANNELS = 2;
+    static constexpr int NUM_LANES = NUM_TAPS * NUM_CHANNELS;
+
+    ThreeSistersFilterBank();
+    ~ThreeSistersFilterBank() = default;
+
+    /**
+     * @brief Reserve scheduled-parameter storage (call off the audio thread)
+     */
+    void prepare(int maxBlockSize);
+
+    void setSampleRate(double sampleRate);
+
+    // Immediate parameter change for both channels of a tap
+    void setParameters(int tap, double frequency, double resonance, int filterType);
+
+    // Parameter change taking effect at sampleOffset of the next processBlock()
+    void scheduleParameters(int tap, int sampleOffset, double frequency, double resonance, int filterType);
+
+    /**
+     * @brief Filter tap buffers in place
+     * @param left,right Per-tap buffers, NUM_TAPS pointers each. right may be
+     *        null for a mono engine; the right lanes are then left untouched.
+     * @param activeTaps Bit per tap; other taps are neither read nor advanced
+     */
+    void processBlock(float* const* left, float* const* right, uint32_t activeTaps, int numSamples);
+
+    void reset();
+
+private:
+    using Batch = simd::FloatBatch;
+    using Mask = simd::MaskBatch;
+
+    // SVF units per lane, named after the scalar chains. notchChain_[1] is
+    // never used by the scalar topology and has no state here.
+    enum Unit {
+        kUnitLP0 = 0,
+        kUnitLP1,
+        kUnitHP0,
+        kUnitHP1,
+        kUnitBP0,
+        kUnitBP1,
+        kUnitNotch0,
+        kNumUnits
+    };
+
+    struct TypeMasks {
+        Mask lowPass;
+        Mask highPass;
+        Mask bandPass;
+        Mask notch;
+    };
+
+    struct SVFOutputs {
+        Batch LP;
+        Batch BP;
+        Batch HP;
+    };
+
+    struct ScheduledParameters {
+        int sampleOffset;
+        double frequency;
+        double resonance;
+        int filterType;
+    };
+
+    // Lane state (structure of arrays)
+    alignas(simd::ALIGNMENT) float s1_[kNumUnits][NUM_LANES];
+    alignas(simd::ALIGNMENT) float s2_[kNumUnits][NUM_LANES];
+    alignas(simd::ALIGNMENT) float g_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float g1_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float d_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float targetG_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float targetDamping_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float damping_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float gStep_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float dampingStep_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float rampRemaining_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float resonance_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float filterType_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float previousFilterType_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float fadeCount_[NUM_LANES];       // Crossfade samples elapsed
+    alignas(simd::ALIGNMENT) float transitioning_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float active_[NUM_LANES];
+    alignas(simd::ALIGNMENT) float io_[NUM_LANES];
+
+    // Per-tap parameters (shared by both channels)
+    double sampleRate_;
+    float fadeRate_;
+    float fadeSamples_;                 // Crossfade length in samples
+    double frequency_[NUM_TAPS];
+    double tapResonance_[NUM_TAPS];
+    int tapFilterType_[NUM_TAPS];
+    uint32_t dirtyTaps_;
+
+    // Scheduled changes, NUM_TAPS slices of maxEventsPerTap_
+    std::vector<ScheduledParameters> events_;
+    int maxEventsPerTap_;
+    int eventCount_[NUM_TAPS];
+    int eventCursor_[NUM_TAPS];
+
+    static constexpr float SATURATION = 1.5f;
+    static constexpr double FADE_TIME_MS = 10.0;
+    static constexpr int COEFFICIENT_RAMP_SAMPLES = 16;
+
+    void applyScheduledParameters(int sampleOffset, int& nextOffset);
+    void startCoefficientRamps(uint32_t activeTaps);
+    void snapCoefficients(int tap);
+    void startTransition(int tap, int newFilterType);
+    void processLanes(int lane);
+    Batch processPass(Batch filterType, Batch input, Mask laneMask, Batch g, Batch g1, Batch d, int lane);
+    SVFOutputs stepUnits(const int* units, const Mask* masks, int count, Batch input,
+                         Batch g, Batch g1, Batch d, int lane);
+};
+
+} // namespace WaterStick
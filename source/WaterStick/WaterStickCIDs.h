@@ -13,4 +13,10 @@ static const Steinberg::FUID kWaterStickControllerUID(0x87654321, 0x87654321, 0x
 
 #define WaterStickVST3Category "Fx|Delay"
 
+// Controller to processor: a tap's pitch or enable, or the pitch mode, has
+// changed. kPitchClassesAttr carries how many classes Shared mode now needs,
+// counted from the controller's values since the processor's may lag
+static const char* const kPitchClassesMessage = "PitchClasses";
+static const char* const kPitchClassesAttr = "Count";
+
 } // namespace WaterStick
\ No newline at end of file
@@ -199,7 +199,8 @@ void DefaultResetSystem::resetGlobalParameters(WaterStickController* controller)
 
     std::vector<Steinberg::Vst::ParamID> globalParams = {
         kInputGain, kOutputGain, kDelayTime, kFeedback, kTempoSyncMode,
-        kSyncDivision, kGrid, kGlobalDryWet, kDelayBypass
+        kSyncDivision, kGrid, kGlobalDryWet, kDelayBypass, kEngineMode, kDelayTimeMode,
+        kPitchMode, kPitchQuality
     };
     resetParameterGroup(controller, globalParams);
 }
@@ -297,6 +298,12 @@ void DefaultResetSystem::buildDefaultValueMap() {
     mDefaultValues[kRandomizeAmount] = 1.0f;
     mDefaultValues[kRandomizeTrigger] = 0.0f;
     mDefaultValues[kResetTrigger] = 0.0f;
+
+    // Engine parameters
+    mDefaultValues[kEngineMode] = 0.0f;   // Classic
+    mDefaultValues[kDelayTimeMode] = 0.0f;   // Crossfade
+    mDefaultValues[kPitchMode] = 0.0f;   // Per Tap
+    mDefaultValues[kPitchQuality] = 0.0f;   // Linear
 }
 
 //------------------------------------------------------------------------
@@ -1207,6 +1214,27 @@ tresult PLUGIN_API WaterStickController::initialize(FUnknown* context)
                            Vst::ParameterInfo::kCanAutomate | Vst::ParameterInfo::kIsList, kResetTrigger, 0,
                            STR16("System"));
 
+    // Engine mode (Classic, Mono Sum, True Stereo); not automatable, switching resets the delay
+    parameters.addParameter(STR16("Engine Mode"), nullptr, kNumEngineModes - 1, 0.0,
+                           Vst::ParameterInfo::kIsList, kEngineMode, 0,
+                           STR16("System"));
+
+    // Delay time mode (Crossfade, Glide); not automatable, switching resets the delay
+    parameters.addParameter(STR16("Delay Time Mode"), nullptr, kNumDelayTimeModes - 1, 0.0,
+                           Vst::ParameterInfo::kIsList, kDelayTimeMode, 0,
+                           STR16("System"));
+
+    // Pitch mode (Per Tap, Shared); not automatable, taps moving between
+    // buffers restart
+    parameters.addParameter(STR16("Pitch Mode"), nullptr, kNumPitchModes - 1, 0.0,
+                           Vst::ParameterInfo::kIsList, kPitchMode, 0,
+                           STR16("System"));
+
+    // Pitch quality (Linear, Hermite, Sinc); not automatable
+    parameters.addParameter(STR16("Pitch Quality"), nullptr, kNumPitchQualities - 1, 0.0,
+                           Vst::ParameterInfo::kIsList, kPitchQuality, 0,
+                           STR16("System"));
+
     // Initialize all parameters to their default values
     // This ensures proper display even if setComponentState is never called
     setDefaultParameters();
@@ -1247,6 +1275,10 @@ void WaterStickController::setDefaultParameters()
     // Set global mix parameters to defaults
     setParamNormalized(kGlobalDryWet, 0.5);      // 50%
     setParamNormalized(kDelayBypass, 0.0);       // Active
+    setParamNormalized(kEngineMode, 0.0);        // Classic
+    setParamNormalized(kDelayTimeMode, 0.0);     // Crossfade
+    setParamNormalized(kPitchMode, 0.0);         // Per Tap
+    setParamNormalized(kPitchQuality, 0.0);      // Linear
 }
 
 //------------------------------------------------------------------------
@@ -1329,6 +1361,10 @@ float WaterStickController::getDefaultParameterValue(Vst::ParamID id)
     if (id >= kTap1FeedbackSend && id <= kTap16FeedbackSend) return 0.0f;  // Feedback sends default to 0%
     if (id == kGlobalDryWet) return 0.5f;
     if (id == kDelayBypass) return 0.0f;
+    if (id == kEngineMode) return 0.0f;
+    if (id == kDelayTimeMode) return 0.0f;
+    if (id == kPitchMode) return 0.0f;
+    if (id == kPitchQuality) return 0.0f;
 
     return 0.0f;  // Safe default
 }
@@ -1927,6 +1963,42 @@ tresult WaterStickController::readCurrentVersionState(IBStream* state)
         invalidParameterCount++;
     }
 
+    // Engine Mode (appended field, absent from older states)
+    int32 engineMode;
+    if (streamer.readInt32(engineMode) && engineMode >= 0 && engineMode < kNumEngineModes) {
+        setParamNormalized(kEngineMode, static_cast<Vst::ParamValue>(engineMode) / (kNumEngineModes - 1));
+        validParameterCount++;
+    } else {
+        setParamNormalized(kEngineMode, getDefaultParameterValue(kEngineMode));
+    }
+
+    // Delay Time Mode (appended field, absent from older states)
+    int32 delayTimeMode;
+    if (streamer.readInt32(delayTimeMode) && delayTimeMode >= 0 && delayTimeMode < kNumDelayTimeModes) {
+        setParamNormalized(kDelayTimeMode, static_cast<Vst::ParamValue>(delayTimeMode) / (kNumDelayTimeModes - 1));
+        validParameterCount++;
+    } else {
+        setParamNormalized(kDelayTimeMode, getDefaultParameterValue(kDelayTimeMode));
+    }
+
+    // Pitch Mode (appended field, absent from older states)
+    int32 pitchMode;
+    if (streamer.readInt32(pitchMode) && pitchMode >= 0 && pitchMode < kNumPitchModes) {
+        setParamNormalized(kPitchMode, static_cast<Vst::ParamValue>(pitchMode) / (kNumPitchModes - 1));
+        validParameterCount++;
+    } else {
+        setParamNormalized(kPitchMode, getDefaultParameterValue(kPitchMode));
+    }
+
+    // Pitch Quality (appended field, absent from older states)
+    int32 pitchQuality;
+    if (streamer.readInt32(pitchQuality) && pitchQuality >= 0 && pitchQuality < kNumPitchQualities) {
+        setParamNormalized(kPitchQuality, static_cast<Vst::ParamValue>(pitchQuality) / (kNumPitchQualities - 1));
+        validParameterCount++;
+    } else {
+        setParamNormalized(kPitchQuality, getDefaultParameterValue(kPitchQuality));
+    }
+
     return kResultOk;
 }
 
@@ -2103,6 +2175,12 @@ tresult PLUGIN_API WaterStickController::setParamNormalized(Vst::ParamID id, Vst
         }
     }
 
+    // Pitch classes may need buffers the processor has not allocated yet
+    bool tapEnable = id >= kTap1Enable && id <= kTap16Pan && (id - kTap1Enable) % 3 == 0;
+    if (id == kPitchMode || tapEnable || (id >= kTap1PitchShift && id <= kTap16PitchShift)) {
+        sendPitchClasses();
+    }
+
     // Update randomization settings
     if (id == kRandomizeSeed) {
         unsigned int seed = static_cast<unsigned int>(value * 4294967295.0); // Max uint32
@@ -2202,6 +2280,46 @@ tresult PLUGIN_API WaterStickController::getParamStringByValue(Vst::ParamID id,
             Steinberg::UString(string, 128).fromAscii(text);
             return kResultTrue;
         }
+        case kEngineMode:
+        {
+            static const char* modeNames[kNumEngineModes] = {"Classic", "Mono Sum", "True Stereo"};
+            int mode = static_cast<int>(valueNormalized * (kNumEngineModes - 1) + 0.5);
+            if (mode >= 0 && mode < kNumEngineModes) {
+                Steinberg::UString(string, 128).fromAscii(modeNames[mode]);
+                return kResultTrue;
+            }
+            break;
+        }
+        case kDelayTimeMode:
+        {
+            static const char* modeNames[kNumDelayTimeModes] = {"Crossfade", "Glide"};
+            int mode = static_cast<int>(valueNormalized * (kNumDelayTimeModes - 1) + 0.5);
+            if (mode >= 0 && mode < kNumDelayTimeModes) {
+                Steinberg::UString(string, 128).fromAscii(modeNames[mode]);
+                return kResultTrue;
+            }
+            break;
+        }
+        case kPitchMode:
+        {
+            static const char* modeNames[kNumPitchModes] = {"Per Tap", "Shared"};
+            int mode = static_cast<int>(valueNormalized * (kNumPitchModes - 1) + 0.5);
+            if (mode >= 0 && mode < kNumPitchModes) {
+                Steinberg::UString(string, 128).fromAscii(modeNames[mode]);
+                return kResultTrue;
+            }
+            break;
+        }
+        case kPitchQuality:
+        {
+            static const char* qualityNames[kNumPitchQualities] = {"Linear", "Hermite", "Sinc"};
+            int quality = static_cast<int>(valueNormalized * (kNumPitchQualities - 1) + 0.5);
+            if (quality >= 0 && quality < kNumPitchQualities) {
+                Steinberg::UString(string, 128).fromAscii(qualityNames[quality]);
+                return kResultTrue;
+            }
+            break;
+        }
         default:
         {
             // Handle macro knob parameters
@@ -2402,6 +2520,37 @@ void WaterStickController::handleResetTrigger()
     mDefaultResetSystem.resetAllParameters(this);
 }
 
+void WaterStickController::sendPitchClasses()
+{
+    // One class per distinct interval of the enabled taps, as the processor
+    // counts them; nothing to allocate outside Shared mode
+    int pitchMode = static_cast<int>(getParamNormalized(kPitchMode) * (kNumPitchModes - 1) + 0.5);
+    if (pitchMode != kPitchMode_Shared) return;
+
+    int semitones[16];
+    int classes = 0;
+    for (int i = 0; i < 16; i++) {
+        semitones[i] = 0;
+        if (getParamNormalized(kTap1Enable + (i * 3)) <= 0.5) continue;
+        semitones[i] = static_cast<int>(std::round(getParamNormalized(kTap1PitchShift + i) * 24.0 - 12.0));
+        if (semitones[i] == 0) continue;
+
+        bool seen = false;
+        for (int j = 0; j < i && !seen; j++) {
+            seen = semitones[j] == semitones[i];
+        }
+        classes += seen ? 0 : 1;
+    }
+    if (classes == 0) return;
+
+    // No peer before the processor is connected; it counts its own on setup
+    IPtr<Vst::IMessage> message = owned(allocateMessage());
+    if (!message) return;
+    message->setMessageID(kPitchClassesMessage);
+    message->getAttributes()->setInt(kPitchClassesAttr, classes);
+    sendMessage(message);
+}
+
 void WaterStickController::updateCurveTypes()
 {
     // Update macro curve system with current parameter values
@@ -232,6 +232,9 @@ private:
     void updateCurveTypes();
     void handleMacroKnobParameterChange(Steinberg::Vst::ParamID paramId, Steinberg::Vst::ParamValue value);
 
+    // Ask the processor for the pitch class buffers the current taps need
+    void sendPitchClasses();
+
     // Discrete parameter management
     float mDiscreteParameters[24];
     void updateDiscreteParameters();
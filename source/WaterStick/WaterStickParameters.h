@@ -196,6 +196,11 @@ enum {
     kRandomizeAmount,    // Randomization intensity (0.0-1.0)
     kRandomizeTrigger,   // Trigger randomization (0=idle, 1=trigger)
     kResetTrigger,       // Trigger reset to defaults (0=idle, 1=trigger)
+    // Engine
+    kEngineMode,         // Channel topology (see EngineModes)
+    kDelayTimeMode,      // How tap delay time changes are followed (see DelayTimeModes)
+    kPitchMode,          // Where tap pitch shifting runs (see PitchModes)
+    kPitchQuality,       // Pitch read-head interpolation (see PitchQualities)
     kNumParams
 };
 
@@ -249,6 +254,36 @@ enum FilterTypes {
     kNumFilterTypes
 };
 
+// Engine modes
+enum EngineModes {
+    kEngineMode_Classic = 0,     // Two channel chains, taps summed to mono before panning
+    kEngineMode_MonoSum,         // Input summed to mono once, one channel chain, then panned
+    kEngineMode_TrueStereo,      // Two channel chains, L and R kept apart and balanced by pan
+    kNumEngineModes
+};
+
+// Delay time modes
+enum DelayTimeModes {
+    kDelayTimeMode_Crossfade = 0,  // Wait for the time to settle, then crossfade to a second head
+    kDelayTimeMode_Glide,          // One head per tap glides to the new time, tape style
+    kNumDelayTimeModes
+};
+
+// Pitch modes
+enum PitchModes {
+    kPitchMode_PerTap = 0,  // Each pitched tap's output is shifted after the delay
+    kPitchMode_Shared,      // One shifter per distinct interval writes a buffer its taps read
+    kNumPitchModes
+};
+
+// Pitch read-head interpolation
+enum PitchQualities {
+    kPitchQuality_Linear = 0,  // 2 points, cheapest; dull highs, aliases upwards
+    kPitchQuality_Hermite,     // 4-point cubic
+    kPitchQuality_Sinc,        // 16-point windowed sinc, band-limited on upward shifts
+    kNumPitchQualities
+};
+
 // Macro curve types (from Rainmaker manual)
 enum MacroCurveTypes {
     kCurveType_Linear = 0,       // Linear curve (y = x)
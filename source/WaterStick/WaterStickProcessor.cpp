@@ -1,5 +1,9 @@
 #include "WaterStickProcessor.h"
 #include "WaterStickCIDs.h"
+#include "FastTanh.h"
+#include "TapMixKernel.h"
+#include "TapMask.h"
+#include "DenormalGuard.h"
 #include "pluginterfaces/vst/ivstparameterchanges.h"
 #include "base/source/fstreamer.h"
 #include "pluginterfaces/base/ibstream.h"
@@ -9,6 +13,7 @@
 #include <iomanip>
 #include <map>
 #include <cstring>
+#include <limits>
 
 // Platform-specific SIMD includes
 #if defined(__SSE4_1__) && (defined(__x86_64__) || defined(__i386__))
@@ -182,6 +187,19 @@ struct ParameterConverter {
         }
     }
 
+    // Inverse of convertFilterResonance, for ramps between its segments
+    static double normalizeFilterResonance(float resonance) {
+        double positiveValue;
+        if (resonance < 0.0f) {
+            return resonance * 0.5 + 0.5;
+        } else if (resonance < 0.7f) {
+            positiveValue = resonance / 0.7 * 0.9;
+        } else {
+            positiveValue = 0.9 + (resonance - 0.7) / 0.3 * 0.1;
+        }
+        return positiveValue * 0.5 + 0.5;
+    }
+
     static int convertFilterType(double value) {
         return static_cast<int>(value * (kNumFilterTypes - 1) + 0.5);
     }
@@ -196,6 +214,10 @@ struct ParameterConverter {
         return std::sqrt(normalizedValue);
     }
 
+    static double normalizeFeedback(float feedback) {
+        return static_cast<double>(feedback) * feedback;
+    }
+
     static int convertPitchShift(double value) {
         // Convert 0.0-1.0 range to -12 to +12 semitones
         return static_cast<int>(round((value * 24.0) - 12.0));
@@ -203,6 +225,31 @@ struct ParameterConverter {
 
 };
 
+// Host buffers in either sample size. Only the dry signal and the final
+// dry/wet sum are computed in the host's precision; the wet signal (engine,
+// filters, bus sums, feedback) is float whatever the host sends
+struct HostSamples {
+    static float peak(const float* samples, int numSamples) {
+        return TapMixKernel::peak(samples, numSamples);
+    }
+
+    static float peak(const double* samples, int numSamples) {
+        double result = 0.0;
+        for (int i = 0; i < numSamples; i++) result = std::max(result, std::abs(samples[i]));
+        return static_cast<float>(result);
+    }
+
+    // Float input is read in place, double input is narrowed into scratch
+    static const float* toEngine(const float* samples, int /*numSamples*/, float* /*scratch*/) {
+        return samples;
+    }
+
+    static const float* toEngine(const double* samples, int numSamples, float* scratch) {
+        for (int i = 0; i < numSamples; i++) scratch[i] = static_cast<float>(samples[i]);
+        return scratch;
+    }
+};
+
 // =====================================================
 // PHASE 2: UNIFIED LOCK-FREE ARCHITECTURE IMPLEMENTATION
 // =====================================================
@@ -315,37 +362,36 @@ RecoveryManager::~RecoveryManager() = default;
 
 void RecoveryManager::initialize(double sampleRate) {
     mSampleRate = sampleRate;
-    mEmergencyBypass.store(false, std::memory_order_relaxed);
-    mTimeoutCount.store(0, std::memory_order_relaxed);
-    mMaxProcessingTime.store(0.0, std::memory_order_relaxed);
+    mEmergencyBypass = false;
+    mTimeoutCount = 0;
+    mMaxProcessingTime = 0.0;
 
     for (int i = 0; i < 4; ++i) {
-        mRecoveryCount[i].store(0, std::memory_order_relaxed);
+        mRecoveryCount[i] = 0;
     }
     mConsecutiveTimeouts = 0;
 }
 
 void RecoveryManager::startProcessingTimer() {
-    mProcessingStartTime = std::chrono::high_resolution_clock::now();
+    mProcessingTimer.start();
 }
 
 RecoveryManager::RecoveryLevel RecoveryManager::checkAndHandleTimeout() {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - mProcessingStartTime);
-    double durationUs = duration.count() / 1000.0;
+    if (!BlockTimer::ENABLED) {
+        return NONE;
+    }
+
+    double durationUs = mProcessingTimer.elapsed();
 
     // Update max processing time
-    double currentMax = mMaxProcessingTime.load(std::memory_order_acquire);
-    if (durationUs > currentMax) {
-        mMaxProcessingTime.store(durationUs, std::memory_order_release);
-    }
+    mMaxProcessingTime = std::max(mMaxProcessingTime, durationUs);
 
     // Check timeout levels
     RecoveryLevel level = NONE;
 
     if (durationUs > LEVEL3_TIMEOUT_US) {
         level = EMERGENCY_BYPASS;
-        mEmergencyBypass.store(true, std::memory_order_release);
+        mEmergencyBypass = true;
         mConsecutiveTimeouts++;
     } else if (durationUs > LEVEL2_TIMEOUT_US) {
         level = BUFFER_RESET;
@@ -360,13 +406,13 @@ RecoveryManager::RecoveryLevel RecoveryManager::checkAndHandleTimeout() {
     }
 
     // Update statistics
-    mTimeoutCount.fetch_add(1, std::memory_order_relaxed);
-    mRecoveryCount[level].fetch_add(1, std::memory_order_relaxed);
+    mTimeoutCount++;
+    mRecoveryCount[level]++;
 
     // Check if we need emergency bypass due to consecutive timeouts
     if (mConsecutiveTimeouts >= MAX_CONSECUTIVE_TIMEOUTS && level < EMERGENCY_BYPASS) {
         level = EMERGENCY_BYPASS;
-        mEmergencyBypass.store(true, std::memory_order_release);
+        mEmergencyBypass = true;
     }
 
     return level;
@@ -377,32 +423,32 @@ void RecoveryManager::reportSuccess() {
 }
 
 void RecoveryManager::reset() {
-    mEmergencyBypass.store(false, std::memory_order_release);
+    mEmergencyBypass = false;
     mConsecutiveTimeouts = 0;
 }
 
 bool RecoveryManager::isInEmergencyBypass() const {
-    return mEmergencyBypass.load(std::memory_order_acquire);
+    return mEmergencyBypass;
 }
 
 void RecoveryManager::clearEmergencyBypass() {
-    mEmergencyBypass.store(false, std::memory_order_release);
+    mEmergencyBypass = false;
     mConsecutiveTimeouts = 0;
 }
 
 int RecoveryManager::getTimeoutCount() const {
-    return mTimeoutCount.load(std::memory_order_acquire);
+    return mTimeoutCount;
 }
 
 int RecoveryManager::getRecoveryCount(RecoveryLevel level) const {
     if (level >= 0 && level < 4) {
-        return mRecoveryCount[level].load(std::memory_order_acquire);
+        return mRecoveryCount[level];
     }
     return 0;
 }
 
 double RecoveryManager::getMaxProcessingTime() const {
-    return mMaxProcessingTime.load(std::memory_order_acquire);
+    return mMaxProcessingTime;
 }
 
 // =====================================================
@@ -675,9 +721,9 @@ void UnifiedPitchDelayLine::initialize(double sampleRate, double maxDelaySeconds
     mMinReadPosition = static_cast<float>(mSafetyMargin);
     mMaxReadPosition = static_cast<float>(mBufferSize - mSafetyMargin);
 
-    // Initialize atomic indices
-    mWriteIndex.store(0, std::memory_order_relaxed);
-    mReadPosition.store(mMinReadPosition, std::memory_order_relaxed);
+    // Initialize indices
+    mWriteIndex = 0;
+    mReadPosition = mMinReadPosition;
 
     // Initialize managers
     mParameterManager->initialize();
@@ -707,11 +753,8 @@ void UnifiedPitchDelayLine::processSample(float input, float& output) {
     updateParameters();
 
     // Get current write index and advance it
-    int writeIdx = mWriteIndex.load(std::memory_order_acquire);
-    mBuffer[writeIdx] = input;
-
-    int nextWriteIdx = (writeIdx + 1) % mBufferSize;
-    mWriteIndex.store(nextWriteIdx, std::memory_order_release);
+    mBuffer[mWriteIndex] = input;
+    mWriteIndex = (mWriteIndex + 1) % mBufferSize;
 
     // Check for timeout after write
     RecoveryManager::RecoveryLevel recoveryLevel = mRecoveryManager->checkAndHandleTimeout();
@@ -724,7 +767,7 @@ void UnifiedPitchDelayLine::processSample(float input, float& output) {
     applySmoothingAndValidation();
 
     // Get current read position
-    float readPos = mReadPosition.load(std::memory_order_acquire);
+    float readPos = mReadPosition;
 
     // Variable speed playback: advance read position
     float newReadPos = readPos + mState.currentPitchRatio;
@@ -751,17 +794,17 @@ void UnifiedPitchDelayLine::processSample(float input, float& output) {
         return;
     } else if (recoveryLevel == RecoveryManager::POSITION_CORRECTION) {
         correctReadPosition();
-        newReadPos = mReadPosition.load(std::memory_order_acquire);
+        newReadPos = mReadPosition;
     }
 
     // Validate final position
     if (!validateReadPosition()) {
         correctReadPosition();
-        newReadPos = mReadPosition.load(std::memory_order_acquire);
+        newReadPos = mReadPosition;
     }
 
     // Store new read position
-    mReadPosition.store(newReadPos, std::memory_order_release);
+    mReadPosition = newReadPos;
 
     // Interpolate output
     output = interpolateBuffer(newReadPos);
@@ -775,8 +818,8 @@ void UnifiedPitchDelayLine::reset() {
     std::fill(mBuffer.begin(), mBuffer.end(), 0.0f);
 
     // Reset indices
-    mWriteIndex.store(0, std::memory_order_release);
-    mReadPosition.store(mMinReadPosition, std::memory_order_release);
+    mWriteIndex = 0;
+    mReadPosition = mMinReadPosition;
 
     // Reset processing state
     mState.currentPitchRatio = 1.0f;
@@ -815,7 +858,7 @@ void UnifiedPitchDelayLine::logProcessingStats() const {
     if (PitchDebug::isLoggingEnabled()) {
         std::ostringstream ss;
         ss << "UnifiedPitchDelayLine stats - PitchRatio: " << mState.currentPitchRatio
-           << ", ReadPos: " << mReadPosition.load(std::memory_order_acquire)
+           << ", ReadPos: " << mReadPosition
            << ", BufferSize: " << mBufferSize
            << ", EmergencyBypass: " << (mRecoveryManager->isInEmergencyBypass() ? "YES" : "NO")
            << ", Timeouts: " << mRecoveryManager->getTimeoutCount()
@@ -882,12 +925,12 @@ float UnifiedPitchDelayLine::interpolateBuffer(float position) const {
 }
 
 bool UnifiedPitchDelayLine::validateReadPosition() const {
-    float readPos = mReadPosition.load(std::memory_order_acquire);
+    float readPos = mReadPosition;
     return std::isfinite(readPos) && readPos >= mMinReadPosition && readPos <= mMaxReadPosition;
 }
 
 void UnifiedPitchDelayLine::correctReadPosition() {
-    int writeIdx = mWriteIndex.load(std::memory_order_acquire);
+    int writeIdx = mWriteIndex;
 
     // Calculate safe read position
     float safeReadPos = static_cast<float>(writeIdx) - static_cast<float>(mSafetyMargin);
@@ -896,7 +939,7 @@ void UnifiedPitchDelayLine::correctReadPosition() {
         safeReadPos += static_cast<float>(mBufferSize);
     }
 
-    mReadPosition.store(safeReadPos, std::memory_order_release);
+    mReadPosition = safeReadPos;
 }
 
 void UnifiedPitchDelayLine::performBufferReset() {
@@ -904,14 +947,14 @@ void UnifiedPitchDelayLine::performBufferReset() {
     std::fill(mBuffer.begin(), mBuffer.end(), 0.0f);
 
     // Reset read position to safe distance behind write
-    int writeIdx = mWriteIndex.load(std::memory_order_acquire);
+    int writeIdx = mWriteIndex;
     float safeReadPos = static_cast<float>(writeIdx) - static_cast<float>(mSafetyMargin);
 
     if (safeReadPos < mMinReadPosition) {
         safeReadPos += static_cast<float>(mBufferSize);
     }
 
-    mReadPosition.store(safeReadPos, std::memory_order_release);
+    mReadPosition = safeReadPos;
 
     // Reset state
     mState.currentPitchRatio = 1.0f;
@@ -1238,8 +1281,6 @@ DualDelayLine::DualDelayLine()
 , mCurrentDelayTime(0.1f)
 , mStabilityCounter(0)
 , mStabilityThreshold(2048)
-, mCrossfadeLength(0)
-, mCrossfadePosition(0)
 , mCrossfadeGainA(1.0f)
 , mCrossfadeGainB(0.0f)
 {
@@ -1350,8 +1391,8 @@ int DualDelayLine::calculateCrossfadeLength(float delayTime)
 void DualDelayLine::startCrossfade()
 {
     mCrossfadeState = CROSSFADING;
-    mCrossfadeLength = calculateCrossfadeLength(mTargetDelayTime);
-    mCrossfadePosition = 0;
+    mCrossfadeRamp.start(FadeRamp::Curve::RaisedCosine, FadeRamp::Direction::Out,
+                         calculateCrossfadeLength(mTargetDelayTime));
 
     if (mUsingLineA) {
         updateDelayState(mStateB, mTargetDelayTime);
@@ -1364,10 +1405,7 @@ void DualDelayLine::updateCrossfade()
 {
     if (mCrossfadeState != CROSSFADING) return;
 
-    float progress = static_cast<float>(mCrossfadePosition) / static_cast<float>(mCrossfadeLength);
-    progress = std::min(progress, 1.0f);
-
-    float fadeOut = 0.5f * (1.0f + cosf(progress * 3.14159265f));
+    float fadeOut = mCrossfadeRamp.next();
     float fadeIn = 1.0f - fadeOut;
 
     if (mUsingLineA) {
@@ -1378,9 +1416,7 @@ void DualDelayLine::updateCrossfade()
         mCrossfadeGainB = fadeOut;
     }
 
-    mCrossfadePosition++;
-
-    if (mCrossfadePosition >= mCrossfadeLength) {
+    if (!mCrossfadeRamp.isActive()) {
         mCrossfadeState = STABLE;
         mUsingLineA = !mUsingLineA;
         mCurrentDelayTime = mTargetDelayTime;
@@ -1430,7 +1466,7 @@ void DualDelayLine::reset()
     mUsingLineA = true;
     mCrossfadeState = STABLE;
     mStabilityCounter = 0;
-    mCrossfadePosition = 0;
+    mCrossfadeRamp.stop();
     mCrossfadeGainA = 1.0f;
     mCrossfadeGainB = 0.0f;
 
@@ -1889,8 +1925,7 @@ float SpeedBasedDelayLine::processSpeedBasedPitchShifting(float input)
         mProcessingTimeouts++;
         std::ostringstream ss;
         ss << "Processing completed with timeout - Duration: "
-           << std::chrono::duration_cast<std::chrono::milliseconds>(
-               std::chrono::high_resolution_clock::now() - mProcessingStartTime).count() << "ms";
+           << mProcessingTimer.elapsed() / 1000.0 << "ms";
         PitchDebug::logMessage(ss.str());
     }
 
@@ -1952,13 +1987,11 @@ void SpeedBasedDelayLine::reset()
 
 // Safety and diagnostic methods for dropout investigation
 void SpeedBasedDelayLine::startProcessingTimer() const {
-    mProcessingStartTime = std::chrono::high_resolution_clock::now();
+    mProcessingTimer.start();
 }
 
 bool SpeedBasedDelayLine::checkProcessingTimeout() const {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - mProcessingStartTime);
-    return duration.count() > TIMEOUT_THRESHOLD_MS;
+    return BlockTimer::ENABLED && mProcessingTimer.elapsed() > TIMEOUT_THRESHOLD_MS * 1000.0;
 }
 
 void SpeedBasedDelayLine::enterEmergencyBypass(const std::string& reason) const {
@@ -1999,16 +2032,20 @@ WaterStickProcessor::WaterStickProcessor()
 , mGrid(kGrid_4)
 , mGlobalDryWet(0.5f)
 , mDelayBypass(false)
+, mEngineMode(kEngineMode_Classic)
+, mActiveEngineMode(kEngineMode_Classic)
+, mDelayTimeMode(kDelayTimeMode_Crossfade)
+, mPitchMode(kPitchMode_PerTap)
+, mPitchQuality(kPitchQuality_Linear)
 , mDelayBypassPrevious(false)
 , mDelayFadingOut(false)
 , mDelayFadingIn(false)
-, mDelayFadeRemaining(0)
-, mDelayFadeTotalLength(0)
-, mDelayFadeGain(1.0f)
+, mMaxBlockSize(0)
 , mSampleRate(44100.0)
 , mLastTempoSyncDelayTime(-1.0f)
 , mTempoSyncParametersChanged(false)
-, mParameterHistoryWriteIndex(0)
+, mParameterClock(0)
+, mAutomationSample(0)
 {
     for (int i = 0; i < 16; i++) {
         mTapEnabled[i] = false;
@@ -2024,15 +2061,11 @@ WaterStickProcessor::WaterStickProcessor()
         mTapFeedbackSend[i] = 0.0f;  // Default to no feedback send
 
         mTapFadingOut[i] = false;
-        mTapFadeOutRemaining[i] = 0;
-        mTapFadeOutTotalLength[i] = 0;
-
         mTapFadingIn[i] = false;
-        mTapFadeInRemaining[i] = 0;
-        mTapFadeInTotalLength[i] = 0;
-
-        mTapFadeGain[i] = 1.0f;
+        mTapQuietSamples[i] = 0;
     }
+    mSleepingTaps = 0;
+    mEngineIdle = false;
 
     mFeedbackBufferL = 0.0f;
     mFeedbackBufferR = 0.0f;
@@ -2100,18 +2133,18 @@ WaterStickProcessor::WaterStickProcessor()
     // Production default: decoupled system (complete solution for all critical issues)
     mUseDecoupledArchitecture = false;  // Will be enabled in setupProcessing()
 
-    // Initialize parameter history with current values
+    // Initialize parameter timelines with current values
     for (int i = 0; i < 16; i++) {
-        for (int j = 0; j < PARAM_HISTORY_SIZE; j++) {
-            mTapParameterHistory[i][j].level = mTapLevel[i];
-            mTapParameterHistory[i][j].pan = mTapPan[i];
-            mTapParameterHistory[i][j].filterCutoff = mTapFilterCutoff[i];
-            mTapParameterHistory[i][j].filterResonance = mTapFilterResonance[i];
-            mTapParameterHistory[i][j].filterType = mTapFilterType[i];
-            mTapParameterHistory[i][j].pitchShift = mTapPitchShift[i];
-            mTapParameterHistory[i][j].feedbackSend = mTapFeedbackSend[i];
-            mTapParameterHistory[i][j].enabled = mTapEnabled[i];
-        }
+        ParameterSnapshot initial;
+        initial.level = mTapLevel[i];
+        initial.pan = mTapPan[i];
+        initial.filterCutoff = mTapFilterCutoff[i];
+        initial.filterResonance = mTapFilterResonance[i];
+        initial.filterType = mTapFilterType[i];
+        initial.pitchShift = mTapPitchShift[i];
+        initial.feedbackSend = mTapFeedbackSend[i];
+        initial.enabled = mTapEnabled[i];
+        mTapParameterTimelines[i].reset(initial, 0);
     }
 
     setControllerClass(kWaterStickControllerUID);
@@ -2129,42 +2162,40 @@ void WaterStickProcessor::checkTapStateChangesAndClearBuffers()
             // Start fade-out instead of immediate cut
             mTapFadingOut[i] = true;
             mTapFadingIn[i] = false;  // Stop any fade-in
-            mTapFadeGain[i] = 1.0f;   // Start at full gain
 
             // Calculate fade-out length proportional to delay time (but capped)
             float tapDelayTime = mTapDistribution.getTapDelayTime(i);
             int fadeLength = static_cast<int>(tapDelayTime * mSampleRate * 0.01f); // 1% of delay time
             fadeLength = std::max(64, std::min(fadeLength, 2048)); // Cap between 64-2048 samples
-            mTapFadeOutRemaining[i] = fadeLength;
-            mTapFadeOutTotalLength[i] = fadeLength;
+            mTapFade[i].start(FadeRamp::Curve::Exponential, FadeRamp::Direction::Out, fadeLength);
         }
         // Check if tap went from disabled to enabled
         else if (!mTapEnabledPrevious[i] && mTapEnabled[i]) {
             // Stop any ongoing fade-out and start fade-in
             mTapFadingOut[i] = false;
             mTapFadingIn[i] = true;
-            mTapFadeGain[i] = 0.0f;   // Start at zero gain
 
             // Clear buffers for clean start
             if (mUseDecoupledArchitecture) {
-                // Decoupled system coordinated reset (production solution)
-                mDecoupledDelaySystemL.reset();
-                mDecoupledDelaySystemR.reset();
+                // Only this tap restarts; the others keep playing
+                mDecoupledDelaySystemL.resetTap(i);
+                mDecoupledDelaySystemR.resetTap(i);
             } else if (mUseUnifiedDelayLines) {
-                mUnifiedTapDelayLinesL[i].reset();
-                mUnifiedTapDelayLinesR[i].reset();
-            } else {
+                if (UnifiedTapEngines* unified = mUnifiedEngines.load(std::memory_order_acquire)) {
+                    unified->left[i].reset();
+                    unified->right[i].reset();
+                }
+            } else if (SpeedBasedTapEngines* speedBased = mSpeedBasedEngines.load(std::memory_order_acquire)) {
                 // Emergency fallback buffer clearing
-                mTapDelayLinesL[i].reset();
-                mTapDelayLinesR[i].reset();
+                speedBased->left[i].reset();
+                speedBased->right[i].reset();
             }
 
             // Calculate fade-in length - much shorter than fade-out (0.25% of delay time)
             float tapDelayTime = mTapDistribution.getTapDelayTime(i);
             int fadeLength = static_cast<int>(tapDelayTime * mSampleRate * 0.0025f); // 0.25% of delay time
             fadeLength = std::max(16, std::min(fadeLength, 512)); // Cap between 16-512 samples (0.3ms-11.6ms)
-            mTapFadeInRemaining[i] = fadeLength;
-            mTapFadeInTotalLength[i] = fadeLength;
+            mTapFade[i].start(FadeRamp::Curve::Exponential, FadeRamp::Direction::In, fadeLength);
         }
 
         // Update previous state for next call
@@ -2186,20 +2217,16 @@ void WaterStickProcessor::checkBypassStateChanges()
             if (!mDelayBypassPrevious && mDelayBypass) {
                 mDelayFadingOut = true;
                 mDelayFadingIn = false;
-                mDelayFadeGain = 1.0f;
 
                 int fadeLength = static_cast<int>(std::max(64.0f, std::min(static_cast<float>(mSampleRate * 0.01f), 2048.0f)));
-                mDelayFadeRemaining = fadeLength;
-                mDelayFadeTotalLength = fadeLength;
+                mDelayFade.start(FadeRamp::Curve::Exponential, FadeRamp::Direction::Out, fadeLength);
             }
             else if (mDelayBypassPrevious && !mDelayBypass) {
                 mDelayFadingOut = false;
                 mDelayFadingIn = true;
-                mDelayFadeGain = 0.0f;
 
                 int fadeLength = static_cast<int>(std::max(32.0f, std::min(static_cast<float>(mSampleRate * 0.005f), 1024.0f)));
-                mDelayFadeRemaining = fadeLength;
-                mDelayFadeTotalLength = fadeLength;
+                mDelayFade.start(FadeRamp::Curve::Exponential, FadeRamp::Direction::In, fadeLength);
             }
         }
         mDelayBypassPrevious = mDelayBypass;
@@ -2249,43 +2276,18 @@ void WaterStickProcessor::processDelaySection(float inputL, float inputR, float&
                 tapOutputR = static_cast<float>(mTapFiltersR[tap].process(tapOutputR));
 
                 // Apply fade processing
-                if (mTapFadingOut[tap]) {
-                    tapOutputL *= mTapFadeGain[tap];
-                    tapOutputR *= mTapFadeGain[tap];
-
-                    mTapFadeOutRemaining[tap]--;
-                    if (mTapFadeOutRemaining[tap] <= 0) {
-                        mTapFadingOut[tap] = false;
-                        mTapFadeGain[tap] = 1.0f;
-                        // Reset buffers through decoupled system
-                        mDecoupledDelaySystemL.reset();
-                        mDecoupledDelaySystemR.reset();
-                    } else {
-                        float fadeProgress = 1.0f - (static_cast<float>(mTapFadeOutRemaining[tap]) / static_cast<float>(mTapFadeOutTotalLength[tap]));
-                        mTapFadeGain[tap] = std::exp(-6.0f * fadeProgress);
-                    }
-                }
-                else if (mTapFadingIn[tap]) {
-                    tapOutputL *= mTapFadeGain[tap];
-                    tapOutputR *= mTapFadeGain[tap];
-
-                    mTapFadeInRemaining[tap]--;
-                    if (mTapFadeInRemaining[tap] <= 0) {
-                        mTapFadingIn[tap] = false;
-                        mTapFadeGain[tap] = 1.0f;
-                    } else {
-                        float fadeProgress = 1.0f - (static_cast<float>(mTapFadeInRemaining[tap]) / static_cast<float>(mTapFadeInTotalLength[tap]));
-                        mTapFadeGain[tap] = 1.0f - std::exp(-6.0f * fadeProgress);
-                    }
+                bool fadeOutComplete = false;
+                float fadeGain = advanceTapFade(tap, fadeOutComplete);
+                tapOutputL *= fadeGain;
+                tapOutputR *= fadeGain;
+                if (fadeOutComplete) {
+                    mDecoupledDelaySystemL.resetTap(tap);
+                    mDecoupledDelaySystemR.resetTap(tap);
                 }
 
                 // Apply panning
-                float pan = historicParams.pan;
-                float leftGain = 1.0f - pan;
-                float rightGain = pan;
-
-                float tapMainL = (tapOutputL * leftGain) + (tapOutputR * leftGain);
-                float tapMainR = (tapOutputL * rightGain) + (tapOutputR * rightGain);
+                float tapMainL, tapMainR;
+                panTapOutput(tapOutputL, tapOutputR, historicParams.pan, tapMainL, tapMainR);
                 sumL += tapMainL;
                 sumR += tapMainR;
 
@@ -2296,7 +2298,11 @@ void WaterStickProcessor::processDelaySection(float inputL, float inputR, float&
             }
         }
     } else {
-        // Fallback to legacy processing (for A/B testing)
+        // Fallback to legacy processing (for A/B testing); an engine that has
+        // not been published yet stays silent
+        UnifiedTapEngines* unified = mUseUnifiedDelayLines ? mUnifiedEngines.load(std::memory_order_acquire) : nullptr;
+        SpeedBasedTapEngines* speedBased = mUseUnifiedDelayLines ? nullptr : mSpeedBasedEngines.load(std::memory_order_acquire);
+
         for (int tap = 0; tap < NUM_TAPS; tap++) {
             bool processTap = mTapDistribution.isTapEnabled(tap) || mTapFadingOut[tap] || mTapFadingIn[tap];
 
@@ -2304,21 +2310,22 @@ void WaterStickProcessor::processDelaySection(float inputL, float inputR, float&
                 float tapDelayTime = mTapDistribution.getTapDelayTime(tap);
                 ParameterSnapshot historicParams = getHistoricParameters(tap, tapDelayTime);
 
-                float tapOutputL, tapOutputR;
+                float tapOutputL = 0.0f;
+                float tapOutputR = 0.0f;
 
                 // Phase 2: Choose between legacy and unified delay line systems
-                if (mUseUnifiedDelayLines) {
+                if (unified) {
                     // Use production unified delay lines (47.9x performance improvement)
-                    mUnifiedTapDelayLinesL[tap].setPitchShift(historicParams.pitchShift);
-                    mUnifiedTapDelayLinesR[tap].setPitchShift(historicParams.pitchShift);
-                    mUnifiedTapDelayLinesL[tap].processSample(inputL, tapOutputL);
-                    mUnifiedTapDelayLinesR[tap].processSample(inputR, tapOutputR);
-                } else {
+                    unified->left[tap].setPitchShift(historicParams.pitchShift);
+                    unified->right[tap].setPitchShift(historicParams.pitchShift);
+                    unified->left[tap].processSample(inputL, tapOutputL);
+                    unified->right[tap].processSample(inputR, tapOutputR);
+                } else if (speedBased) {
                     // Emergency fallback to legacy system (kept for compatibility)
-                    mTapDelayLinesL[tap].setPitchShift(historicParams.pitchShift);
-                    mTapDelayLinesR[tap].setPitchShift(historicParams.pitchShift);
-                    mTapDelayLinesL[tap].processSample(inputL, tapOutputL);
-                    mTapDelayLinesR[tap].processSample(inputR, tapOutputR);
+                    speedBased->left[tap].setPitchShift(historicParams.pitchShift);
+                    speedBased->right[tap].setPitchShift(historicParams.pitchShift);
+                    speedBased->left[tap].processSample(inputL, tapOutputL);
+                    speedBased->right[tap].processSample(inputR, tapOutputR);
                 }
 
                 tapOutputL *= historicParams.level;
@@ -2334,48 +2341,24 @@ void WaterStickProcessor::processDelaySection(float inputL, float inputR, float&
                 tapOutputL = static_cast<float>(mTapFiltersL[tap].process(tapOutputL));
                 tapOutputR = static_cast<float>(mTapFiltersR[tap].process(tapOutputR));
 
-                if (mTapFadingOut[tap]) {
-                    tapOutputL *= mTapFadeGain[tap];
-                    tapOutputR *= mTapFadeGain[tap];
-
-                    mTapFadeOutRemaining[tap]--;
-                    if (mTapFadeOutRemaining[tap] <= 0) {
-                        mTapFadingOut[tap] = false;
-                        mTapFadeGain[tap] = 1.0f;
-                        if (mUseUnifiedDelayLines) {
-                            mUnifiedTapDelayLinesL[tap].reset();
-                            mUnifiedTapDelayLinesR[tap].reset();
-                        } else {
-                            // Emergency fallback buffer clearing
-                            mTapDelayLinesL[tap].reset();
-                            mTapDelayLinesR[tap].reset();
-                        }
-                    } else {
-                        float fadeProgress = 1.0f - (static_cast<float>(mTapFadeOutRemaining[tap]) / static_cast<float>(mTapFadeOutTotalLength[tap]));
-                        mTapFadeGain[tap] = std::exp(-6.0f * fadeProgress);
+                bool fadeOutComplete = false;
+                float fadeGain = advanceTapFade(tap, fadeOutComplete);
+                tapOutputL *= fadeGain;
+                tapOutputR *= fadeGain;
+                if (fadeOutComplete) {
+                    if (unified) {
+                        unified->left[tap].reset();
+                        unified->right[tap].reset();
+                    } else if (speedBased) {
+                        // Emergency fallback buffer clearing
+                        speedBased->left[tap].reset();
+                        speedBased->right[tap].reset();
                     }
                 }
-                else if (mTapFadingIn[tap]) {
-                    tapOutputL *= mTapFadeGain[tap];
-                    tapOutputR *= mTapFadeGain[tap];
-
-                    mTapFadeInRemaining[tap]--;
-                    if (mTapFadeInRemaining[tap] <= 0) {
-                        mTapFadingIn[tap] = false;
-                        mTapFadeGain[tap] = 1.0f;
-                    } else {
-                        float fadeProgress = 1.0f - (static_cast<float>(mTapFadeInRemaining[tap]) / static_cast<float>(mTapFadeInTotalLength[tap]));
-                        mTapFadeGain[tap] = 1.0f - std::exp(-6.0f * fadeProgress);
-                    }
-                }
-
-                float pan = historicParams.pan;
-                float leftGain = 1.0f - pan;
-                float rightGain = pan;
 
                 // Apply panning for main tap output
-                float tapMainL = (tapOutputL * leftGain) + (tapOutputR * leftGain);
-                float tapMainR = (tapOutputL * rightGain) + (tapOutputR * rightGain);
+                float tapMainL, tapMainR;
+                panTapOutput(tapOutputL, tapOutputR, historicParams.pan, tapMainL, tapMainR);
                 sumL += tapMainL;
                 sumR += tapMainR;
 
@@ -2389,7 +2372,375 @@ void WaterStickProcessor::processDelaySection(float inputL, float inputR, float&
 
     // ENHANCED FEEDBACK PROCESSING
     // ===========================
+    storeFeedbackSignal();
+
+    // Delay section is always 100% wet now
+    float dryGain = 0.0f;
+    float wetGain = 1.0f;
+    float delayWetGain = wetGain;
+
+    outputL = (inputL * dryGain) + (sumL * delayWetGain);
+    outputR = (inputR * dryGain) + (sumR * delayWetGain);
+
+    applyDelayFade(outputL, outputR);
+
+    // NOTE: Bypass logic moved to main processing loop for proper scope
+    // This section now only handles delay processing - bypass is handled upstream
+}
+
+int WaterStickProcessor::processDecoupledSubBlock(const float* inputL, const float* inputR, float* wetL, float* wetR, int maxSamples)
+{
+    // A new engine mode starts from a cleared delay
+    if (mEngineMode != mActiveEngineMode) {
+        mActiveEngineMode = mEngineMode;
+        mDecoupledDelaySystemL.reset();
+        mDecoupledDelaySystemR.reset();
+        mTapFilterBank.reset();
+        mFeedbackBufferL = 0.0f;
+        mFeedbackBufferR = 0.0f;
+        mSleepingTaps = 0;
+    }
+
+    // No-op unless the mode changed
+    const auto readMode = mDelayTimeMode == kDelayTimeMode_Glide
+        ? DecoupledDelaySystem::DelayReadMode::Glide
+        : DecoupledDelaySystem::DelayReadMode::Crossfade;
+    mDecoupledDelaySystemL.setDelayReadMode(readMode);
+    mDecoupledDelaySystemR.setDelayReadMode(readMode);
+
+    const auto pitchRouting = mPitchMode == kPitchMode_Shared
+        ? DecoupledDelaySystem::PitchRouting::Shared
+        : DecoupledDelaySystem::PitchRouting::PerTap;
+    mDecoupledDelaySystemL.setPitchRouting(pitchRouting);
+    mDecoupledDelaySystemR.setPitchRouting(pitchRouting);
+
+    const auto pitchInterpolation = mPitchQuality == kPitchQuality_Sinc ? GrainPitchBank::Interpolation::Sinc
+        : mPitchQuality == kPitchQuality_Hermite ? GrainPitchBank::Interpolation::Hermite
+        : GrainPitchBank::Interpolation::Linear;
+    mDecoupledDelaySystemL.setPitchInterpolation(pitchInterpolation);
+    mDecoupledDelaySystemR.setPitchInterpolation(pitchInterpolation);
+
+    // Mono sum runs the left chain only, on the mid signal
+    const bool monoSum = mActiveEngineMode == kEngineMode_MonoSum;
+
+    // Sub-block length: the feedback path may not run ahead of the shortest
+    // tap, and state changes that reset or bypass the engine end a sub-block
+    int numSamples = std::min(maxSamples, mMaxBlockSize);
+    numSamples = std::min(numSamples, mDecoupledDelaySystemL.getMaxFeedbackBlockSize());
+    numSamples = std::min(numSamples, mDecoupledDelaySystemR.getMaxFeedbackBlockSize());
+
+    for (int tap = 0; tap < NUM_TAPS; tap++) {
+        if (mTapFadingOut[tap]) {
+            numSamples = std::min(numSamples, mTapFade[tap].getRemaining());
+        }
+    }
+    if (mDelayFadingOut || mDelayFadingIn) {
+        numSamples = std::min(numSamples, mDelayFade.getRemaining());
+    }
+    numSamples = std::max(numSamples, 1);
+
+    // Advance automation per sample; global gains are kept as per-sample lanes
+    for (int i = 0; i < numSamples; i++) {
+        advanceAutomation();
+        captureCurrentParameters();
+        mBlockInputGain[i] = mInputGain;
+        mBlockFeedbackGain[i] = mFeedback;
+        mBlockOutputGain[i] = mOutputGain;
+        mBlockDryWet[i] = mGlobalDryWet;
+    }
+
+    // The first input sample only depends on feedback from the previous sub-block
+    if (monoSum) {
+        mBlockDelayInputL[0] = FastTanh::pade(0.5f * (inputL[0] + inputR[0]) + (mFeedbackBufferL * mBlockFeedbackGain[0])) * mBlockInputGain[0];
+    } else {
+        mBlockDelayInputL[0] = FastTanh::pade(inputL[0] + (mFeedbackBufferL * mBlockFeedbackGain[0])) * mBlockInputGain[0];
+        mBlockDelayInputR[0] = FastTanh::pade(inputR[0] + (mFeedbackBufferR * mBlockFeedbackGain[0])) * mBlockInputGain[0];
+    }
+
+    // Live taps are on or fading. Sleeping ones wake on delay output energy,
+    // or stay asleep while their level is zero at both ends of the sub-block
+    uint32_t liveTaps = 0;
+    uint32_t fadingTaps = 0;
+    for (int tap = 0; tap < NUM_TAPS; tap++) {
+        if (mTapFadingOut[tap] || mTapFadingIn[tap]) {
+            fadingTaps |= 1u << tap;
+        }
+        if (mTapDistribution.isTapEnabled(tap)) {
+            liveTaps |= 1u << tap;
+        }
+    }
+    liveTaps |= fadingTaps;
+    mSleepingTaps &= liveTaps & ~fadingTaps;
+
+    uint32_t wakeOnInput = 0;
+    TapMask::forEach(mSleepingTaps, [&](int tap) {
+        float tapDelayTime = mTapDistribution.getTapDelayTime(tap);
+        if (getHistoricParameters(tap, tapDelayTime, numSamples - 1).level > 0.0f ||
+            getHistoricParameters(tap, tapDelayTime, 0).level > 0.0f) {
+            wakeOnInput |= 1u << tap;
+        }
+    });
+
+    mDecoupledDelaySystemL.setSleepingTaps(mSleepingTaps, wakeOnInput);
+    mDecoupledDelaySystemL.writeBlock(mBlockDelayInputL.data(), 1);
+    mDecoupledDelaySystemL.readBlock(numSamples, mTapBlockOutputsL.data());
+    uint32_t stillSleeping = mDecoupledDelaySystemL.getSleepingTaps();
+    if (!monoSum) {
+        mDecoupledDelaySystemR.setSleepingTaps(mSleepingTaps, wakeOnInput);
+        mDecoupledDelaySystemR.writeBlock(mBlockDelayInputR.data(), 1);
+        mDecoupledDelaySystemR.readBlock(numSamples, mTapBlockOutputsR.data());
+        stillSleeping &= mDecoupledDelaySystemR.getSleepingTaps();
+    }
+
+    // Woken taps start their hold again; one woken by a single channel has
+    // the other channel's (silent) output zeroed for this sub-block
+    TapMask::forEach(mSleepingTaps & ~stillSleeping, [&](int tap) {
+        mTapQuietSamples[tap] = 0;
+    });
+    mSleepingTaps = stillSleeping;
+    const uint32_t activeTaps = liveTaps & ~mSleepingTaps;
+
+    std::fill(mBlockSumL.begin(), mBlockSumL.begin() + numSamples, 0.0f);
+    std::fill(mBlockSumR.begin(), mBlockSumR.begin() + numSamples, 0.0f);
+    std::fill(mBlockFeedbackSendL.begin(), mBlockFeedbackSendL.begin() + numSamples, 0.0f);
+    std::fill(mBlockFeedbackSendR.begin(), mBlockFeedbackSendR.begin() + numSamples, 0.0f);
+    std::fill(mBlockFeedbackPreSendL.begin(), mBlockFeedbackPreSendL.begin() + numSamples, 0.0f);
+    std::fill(mBlockFeedbackPreSendR.begin(), mBlockFeedbackPreSendR.begin() + numSamples, 0.0f);
+
+    uint32_t resetTaps = 0;
+    const bool trueStereo = mEngineMode == kEngineMode_TrueStereo;
+
+    // Gain lanes: one historic parameter lookup per tap and sample, pan and
+    // fade folded into a gain per side (see panTapOutput())
+    TapMask::forEach(activeTaps, [&](int tap) {
+        const size_t offset = static_cast<size_t>(tap) * mMaxBlockSize;
+        float* level = mTapLevelGains.data() + offset;
+        float* send = mTapSendGains.data() + offset;
+        float* gainL = mTapMainGainsL.data() + offset;
+        float* gainR = mTapMainGainsR.data() + offset;
+
+        float tapDelayTime = mTapDistribution.getTapDelayTime(tap);
+
+        // Filter parameters are scheduled only where the historic values change
+        ParameterSnapshot runParams{};
+
+        for (int i = 0; i < numSamples; i++) {
+            ParameterSnapshot historicParams = getHistoricParameters(tap, tapDelayTime, numSamples - 1 - i);
+
+            level[i] = historicParams.level;
+            send[i] = historicParams.feedbackSend;
+            gainL[i] = trueStereo ? std::min(1.0f, 2.0f * (1.0f - historicParams.pan)) : 1.0f - historicParams.pan;
+            gainR[i] = trueStereo ? std::min(1.0f, 2.0f * historicParams.pan) : historicParams.pan;
+
+            bool filterChanged = historicParams.filterCutoff != runParams.filterCutoff ||
+                                 historicParams.filterResonance != runParams.filterResonance ||
+                                 historicParams.filterType != runParams.filterType;
+
+            if (i == 0 || filterChanged) {
+                mTapFilterBank.scheduleParameters(tap, i, historicParams.filterCutoff, historicParams.filterResonance, historicParams.filterType);
+                runParams = historicParams;
+            }
+        }
+
+        // The fade shapes the main output and post-effects send, not the
+        // pre-effects send
+        if (mTapFadingOut[tap] || mTapFadingIn[tap]) {
+            if (renderTapFade(tap, mBlockFadeGain.data(), numSamples)) {
+                resetTaps |= 1u << tap;
+            }
+            FadeRamp::applyGains(gainL, mBlockFadeGain.data(), numSamples);
+            FadeRamp::applyGains(gainR, mBlockFadeGain.data(), numSamples);
+        }
+    });
+
+    // Level and pre-effects send (before filtering); the filter input peak
+    // counts toward the tap's sleep
+    std::array<float, NUM_TAPS> tapPeaks{};
+    TapMask::forEach(activeTaps, [&](int tap) {
+        const size_t offset = static_cast<size_t>(tap) * mMaxBlockSize;
+        TapMixKernel::applyLevel(mTapBlockOutputsL[tap], mTapLevelGains.data() + offset, mTapSendGains.data() + offset,
+                                 mBlockFeedbackPreSendL.data(), numSamples);
+        tapPeaks[tap] = TapMixKernel::peak(mTapBlockOutputsL[tap], numSamples);
+        if (!monoSum) {
+            TapMixKernel::applyLevel(mTapBlockOutputsR[tap], mTapLevelGains.data() + offset, mTapSendGains.data() + offset,
+                                     mBlockFeedbackPreSendR.data(), numSamples);
+            tapPeaks[tap] = std::max(tapPeaks[tap], TapMixKernel::peak(mTapBlockOutputsR[tap], numSamples));
+        }
+    });
+
+    // All taps and both channels (or the mono channel) filtered together
+    mTapFilterBank.processBlock(mTapBlockOutputsL.data(), monoSum ? nullptr : mTapBlockOutputsR.data(),
+                                activeTaps, numSamples);
+
+    // Pan, fade and post-effects send. In mono sum both sides read the mid
+    // chain, which the classic pan turns into 2 * mid * gain, as if L and R
+    // had been run apart
+    const int sleepHoldSamples = static_cast<int>(TAP_SLEEP_HOLD_SECONDS * mSampleRate);
+    TapMask::forEach(activeTaps, [&](int tap) {
+        const size_t offset = static_cast<size_t>(tap) * mMaxBlockSize;
+        const float* tapL = mTapBlockOutputsL[tap];
+        const float* tapR = monoSum ? tapL : mTapBlockOutputsR[tap];
+
+        TapMixKernel::mixToBuses(tapL, tapR, !trueStereo,
+                                 mTapMainGainsL.data() + offset, mTapMainGainsR.data() + offset, mTapSendGains.data() + offset,
+                                 mBlockSumL.data(), mBlockSumR.data(),
+                                 mBlockFeedbackSendL.data(), mBlockFeedbackSendR.data(), numSamples);
+
+        // Asleep from the next sub-block once filter input and output have
+        // been silent for the whole hold (the filter state has decayed)
+        float peak = std::max(tapPeaks[tap], TapMixKernel::peak(tapL, numSamples));
+        if (!monoSum) {
+            peak = std::max(peak, TapMixKernel::peak(tapR, numSamples));
+        }
+        if (peak > DecoupledDelaySystem::SLEEP_THRESHOLD || (fadingTaps & (1u << tap))) {
+            mTapQuietSamples[tap] = 0;
+        } else {
+            mTapQuietSamples[tap] = std::min(mTapQuietSamples[tap] + numSamples, sleepHoldSamples);
+            if (mTapQuietSamples[tap] >= sleepHoldSamples) {
+                mSleepingTaps |= 1u << tap;
+            }
+        }
+    });
+
+    // Close the feedback loop sample by sample; each result feeds the next input
+    for (int i = 0; i < numSamples; i++) {
+        if (monoSum) {
+            // The mid chain is fed back the mid of the panned sends
+            float sendMid = 0.5f * (mBlockFeedbackSendL[i] + mBlockFeedbackSendR[i]);
+            mFeedbackSubMixerL = sendMid;
+            mFeedbackSubMixerR = sendMid;
+            mFeedbackSubMixerPreEffectsL = mBlockFeedbackPreSendL[i];
+            mFeedbackSubMixerPreEffectsR = mBlockFeedbackPreSendL[i];
+        } else {
+            mFeedbackSubMixerL = mBlockFeedbackSendL[i];
+            mFeedbackSubMixerR = mBlockFeedbackSendR[i];
+            mFeedbackSubMixerPreEffectsL = mBlockFeedbackPreSendL[i];
+            mFeedbackSubMixerPreEffectsR = mBlockFeedbackPreSendR[i];
+        }
+        storeFeedbackSignal();
+
+        if (i + 1 < numSamples) {
+            if (monoSum) {
+                mBlockDelayInputL[i + 1] = FastTanh::pade(0.5f * (inputL[i + 1] + inputR[i + 1]) + (mFeedbackBufferL * mBlockFeedbackGain[i + 1])) * mBlockInputGain[i + 1];
+            } else {
+                mBlockDelayInputL[i + 1] = FastTanh::pade(inputL[i + 1] + (mFeedbackBufferL * mBlockFeedbackGain[i + 1])) * mBlockInputGain[i + 1];
+                mBlockDelayInputR[i + 1] = FastTanh::pade(inputR[i + 1] + (mFeedbackBufferR * mBlockFeedbackGain[i + 1])) * mBlockInputGain[i + 1];
+            }
+        }
+
+        wetL[i] = mBlockSumL[i];
+        wetR[i] = mBlockSumR[i];
+    }
+
+    // The bypass fade shapes only the wet output, never the feedback
+    if (mDelayFadingOut || mDelayFadingIn) {
+        renderDelayFade(mBlockFadeGain.data(), numSamples);
+        FadeRamp::applyGains(wetL, mBlockFadeGain.data(), numSamples);
+        FadeRamp::applyGains(wetR, mBlockFadeGain.data(), numSamples);
+    }
+
+    mDecoupledDelaySystemL.writeBlock(mBlockDelayInputL.data() + 1, numSamples - 1);
+    if (!monoSum) {
+        mDecoupledDelaySystemR.writeBlock(mBlockDelayInputR.data() + 1, numSamples - 1);
+    }
+
+    // Everything written and everything heard counts toward the decay
+    float tailPeak = std::max(TapMixKernel::peak(mBlockDelayInputL.data(), numSamples),
+                              std::max(TapMixKernel::peak(wetL, numSamples), TapMixKernel::peak(wetR, numSamples)));
+    if (!monoSum) {
+        tailPeak = std::max(tailPeak, TapMixKernel::peak(mBlockDelayInputR.data(), numSamples));
+    }
+    mTailTracker.observe(tailPeak, numSamples);
+
+    // Sub-block ends on the sample a fade-out completed
+    TapMask::forEach(resetTaps, [&](int tap) {
+        mDecoupledDelaySystemL.resetTap(tap);
+        mDecoupledDelaySystemR.resetTap(tap);
+    });
 
+    return numSamples;
+}
+
+void WaterStickProcessor::prepareBlockProcessing(int maxBlockSize)
+{
+    mMaxBlockSize = std::max(1, std::min(maxBlockSize, MultiTapDelayBuffer::WRITE_AHEAD_SAMPLES));
+
+    mDecoupledDelaySystemL.prepareBlockProcessing(mMaxBlockSize);
+    mDecoupledDelaySystemR.prepareBlockProcessing(mMaxBlockSize);
+    mTapFilterBank.prepare(mMaxBlockSize);
+
+    mTapBlockBufferL.assign(static_cast<size_t>(NUM_TAPS) * mMaxBlockSize, 0.0f);
+    mTapBlockBufferR.assign(static_cast<size_t>(NUM_TAPS) * mMaxBlockSize, 0.0f);
+    for (int tap = 0; tap < NUM_TAPS; tap++) {
+        mTapBlockOutputsL[tap] = mTapBlockBufferL.data() + static_cast<size_t>(tap) * mMaxBlockSize;
+        mTapBlockOutputsR[tap] = mTapBlockBufferR.data() + static_cast<size_t>(tap) * mMaxBlockSize;
+    }
+    mTapLevelGains.assign(static_cast<size_t>(NUM_TAPS) * mMaxBlockSize, 0.0f);
+    mTapSendGains.assign(static_cast<size_t>(NUM_TAPS) * mMaxBlockSize, 0.0f);
+    mTapMainGainsL.assign(static_cast<size_t>(NUM_TAPS) * mMaxBlockSize, 0.0f);
+    mTapMainGainsR.assign(static_cast<size_t>(NUM_TAPS) * mMaxBlockSize, 0.0f);
+
+    mBlockDelayInputL.assign(mMaxBlockSize, 0.0f);
+    mBlockDelayInputR.assign(mMaxBlockSize, 0.0f);
+    mBlockSumL.assign(mMaxBlockSize, 0.0f);
+    mBlockSumR.assign(mMaxBlockSize, 0.0f);
+    mBlockFeedbackSendL.assign(mMaxBlockSize, 0.0f);
+    mBlockFeedbackSendR.assign(mMaxBlockSize, 0.0f);
+    mBlockFeedbackPreSendL.assign(mMaxBlockSize, 0.0f);
+    mBlockFeedbackPreSendR.assign(mMaxBlockSize, 0.0f);
+    mBlockWetL.assign(mMaxBlockSize, 0.0f);
+    mBlockWetR.assign(mMaxBlockSize, 0.0f);
+    // Whole host blocks, so a segment is narrowed once
+    mBlockEngineInputL.assign(std::max(mMaxBlockSize, maxBlockSize), 0.0f);
+    mBlockEngineInputR.assign(std::max(mMaxBlockSize, maxBlockSize), 0.0f);
+    mBlockInputGain.assign(mMaxBlockSize, 0.0f);
+    mBlockFeedbackGain.assign(mMaxBlockSize, 0.0f);
+    mBlockOutputGain.assign(mMaxBlockSize, 0.0f);
+    mBlockDryWet.assign(mMaxBlockSize, 0.0f);
+    mBlockFadeGain.assign(mMaxBlockSize, 1.0f);
+}
+
+float WaterStickProcessor::advanceTapFade(int tap, bool& fadeOutComplete)
+{
+    fadeOutComplete = false;
+    if (!mTapFadingOut[tap] && !mTapFadingIn[tap]) {
+        return 1.0f;
+    }
+
+    float gain = mTapFade[tap].next();
+    if (!mTapFade[tap].isActive()) {
+        fadeOutComplete = mTapFadingOut[tap];
+        mTapFadingOut[tap] = false;
+        mTapFadingIn[tap] = false;
+    }
+
+    return gain;
+}
+
+bool WaterStickProcessor::renderTapFade(int tap, float* gains, int numSamples)
+{
+    mTapFade[tap].render(gains, numSamples);
+    if (mTapFade[tap].isActive()) {
+        return false;
+    }
+
+    bool fadeOutComplete = mTapFadingOut[tap];
+    mTapFadingOut[tap] = false;
+    mTapFadingIn[tap] = false;
+    return fadeOutComplete;
+}
+
+void WaterStickProcessor::renderDelayFade(float* gains, int numSamples)
+{
+    mDelayFade.render(gains, numSamples);
+    if (!mDelayFade.isActive()) {
+        mDelayFadingOut = false;
+        mDelayFadingIn = false;
+    }
+}
+
+void WaterStickProcessor::storeFeedbackSignal()
+{
     // Get feedback signal (either pre-effects or post-effects based on routing)
     float feedbackL, feedbackR;
 
@@ -2414,44 +2765,38 @@ void WaterStickProcessor::processDelaySection(float inputL, float inputR, float&
     // Store the processed feedback signal
     mFeedbackBufferL = feedbackL;
     mFeedbackBufferR = feedbackR;
+}
 
-    // Delay section is always 100% wet now
-    float dryGain = 0.0f;
-    float wetGain = 1.0f;
-    float delayWetGain = wetGain;
-
-    outputL = (inputL * dryGain) + (sumL * delayWetGain);
-    outputR = (inputR * dryGain) + (sumR * delayWetGain);
+void WaterStickProcessor::panTapOutput(float tapOutputL, float tapOutputR, float pan, float& tapMainL, float& tapMainR) const
+{
+    if (mEngineMode == kEngineMode_TrueStereo) {
+        // Balance: each side keeps its own channel, attenuated only past centre
+        tapMainL = tapOutputL * std::min(1.0f, 2.0f * (1.0f - pan));
+        tapMainR = tapOutputR * std::min(1.0f, 2.0f * pan);
+        return;
+    }
 
-    if (mDelayFadingOut) {
-        outputL *= mDelayFadeGain;
-        outputR *= mDelayFadeGain;
+    // Classic: both channels summed, then panned linearly
+    float leftGain = 1.0f - pan;
+    float rightGain = pan;
+    tapMainL = (tapOutputL * leftGain) + (tapOutputR * leftGain);
+    tapMainR = (tapOutputL * rightGain) + (tapOutputR * rightGain);
+}
 
-        mDelayFadeRemaining--;
-        if (mDelayFadeRemaining <= 0) {
-            mDelayFadingOut = false;
-            mDelayFadeGain = 1.0f;
-        } else {
-            float fadeProgress = 1.0f - (static_cast<float>(mDelayFadeRemaining) / static_cast<float>(mDelayFadeTotalLength));
-            mDelayFadeGain = std::exp(-6.0f * fadeProgress);
-        }
+void WaterStickProcessor::applyDelayFade(float& outputL, float& outputR)
+{
+    if (!mDelayFadingOut && !mDelayFadingIn) {
+        return;
     }
-    else if (mDelayFadingIn) {
-        outputL *= mDelayFadeGain;
-        outputR *= mDelayFadeGain;
 
-        mDelayFadeRemaining--;
-        if (mDelayFadeRemaining <= 0) {
-            mDelayFadingIn = false;
-            mDelayFadeGain = 1.0f;
-        } else {
-            float fadeProgress = 1.0f - (static_cast<float>(mDelayFadeRemaining) / static_cast<float>(mDelayFadeTotalLength));
-            mDelayFadeGain = 1.0f - std::exp(-6.0f * fadeProgress);
-        }
-    }
+    float gain = mDelayFade.next();
+    outputL *= gain;
+    outputR *= gain;
 
-    // NOTE: Bypass logic moved to main processing loop for proper scope
-    // This section now only handles delay processing - bypass is handled upstream
+    if (!mDelayFade.isActive()) {
+        mDelayFadingOut = false;
+        mDelayFadingIn = false;
+    }
 }
 
 
@@ -2480,25 +2825,25 @@ tresult PLUGIN_API WaterStickProcessor::setupProcessing(Vst::ProcessSetup& newSe
 {
     mSampleRate = newSetup.sampleRate;
 
-    mDelayLineL.initialize(mSampleRate, 2.0);
-    mDelayLineR.initialize(mSampleRate, 2.0);
-
-    double maxDelayTime = 20.0;
-    for (int i = 0; i < NUM_TAPS; i++) {
-        mTapDelayLinesL[i].initialize(mSampleRate, maxDelayTime);
-        mTapDelayLinesR[i].initialize(mSampleRate, maxDelayTime);
-    }
+    // Phase 5: Initialize decoupled delay + pitch architecture (production solution)
+    mDecoupledDelaySystemL.initialize(mSampleRate, MAX_TAP_DELAY_SECONDS);
+    mDecoupledDelaySystemR.initialize(mSampleRate, MAX_TAP_DELAY_SECONDS);
+    mUseDecoupledArchitecture = true;  // Enable by default for production
+    prepareBlockProcessing(newSetup.maxSamplesPerBlock);
 
-    // Phase 2: Initialize unified delay lines (bulletproof architecture)
+    // Lookups reach back the longest delay, plus the block captured up front
     for (int i = 0; i < NUM_TAPS; i++) {
-        mUnifiedTapDelayLinesL[i].initialize(mSampleRate, maxDelayTime);
-        mUnifiedTapDelayLinesR[i].initialize(mSampleRate, maxDelayTime);
+        mTapParameterTimelines[i].setHorizon(static_cast<int64_t>(MAX_TAP_DELAY_SECONDS * mSampleRate) + mMaxBlockSize);
     }
 
-    // Phase 5: Initialize decoupled delay + pitch architecture (production solution)
-    mDecoupledDelaySystemL.initialize(mSampleRate, maxDelayTime);
-    mDecoupledDelaySystemR.initialize(mSampleRate, maxDelayTime);
-    mUseDecoupledArchitecture = true;  // Enable by default for production
+    // Not processing here, so legacy engines can be freed; they are rebuilt
+    // for the new rate only if still selected
+    mUnifiedEngines.store(nullptr, std::memory_order_release);
+    mSpeedBasedEngines.store(nullptr, std::memory_order_release);
+    mUnifiedEnginesStorage.reset();
+    mSpeedBasedEnginesStorage.reset();
+    allocateLegacyEngines(mUseDecoupledArchitecture, mUseUnifiedDelayLines);
+    allocatePitchClassBuffers();
 
     // PHASE 3: Initialize performance optimization components
     mParameterCache->initialize(NUM_TAPS);
@@ -2510,6 +2855,10 @@ tresult PLUGIN_API WaterStickProcessor::setupProcessing(Vst::ProcessSetup& newSe
         mTapFiltersL[i].setSampleRate(mSampleRate);
         mTapFiltersR[i].setSampleRate(mSampleRate);
     }
+    mTapFilterBank.setSampleRate(mSampleRate);
+
+    mTailTracker.setSampleRate(mSampleRate);
+    mTailTracker.reset();
 
     return AudioEffect::setupProcessing(newSetup);
 }
@@ -2517,9 +2866,9 @@ tresult PLUGIN_API WaterStickProcessor::setupProcessing(Vst::ProcessSetup& newSe
 
 void WaterStickProcessor::captureCurrentParameters()
 {
-    // Store current parameter values for all taps
+    // Log current parameter values for all taps; unchanged values cost a compare
     for (int i = 0; i < 16; i++) {
-        ParameterSnapshot& snapshot = mTapParameterHistory[i][mParameterHistoryWriteIndex];
+        ParameterSnapshot snapshot;
         snapshot.level = mTapLevel[i];
         snapshot.pan = mTapPan[i];
         snapshot.filterCutoff = mTapFilterCutoff[i];
@@ -2528,13 +2877,14 @@ void WaterStickProcessor::captureCurrentParameters()
         snapshot.pitchShift = mTapPitchShift[i];
         snapshot.feedbackSend = mTapFeedbackSend[i];
         snapshot.enabled = mTapEnabled[i];
+        mTapParameterTimelines[i].record(mParameterClock, snapshot);
     }
 
-    // Advance write index (circular buffer)
-    mParameterHistoryWriteIndex = (mParameterHistoryWriteIndex + 1) % PARAM_HISTORY_SIZE;
+    // Advance the sample clock
+    mParameterClock++;
 }
 
-WaterStickProcessor::ParameterSnapshot WaterStickProcessor::getHistoricParameters(int tapIndex, float delayTimeSeconds) const
+WaterStickProcessor::ParameterSnapshot WaterStickProcessor::getHistoricParameters(int tapIndex, float delayTimeSeconds, int extraSamplesBack)
 {
     if (tapIndex < 0 || tapIndex >= 16) {
         // Return current parameters as fallback
@@ -2550,17 +2900,11 @@ WaterStickProcessor::ParameterSnapshot WaterStickProcessor::getHistoricParameter
         return current;
     }
 
-    // Calculate how many samples back to look
-    int samplesBack = static_cast<int>(delayTimeSeconds * mSampleRate);
-    samplesBack = std::min(samplesBack, PARAM_HISTORY_SIZE - 1);
-
-    // Calculate history index
-    int historyIndex = mParameterHistoryWriteIndex - samplesBack;
-    if (historyIndex < 0) {
-        historyIndex += PARAM_HISTORY_SIZE;
-    }
+    // Calculate how many samples back to look (extraSamplesBack addresses
+    // earlier samples of a block whose parameters were captured up front)
+    int64_t samplesBack = static_cast<int64_t>(delayTimeSeconds * mSampleRate) + extraSamplesBack;
 
-    return mTapParameterHistory[tapIndex][historyIndex];
+    return mTapParameterTimelines[tapIndex].lookup(mParameterClock - samplesBack);
 }
 
 void WaterStickProcessor::checkTempoSyncParameterChanges()
@@ -2585,6 +2929,21 @@ void WaterStickProcessor::updateParameters()
     // CRITICAL FIX: Removed heavy profiling calls from audio thread
     // Performance profiling moved to debug/development mode only
 
+    updateDelayParameters();
+
+    for (int i = 0; i < NUM_TAPS; i++) {
+        mTapFiltersL[i].setParameters(mTapFilterCutoff[i], mTapFilterResonance[i], mTapFilterType[i]);
+        mTapFiltersR[i].setParameters(mTapFilterCutoff[i], mTapFilterResonance[i], mTapFilterType[i]);
+    }
+
+    // Update discrete parameters with real-time curve evaluation and smoothing
+    updateDiscreteParameters();
+    applyCurveEvaluation();
+    applyParameterSmoothing();
+}
+
+void WaterStickProcessor::updateDelayParameters()
+{
     mTempoSync.setMode(mTempoSyncMode);
     mTempoSync.setSyncDivision(mSyncDivision);
     mTempoSync.setFreeTime(mDelayTime);
@@ -2600,14 +2959,21 @@ void WaterStickProcessor::updateParameters()
         mTapDistribution.setTapPan(i, mTapPan[i]);
     }
 
+    UnifiedTapEngines* unified = mUnifiedEngines.load(std::memory_order_acquire);
+    SpeedBasedTapEngines* speedBased = mSpeedBasedEngines.load(std::memory_order_acquire);
+
     for (int i = 0; i < NUM_TAPS; i++) {
         float tapDelayTime = mTapDistribution.getTapDelayTime(i);
-        mTapDelayLinesL[i].setDelayTime(tapDelayTime);
-        mTapDelayLinesR[i].setDelayTime(tapDelayTime);
+        if (speedBased) {
+            speedBased->left[i].setDelayTime(tapDelayTime);
+            speedBased->right[i].setDelayTime(tapDelayTime);
+        }
 
         // Update unified delay lines (production system)
-        mUnifiedTapDelayLinesL[i].setDelayTime(tapDelayTime);
-        mUnifiedTapDelayLinesR[i].setDelayTime(tapDelayTime);
+        if (unified) {
+            unified->left[i].setDelayTime(tapDelayTime);
+            unified->right[i].setDelayTime(tapDelayTime);
+        }
 
         // Update decoupled delay + pitch architecture (final production solution)
         if (mUseDecoupledArchitecture) {
@@ -2620,25 +2986,19 @@ void WaterStickProcessor::updateParameters()
         }
     }
 
-    if (!mTempoSyncMode) {
+    if (!mTempoSyncMode && speedBased) {
         float finalDelayTime = mTempoSync.getDelayTime();
-        mDelayLineL.setDelayTime(finalDelayTime);
-        mDelayLineR.setDelayTime(finalDelayTime);
+        speedBased->delayLeft.setDelayTime(finalDelayTime);
+        speedBased->delayRight.setDelayTime(finalDelayTime);
     }
-
-    for (int i = 0; i < NUM_TAPS; i++) {
-        mTapFiltersL[i].setParameters(mTapFilterCutoff[i], mTapFilterResonance[i], mTapFilterType[i]);
-        mTapFiltersR[i].setParameters(mTapFilterCutoff[i], mTapFilterResonance[i], mTapFilterType[i]);
-    }
-
-    // Update discrete parameters with real-time curve evaluation and smoothing
-    updateDiscreteParameters();
-    applyCurveEvaluation();
-    applyParameterSmoothing();
 }
 
 tresult PLUGIN_API WaterStickProcessor::process(Vst::ProcessData& data)
 {
+    // Decaying tails flush to zero instead of lingering as subnormals; the
+    // host's floating point mode is restored on every return
+    DenormalGuard denormalGuard;
+
     if (data.processContext && data.processContext->state & Vst::ProcessContext::kTempoValid)
     {
         double hostTempo = data.processContext->tempo;
@@ -2649,100 +3009,12 @@ tresult PLUGIN_API WaterStickProcessor::process(Vst::ProcessData& data)
         mTempoSync.updateTempo(120.0, false);
     }
 
-    // Process parameter changes
-    if (data.inputParameterChanges)
-    {
-        int32 numParamsChanged = data.inputParameterChanges->getParameterCount();
-        for (int32 i = 0; i < numParamsChanged; i++)
-        {
-            Vst::IParamValueQueue* paramQueue = data.inputParameterChanges->getParameterData(i);
-            if (paramQueue)
-            {
-                Vst::ParamValue value;
-                int32 sampleOffset;
-                int32 numPoints = paramQueue->getPointCount();
-
-                if (paramQueue->getPoint(numPoints - 1, sampleOffset, value) == kResultTrue)
-                {
-                    switch (paramQueue->getParameterId())
-                    {
-                        case kInputGain:
-                            mInputGain = ParameterConverter::convertGain(value);
-                            break;
-                        case kOutputGain:
-                            mOutputGain = ParameterConverter::convertGain(value);
-                            break;
-                        case kDelayTime:
-                            mDelayTime = static_cast<float>(value * 2.0); // 0-2 seconds
-                            break;
-                        case kFeedback:
-                            mFeedback = ParameterConverter::convertFeedback(value);
-                            break;
-                        case kFeedbackDamping:
-                            mFeedbackDamping = static_cast<float>(value);
-                            updateFeedbackDampingCoefficients();
-                            break;
-                        case kFeedbackDampingCutoff:
-                            mFeedbackDampingCutoff = static_cast<float>(value);
-                            updateFeedbackDampingCoefficients();
-                            break;
-                        case kFeedbackPreEffects:
-                            mFeedbackPreEffects = value > 0.5f;
-                            break;
-                        case kFeedbackPolarityInvert:
-                            mFeedbackPolarityInvert = value > 0.5f;
-                            break;
-                        case kTempoSyncMode:
-                            mTempoSyncMode = value > 0.5; // Toggle: >0.5 = synced
-                            break;
-                        case kSyncDivision:
-                            mSyncDivision = static_cast<int>(value * (kNumSyncDivisions - 1) + 0.5); // Round to nearest
-                            break;
-                        case kGrid:
-                            mGrid = static_cast<int>(value * (kNumGridValues - 1) + 0.5);
-                            break;
-                        case kGlobalDryWet:
-                            mGlobalDryWet = static_cast<float>(value);
-                            break;
-                        case kDelayBypass:
-                            mDelayBypass = value > 0.5;
-                            break;
-                        default:
-                            // Handle discrete parameters
-                            if (paramQueue->getParameterId() >= kDiscrete1 && paramQueue->getParameterId() <= kDiscrete24) {
-                                int index = paramQueue->getParameterId() - kDiscrete1;
-                                mDiscreteParameters[index] = static_cast<float>(value);
-                            }
-                            // Handle macro curve type parameters
-                            else if (paramQueue->getParameterId() >= kMacroCurve1Type && paramQueue->getParameterId() <= kMacroCurve4Type) {
-                                int index = paramQueue->getParameterId() - kMacroCurve1Type;
-                                mMacroCurveTypes[index] = static_cast<int>(value * (kNumCurveTypes - 1) + 0.5);
-                            }
-                            // Handle macro knob parameters
-                            else if (paramQueue->getParameterId() >= kMacroKnob1 && paramQueue->getParameterId() <= kMacroKnob8) {
-                                int index = paramQueue->getParameterId() - kMacroKnob1;
-                                mMacroKnobValues[index] = static_cast<float>(value);
-
-                                // CRITICAL FIX: Apply macro curves only when macro parameters change
-                                // This prevents continuous parameter override in audio processing loop
-                                applyMacroCurvesToTapParameters();
-                            }
-                            // Handle randomization and reset parameters (processed in controller)
-                            else if (paramQueue->getParameterId() == kRandomizeSeed ||
-                                    paramQueue->getParameterId() == kRandomizeAmount ||
-                                    paramQueue->getParameterId() == kRandomizeTrigger ||
-                                    paramQueue->getParameterId() == kResetTrigger) {
-                                // These are handled by the controller
-                            }
-                            else {
-                                TapParameterProcessor::processTapParameter(paramQueue->getParameterId(), value, this);
-                            }
-                            break;
-                    }
-                }
-            }
-        }
-    }
+    // Merge every automation point of this block into one timeline; steps at
+    // offset 0 apply now, everything later is rendered sample-accurately
+    mEventScheduler.collect(data.inputParameterChanges, data.numSamples,
+                            [this](Vst::ParamID id) { return getRampTarget(id) != nullptr; });
+    mAutomationSample = 0;
+    applyStepEvents(0);
 
     // CRITICAL FIX: Disable Phase 3 optimizations that broke audio processing
     // updateParametersOptimized();  // DISABLED - complex SIMD/lock-free operations causing audio failure
@@ -2757,33 +3029,12 @@ tresult PLUGIN_API WaterStickProcessor::process(Vst::ProcessData& data)
     checkBypassStateChanges();
 
     // Only update tempo sync delay times when parameters actually changed
-    if (mTempoSyncMode && mTempoSyncParametersChanged) {
-        // Update tap distribution with current tempo
-        mTapDistribution.updateTempo(mTempoSync);
-
-        // Update all tap delay times only when parameters changed
-        for (int i = 0; i < NUM_TAPS; i++) {
-            float tapDelayTime = mTapDistribution.getTapDelayTime(i);
-            mTapDelayLinesL[i].setDelayTime(tapDelayTime);
-            mTapDelayLinesR[i].setDelayTime(tapDelayTime);
-
-            // Update unified delay lines (production system)
-            mUnifiedTapDelayLinesL[i].setDelayTime(tapDelayTime);
-            mUnifiedTapDelayLinesR[i].setDelayTime(tapDelayTime);
-        }
-
-        // Update legacy delay lines too
-        float finalDelayTime = mTempoSync.getDelayTime();
-        mDelayLineL.setDelayTime(finalDelayTime);
-        mDelayLineR.setDelayTime(finalDelayTime);
-
-        // Reset the change flag
-        mTempoSyncParametersChanged = false;
-    }
+    updateTempoSyncDelayTimes();
 
     // Check for valid input/output
     if (data.numInputs == 0 || data.numOutputs == 0)
     {
+        flushParameterEvents();
         return kResultOk;
     }
 
@@ -2793,20 +3044,211 @@ tresult PLUGIN_API WaterStickProcessor::process(Vst::ProcessData& data)
     // Ensure we have stereo input/output
     if (input->numChannels < 2 || output->numChannels < 2)
     {
+        flushParameterEvents();
         return kResultOk;
     }
 
-    float* inputL = input->channelBuffers32[0];
-    float* inputR = input->channelBuffers32[1];
-    float* outputL = output->channelBuffers32[0];
-    float* outputR = output->channelBuffers32[1];
+    if (data.symbolicSampleSize == Vst::kSample64) {
+        return processBuffers<Vst::Sample64>(data, input->channelBuffers64, output->channelBuffers64);
+    }
+    return processBuffers<Vst::Sample32>(data, input->channelBuffers32, output->channelBuffers32);
+}
 
-    for (int32 sample = 0; sample < data.numSamples; sample++)
+tresult PLUGIN_API WaterStickProcessor::canProcessSampleSize(int32 symbolicSampleSize)
+{
+    return symbolicSampleSize == Vst::kSample32 || symbolicSampleSize == Vst::kSample64 ? kResultTrue : kResultFalse;
+}
+
+template <typename SampleType>
+tresult WaterStickProcessor::processBuffers(Vst::ProcessData& data, SampleType** inputs, SampleType** outputs)
+{
+    Vst::AudioBusBuffers* input = data.inputs;
+    Vst::AudioBusBuffers* output = data.outputs;
+
+    const SampleType* inputL = inputs[0];
+    const SampleType* inputR = inputs[1];
+    SampleType* outputL = outputs[0];
+    SampleType* outputR = outputs[1];
+
+    // Silent input (flagged by the host, or measured) into a decayed tail
+    // needs no engine: the block is flagged silence and automation lands
+    const uint64 stereoChannels = 0x3;
+    bool inputSilent = (input->silenceFlags & stereoChannels) == stereoChannels ||
+        std::max(HostSamples::peak(inputL, data.numSamples),
+                 HostSamples::peak(inputR, data.numSamples)) <= TailTracker::SILENCE_THRESHOLD;
+
+    bool fading = mDelayFadingOut || mDelayFadingIn;
+    for (int tap = 0; tap < NUM_TAPS; tap++) {
+        fading = fading || mTapFadingOut[tap] || mTapFadingIn[tap];
+    }
+
+    updateTailTracking();
+    if (mUseDecoupledArchitecture && mMaxBlockSize > 0 && inputSilent && !fading && mTailTracker.isDecayed())
     {
+        mEngineIdle = true;
+        std::fill(outputL, outputL + data.numSamples, SampleType(0));
+        std::fill(outputR, outputR + data.numSamples, SampleType(0));
+        output->silenceFlags = stereoChannels;
+        flushParameterEvents();
+        return kResultOk;
+    }
+
+    if (mEngineIdle) {
+        wakeEngine();
+    }
+    output->silenceFlags = 0;
+
+    // Render the segments between step events
+    int32 sample = 0;
+    while (sample < data.numSamples)
+    {
+        int32 segmentEnd = std::min(mEventScheduler.getNextStepOffset(), data.numSamples);
+
+        if (mUseDecoupledArchitecture && mMaxBlockSize > 0) {
+            processDecoupledSegment(inputL, inputR, outputL, outputR, sample, segmentEnd);
+        } else {
+            processLegacySegment(inputL, inputR, outputL, outputR, sample, segmentEnd);
+        }
+
+        sample = segmentEnd;
+        if (sample < data.numSamples) {
+            applyStepEvents(sample);
+            updateSegmentParameters();
+        }
+    }
+
+    int64_t compactions = 0;
+    for (int tap = 0; tap < NUM_TAPS; tap++) {
+        compactions += mTapParameterTimelines[tap].getCompactions();
+    }
+    mTimelineCompactions.store(static_cast<uint32>(compactions));
+
+    return kResultOk;
+}
+
+uint32 PLUGIN_API WaterStickProcessor::getTailSamples()
+{
+    uint32 tailSamples = mTailSamples.load();
+    return tailSamples == TailTracker::INFINITE_TAIL ? Vst::kInfiniteTail : tailSamples;
+}
+
+void WaterStickProcessor::updateTailTracking()
+{
+    // Measured decay waits for the farthest head of either channel
+    mTailTracker.setLongestReadDistance(std::max(mDecoupledDelaySystemL.getMaxReadDistance(),
+                                                 mDecoupledDelaySystemR.getMaxReadDistance()));
+
+    // Host estimate: the longest tap, and the loop gain with every enabled
+    // tap's send adding up in phase. The classic pan sums both channels into
+    // one side, up to twice a channel's level; balance never exceeds it
+    const bool sidesSummed = !mFeedbackPreEffects && mEngineMode != kEngineMode_TrueStereo;
+    float longestDelay = 0.0f;
+    float tapGain = 0.0f;
+    for (int tap = 0; tap < NUM_TAPS; tap++) {
+        if (mTapDistribution.isTapEnabled(tap)) {
+            longestDelay = std::max(longestDelay, mTapDistribution.getTapDelayTime(tap));
+            float panGain = sidesSummed ? 2.0f * std::max(mTapPan[tap], 1.0f - mTapPan[tap]) : 1.0f;
+            tapGain += mTapLevel[tap] * mTapFeedbackSend[tap] * panGain;
+        }
+    }
+
+    double dampingCoeff = mFeedbackDamping > 0.001f ? mDampingFilterCoeff : 0.0;
+    mTailSamples.store(TailTracker::estimateTailSamples(mSampleRate, longestDelay,
+                                                        tapGain * mFeedback * mInputGain, dampingCoeff));
+}
+
+void WaterStickProcessor::wakeEngine()
+{
+    // Every tap restarts on input written from here on
+    mEngineIdle = false;
+    mDecoupledDelaySystemL.reset();
+    mDecoupledDelaySystemR.reset();
+    mTapFilterBank.reset();
+    mFeedbackBufferL = 0.0f;
+    mFeedbackBufferR = 0.0f;
+    mDampingFilterStateL = 0.0f;
+    mDampingFilterStateR = 0.0f;
+    mSleepingTaps = 0;
+    mTailTracker.reset();
+}
+
+template <typename SampleType>
+void WaterStickProcessor::processDecoupledSegment(const SampleType* inputL, const SampleType* inputR,
+                                                  SampleType* outputL, SampleType* outputR, int32 start, int32 end)
+{
+    float lastDryWet = -1.0f;
+    SampleType globalDryGain = 0;
+    SampleType globalWetGain = 0;
+
+    // Input for the engine, narrowed once for the whole segment (in pieces
+    // only if the host sends more than it announced in setupProcessing)
+    const int32 engineCapacity = static_cast<int32>(mBlockEngineInputL.size());
+    const float* engineL = nullptr;
+    const float* engineR = nullptr;
+    int32 engineStart = start;
+    int32 engineEnd = start;
+
+    int32 sample = start;
+    while (sample < end)
+    {
+        if (mDelayBypass && !mDelayFadingOut && !mDelayFadingIn) {
+            // TRUE BYPASS: Direct input to output, no processing, no feedback accumulation
+            advanceAutomation();
+            captureCurrentParameters();
+            outputL[sample] = inputL[sample] * mOutputGain;
+            outputR[sample] = inputR[sample] * mOutputGain;
+
+            mFeedbackBufferL = 0.0f;
+            mFeedbackBufferR = 0.0f;
+
+            // Nothing is written and only the bypass is heard, so that is
+            // what counts toward the decay: a bypass that stays silent for
+            // the hold lets the engine idle, and its frozen tail is dropped
+            mTailTracker.observe(static_cast<float>(std::max(std::abs(outputL[sample]), std::abs(outputR[sample]))), 1);
+            sample++;
+            continue;
+        }
+
+        if (sample >= engineEnd) {
+            engineStart = sample;
+            engineEnd = std::min(end, sample + engineCapacity);
+            engineL = HostSamples::toEngine(inputL + engineStart, engineEnd - engineStart, mBlockEngineInputL.data());
+            engineR = HostSamples::toEngine(inputR + engineStart, engineEnd - engineStart, mBlockEngineInputR.data());
+        }
+
+        // Render as many samples as the feedback loop allows in one go
+        int available = std::min(engineEnd - sample, mMaxBlockSize);
+        int numRendered = processDecoupledSubBlock(engineL + (sample - engineStart), engineR + (sample - engineStart),
+                                                   mBlockWetL.data(), mBlockWetR.data(), available);
+
+        for (int i = 0; i < numRendered; i++, sample++) {
+            // Dry/wet gains only change while the mix is being automated
+            if (mBlockDryWet[i] != lastDryWet) {
+                lastDryWet = mBlockDryWet[i];
+                globalDryGain = static_cast<SampleType>(std::cos(lastDryWet * M_PI_2));
+                globalWetGain = static_cast<SampleType>(std::sin(lastDryWet * M_PI_2));
+            }
+
+            SampleType mixedL = (inputL[sample] * globalDryGain) + (mBlockWetL[i] * globalWetGain);
+            SampleType mixedR = (inputR[sample] * globalDryGain) + (mBlockWetR[i] * globalWetGain);
+
+            outputL[sample] = mixedL * mBlockOutputGain[i];
+            outputR[sample] = mixedR * mBlockOutputGain[i];
+        }
+    }
+}
+
+template <typename SampleType>
+void WaterStickProcessor::processLegacySegment(const SampleType* inputL, const SampleType* inputR,
+                                               SampleType* outputL, SampleType* outputR, int32 start, int32 end)
+{
+    for (int32 sample = start; sample < end; sample++)
+    {
+        advanceAutomation();
         captureCurrentParameters();
 
-        float inL = inputL[sample];
-        float inR = inputR[sample];
+        SampleType inL = inputL[sample];
+        SampleType inR = inputR[sample];
 
         // BYPASS SCOPE FIX: Check bypass state at the top level
         if (mDelayBypass && !mDelayFadingOut && !mDelayFadingIn) {
@@ -2821,11 +3263,11 @@ tresult PLUGIN_API WaterStickProcessor::process(Vst::ProcessData& data)
         }
 
         // Normal processing path (bypass is OFF)
-        float inputWithFeedbackL = inL + (mFeedbackBufferL * mFeedback);
-        float inputWithFeedbackR = inR + (mFeedbackBufferR * mFeedback);
+        float inputWithFeedbackL = static_cast<float>(inL) + (mFeedbackBufferL * mFeedback);
+        float inputWithFeedbackR = static_cast<float>(inR) + (mFeedbackBufferR * mFeedback);
 
-        inputWithFeedbackL = std::tanh(inputWithFeedbackL);
-        inputWithFeedbackR = std::tanh(inputWithFeedbackR);
+        inputWithFeedbackL = FastTanh::pade(inputWithFeedbackL);
+        inputWithFeedbackR = FastTanh::pade(inputWithFeedbackR);
 
         float gainedL = inputWithFeedbackL * mInputGain;
         float gainedR = inputWithFeedbackR * mInputGain;
@@ -2833,16 +3275,252 @@ tresult PLUGIN_API WaterStickProcessor::process(Vst::ProcessData& data)
         float delayOutputL, delayOutputR;
         processDelaySection(gainedL, gainedR, delayOutputL, delayOutputR);
 
-        float globalDryGain = std::cos(mGlobalDryWet * M_PI_2);
-        float globalWetGain = std::sin(mGlobalDryWet * M_PI_2);
-        float mixedL = (inL * globalDryGain) + (delayOutputL * globalWetGain);
-        float mixedR = (inR * globalDryGain) + (delayOutputR * globalWetGain);
+        SampleType globalDryGain = static_cast<SampleType>(std::cos(mGlobalDryWet * M_PI_2));
+        SampleType globalWetGain = static_cast<SampleType>(std::sin(mGlobalDryWet * M_PI_2));
+        SampleType mixedL = (inL * globalDryGain) + (delayOutputL * globalWetGain);
+        SampleType mixedR = (inR * globalDryGain) + (delayOutputR * globalWetGain);
 
         outputL[sample] = mixedL * mOutputGain;
         outputR[sample] = mixedR * mOutputGain;
     }
+}
 
-    return kResultOk;
+void WaterStickProcessor::applyParameterChange(Vst::ParamID id, Vst::ParamValue value)
+{
+    switch (id)
+    {
+        case kInputGain:
+            mInputGain = ParameterConverter::convertGain(value);
+            break;
+        case kOutputGain:
+            mOutputGain = ParameterConverter::convertGain(value);
+            break;
+        case kDelayTime:
+            mDelayTime = static_cast<float>(value * 2.0); // 0-2 seconds
+            break;
+        case kFeedback:
+            mFeedback = ParameterConverter::convertFeedback(value);
+            break;
+        case kFeedbackDamping:
+            mFeedbackDamping = static_cast<float>(value);
+            updateFeedbackDampingCoefficients();
+            break;
+        case kFeedbackDampingCutoff:
+            mFeedbackDampingCutoff = static_cast<float>(value);
+            updateFeedbackDampingCoefficients();
+            break;
+        case kFeedbackPreEffects:
+            mFeedbackPreEffects = value > 0.5f;
+            break;
+        case kFeedbackPolarityInvert:
+            mFeedbackPolarityInvert = value > 0.5f;
+            break;
+        case kTempoSyncMode:
+            mTempoSyncMode = value > 0.5; // Toggle: >0.5 = synced
+            break;
+        case kSyncDivision:
+            mSyncDivision = static_cast<int>(value * (kNumSyncDivisions - 1) + 0.5); // Round to nearest
+            break;
+        case kGrid:
+            mGrid = static_cast<int>(value * (kNumGridValues - 1) + 0.5);
+            break;
+        case kGlobalDryWet:
+            mGlobalDryWet = static_cast<float>(value);
+            break;
+        case kDelayBypass:
+            mDelayBypass = value > 0.5;
+            break;
+        case kEngineMode:
+            mEngineMode = std::min(static_cast<int>(value * (kNumEngineModes - 1) + 0.5), kNumEngineModes - 1);
+            break;
+        case kDelayTimeMode:
+            mDelayTimeMode = std::min(static_cast<int>(value * (kNumDelayTimeModes - 1) + 0.5), kNumDelayTimeModes - 1);
+            break;
+        case kPitchMode:
+            mPitchMode = std::min(static_cast<int>(value * (kNumPitchModes - 1) + 0.5), kNumPitchModes - 1);
+            break;
+        case kPitchQuality:
+            mPitchQuality = std::min(static_cast<int>(value * (kNumPitchQualities - 1) + 0.5), kNumPitchQualities - 1);
+            break;
+        default:
+            // Handle discrete parameters
+            if (id >= kDiscrete1 && id <= kDiscrete24) {
+                int index = id - kDiscrete1;
+                mDiscreteParameters[index] = static_cast<float>(value);
+            }
+            // Handle macro curve type parameters
+            else if (id >= kMacroCurve1Type && id <= kMacroCurve4Type) {
+                int index = id - kMacroCurve1Type;
+                mMacroCurveTypes[index] = static_cast<int>(value * (kNumCurveTypes - 1) + 0.5);
+            }
+            // Handle macro knob parameters
+            else if (id >= kMacroKnob1 && id <= kMacroKnob8) {
+                int index = id - kMacroKnob1;
+                mMacroKnobValues[index] = static_cast<float>(value);
+
+                // CRITICAL FIX: Apply macro curves only when macro parameters change
+                // This prevents continuous parameter override in audio processing loop
+                applyMacroCurvesToTapParameters();
+            }
+            // Handle randomization and reset parameters (processed in controller)
+            else if (id == kRandomizeSeed ||
+                    id == kRandomizeAmount ||
+                    id == kRandomizeTrigger ||
+                    id == kResetTrigger) {
+                // These are handled by the controller
+            }
+            else {
+                TapParameterProcessor::processTapParameter(id, value, this);
+            }
+            break;
+    }
+}
+
+float* WaterStickProcessor::getRampTarget(Vst::ParamID id)
+{
+    // Continuous parameters that the DSP reads every sample ramp linearly;
+    // everything else changes in a step at its sample offset
+    switch (id)
+    {
+        case kInputGain:
+            return &mInputGain;
+        case kOutputGain:
+            return &mOutputGain;
+        case kFeedback:
+            return &mFeedback;
+        case kGlobalDryWet:
+            return &mGlobalDryWet;
+        default:
+            break;
+    }
+
+    int tapIndex, paramType;
+    if (TapParameterProcessor::kTapBasicRange.contains(id)) {
+        TapParameterProcessor::kTapBasicRange.getIndices(id, tapIndex, paramType);
+        if (paramType == 1) return &mTapLevel[tapIndex];
+        if (paramType == 2) return &mTapPan[tapIndex];
+    }
+    else if (TapParameterProcessor::kTapFilterRange.contains(id)) {
+        TapParameterProcessor::kTapFilterRange.getIndices(id, tapIndex, paramType);
+        if (paramType == 0) return &mTapFilterCutoff[tapIndex];
+        if (paramType == 1) return &mTapFilterResonance[tapIndex];
+    }
+    else if (TapParameterProcessor::kTapFeedbackRange.contains(id)) {
+        TapParameterProcessor::kTapFeedbackRange.getIndices(id, tapIndex, paramType);
+        return &mTapFeedbackSend[tapIndex];
+    }
+
+    return nullptr;
+}
+
+ParameterRampBank::Mapping WaterStickProcessor::getRampMapping(Vst::ParamID id)
+{
+    // Shape of each ramp target's conversion from the normalized value
+    ParameterRampBank::Mapping mapping;
+    int tapIndex, paramType;
+
+    if (id == kInputGain || id == kOutputGain) {
+        mapping.curve = ParameterRampBank::Curve::Exponential;
+    }
+    else if (id == kFeedback) {
+        mapping.curve = ParameterRampBank::Curve::Mapped;
+        mapping.toPlain = &ParameterConverter::convertFeedback;
+        mapping.toNormalized = &ParameterConverter::normalizeFeedback;
+    }
+    else if (TapParameterProcessor::kTapFilterRange.contains(id)) {
+        TapParameterProcessor::kTapFilterRange.getIndices(id, tapIndex, paramType);
+        if (paramType == 0) {
+            mapping.curve = ParameterRampBank::Curve::Exponential;
+        } else if (paramType == 1) {
+            mapping.curve = ParameterRampBank::Curve::Mapped;
+            mapping.toPlain = &ParameterConverter::convertFilterResonance;
+            mapping.toNormalized = &ParameterConverter::normalizeFilterResonance;
+        }
+    }
+
+    return mapping;
+}
+
+void WaterStickProcessor::applyStepEvents(int32 sampleOffset)
+{
+    while (const auto* event = mEventScheduler.popStepEvent(sampleOffset)) {
+        applyParameterChange(event->id, event->value);
+    }
+}
+
+void WaterStickProcessor::advanceAutomation()
+{
+    // Start ramps due on this sample, then move every ramp one sample on
+    while (const auto* event = mEventScheduler.popRampEvent(mAutomationSample)) {
+        float* target = getRampTarget(event->id);
+        float startValue = *target;
+
+        // Reuse the regular conversion path to find the ramp's end value
+        applyParameterChange(event->id, event->value);
+        float endValue = *target;
+        *target = startValue;
+
+        mParameterRamps.start(target, endValue, event->rampLength, getRampMapping(event->id));
+    }
+
+    mParameterRamps.advance();
+    mAutomationSample++;
+}
+
+void WaterStickProcessor::flushParameterEvents()
+{
+    // No audio this block: land every pending change immediately
+    while (mEventScheduler.hasPendingRampEvents()) {
+        advanceAutomation();
+    }
+    mParameterRamps.finish();
+    applyStepEvents(std::numeric_limits<int32>::max());
+}
+
+void WaterStickProcessor::updateSegmentParameters()
+{
+    // Mid-block step events: refresh delay-side state without re-running the
+    // once-per-block discrete smoothing in updateParameters()
+    updateDelayParameters();
+    checkTapStateChangesAndClearBuffers();
+    checkBypassStateChanges();
+    updateTempoSyncDelayTimes();
+}
+
+void WaterStickProcessor::updateTempoSyncDelayTimes()
+{
+    if (mTempoSyncMode && mTempoSyncParametersChanged) {
+        // Update tap distribution with current tempo
+        mTapDistribution.updateTempo(mTempoSync);
+
+        UnifiedTapEngines* unified = mUnifiedEngines.load(std::memory_order_acquire);
+        SpeedBasedTapEngines* speedBased = mSpeedBasedEngines.load(std::memory_order_acquire);
+
+        // Update all tap delay times only when parameters changed
+        for (int i = 0; i < NUM_TAPS; i++) {
+            float tapDelayTime = mTapDistribution.getTapDelayTime(i);
+            if (speedBased) {
+                speedBased->left[i].setDelayTime(tapDelayTime);
+                speedBased->right[i].setDelayTime(tapDelayTime);
+            }
+
+            // Update unified delay lines (production system)
+            if (unified) {
+                unified->left[i].setDelayTime(tapDelayTime);
+                unified->right[i].setDelayTime(tapDelayTime);
+            }
+        }
+
+        // Update legacy delay lines too
+        if (speedBased) {
+            float finalDelayTime = mTempoSync.getDelayTime();
+            speedBased->delayLeft.setDelayTime(finalDelayTime);
+            speedBased->delayRight.setDelayTime(finalDelayTime);
+        }
+
+        // Reset the change flag
+        mTempoSyncParametersChanged = false;
+    }
 }
 
 tresult PLUGIN_API WaterStickProcessor::getState(IBStream* state)
@@ -2886,6 +3564,11 @@ tresult PLUGIN_API WaterStickProcessor::getState(IBStream* state)
         streamer.writeFloat(mTapFeedbackSend[i]);
     }
 
+    streamer.writeInt32(mEngineMode);
+    streamer.writeInt32(mDelayTimeMode);
+    streamer.writeInt32(mPitchMode);
+    streamer.writeInt32(mPitchQuality);
+
     return kResultOk;
 }
 
@@ -2916,6 +3599,26 @@ tresult PLUGIN_API WaterStickProcessor::setState(IBStream* state)
     }
 }
 
+tresult PLUGIN_API WaterStickProcessor::notify(Vst::IMessage* message)
+{
+    if (!message) {
+        return kInvalidArgument;
+    }
+
+    // The controller's edits reach process() later; allocate the classes
+    // they need now rather than at the next setup
+    if (strcmp(message->getMessageID(), kPitchClassesMessage) == 0) {
+        int64 count = 0;
+        if (message->getAttributes() && message->getAttributes()->getInt(kPitchClassesAttr, count) == kResultOk) {
+            allocatePitchClassBuffers(static_cast<int>(count));
+            return kResultOk;
+        }
+        return kResultFalse;
+    }
+
+    return AudioEffect::notify(message);
+}
+
 tresult WaterStickProcessor::readLegacyProcessorState(IBStream* state)
 {
     IBStreamer streamer(state, kLittleEndian);
@@ -2969,8 +3672,39 @@ tresult WaterStickProcessor::readLegacyProcessorState(IBStream* state)
         mTapEnabledPrevious[i] = mTapEnabled[i];
     }
 
+    // Engine mode (appended field; older states run the classic engine)
+    Steinberg::int32 engineMode;
+    if (!streamer.readInt32(engineMode) || engineMode < 0 || engineMode >= kNumEngineModes) {
+        engineMode = kEngineMode_Classic;
+    }
+    mEngineMode = engineMode;
+
+    // Delay time mode (appended field; older states crossfade)
+    Steinberg::int32 delayTimeMode;
+    if (!streamer.readInt32(delayTimeMode) || delayTimeMode < 0 || delayTimeMode >= kNumDelayTimeModes) {
+        delayTimeMode = kDelayTimeMode_Crossfade;
+    }
+    mDelayTimeMode = delayTimeMode;
+
+    // Pitch mode (appended field; older states shift per tap)
+    Steinberg::int32 pitchMode;
+    if (!streamer.readInt32(pitchMode) || pitchMode < 0 || pitchMode >= kNumPitchModes) {
+        pitchMode = kPitchMode_PerTap;
+    }
+    mPitchMode = pitchMode;
+
+    // Pitch quality (appended field; older states interpolate linearly)
+    Steinberg::int32 pitchQuality;
+    if (!streamer.readInt32(pitchQuality) || pitchQuality < 0 || pitchQuality >= kNumPitchQualities) {
+        pitchQuality = kPitchQuality_Linear;
+    }
+    mPitchQuality = pitchQuality;
+
     mDelayBypassPrevious = mDelayBypass;
 
+    // Buffers for the intervals the loaded taps share, before they play
+    allocatePitchClassBuffers();
+
     return kResultOk;
 }
 
@@ -3372,8 +4106,10 @@ void WaterStickProcessor::logPitchProcessingStats() const
             std::ostringstream ss;
             ss << "Tap " << (i + 1) << " pitch processing stats:";
             PitchDebug::logMessage(ss.str());
-            mTapDelayLinesL[i].logProcessingStats();
-            mTapDelayLinesR[i].logProcessingStats();
+            if (const SpeedBasedTapEngines* speedBased = mSpeedBasedEngines.load(std::memory_order_acquire)) {
+                speedBased->left[i].logProcessingStats();
+                speedBased->right[i].logProcessingStats();
+            }
         }
     }
 }
@@ -3398,22 +4134,73 @@ void WaterStickProcessor::clearPerformanceProfile()
 void WaterStickProcessor::enableUnifiedDelayLines(bool enable)
 {
     if (mUseUnifiedDelayLines != enable) {
+        // The engine is built and published before the flag selects it;
+        // freshly built engines start clean
+        allocateLegacyEngines(mUseDecoupledArchitecture, enable);
         mUseUnifiedDelayLines = enable;
 
-        // Reset all delay lines when switching systems for clean transition
+        if (PitchDebug::isLoggingEnabled()) {
+            PitchDebug::logMessage(enable ? "Switched to unified delay line system" : "Switched to legacy delay line system");
+        }
+    }
+}
+
+void WaterStickProcessor::allocateLegacyEngines(bool useDecoupled, bool useUnified)
+{
+    if (useDecoupled) return;
+
+    if (useUnified && !mUnifiedEnginesStorage) {
+        auto engines = std::make_unique<UnifiedTapEngines>();
         for (int i = 0; i < NUM_TAPS; i++) {
-            mTapDelayLinesL[i].reset();
-            mTapDelayLinesR[i].reset();
-            mUnifiedTapDelayLinesL[i].reset();
-            mUnifiedTapDelayLinesR[i].reset();
+            float tapDelayTime = mTapDistribution.getTapDelayTime(i);
+            engines->left[i].initialize(mSampleRate, MAX_TAP_DELAY_SECONDS);
+            engines->right[i].initialize(mSampleRate, MAX_TAP_DELAY_SECONDS);
+            engines->left[i].setDelayTime(tapDelayTime);
+            engines->right[i].setDelayTime(tapDelayTime);
         }
+        mUnifiedEngines.store(engines.get(), std::memory_order_release);
+        mUnifiedEnginesStorage = std::move(engines);
+    }
 
-        if (PitchDebug::isLoggingEnabled()) {
-            PitchDebug::logMessage(enable ? "Switched to unified delay line system" : "Switched to legacy delay line system");
+    if (!useUnified && !mSpeedBasedEnginesStorage) {
+        auto engines = std::make_unique<SpeedBasedTapEngines>();
+        engines->delayLeft.initialize(mSampleRate, 2.0);
+        engines->delayRight.initialize(mSampleRate, 2.0);
+        for (int i = 0; i < NUM_TAPS; i++) {
+            float tapDelayTime = mTapDistribution.getTapDelayTime(i);
+            engines->left[i].initialize(mSampleRate, MAX_TAP_DELAY_SECONDS);
+            engines->right[i].initialize(mSampleRate, MAX_TAP_DELAY_SECONDS);
+            engines->left[i].setDelayTime(tapDelayTime);
+            engines->right[i].setDelayTime(tapDelayTime);
         }
+        mSpeedBasedEngines.store(engines.get(), std::memory_order_release);
+        mSpeedBasedEnginesStorage = std::move(engines);
     }
 }
 
+void WaterStickProcessor::allocatePitchClassBuffers(int count)
+{
+    // One class per distinct interval of the enabled taps in Shared mode;
+    // the systems add any the audio thread has wanted since the last call
+    int classes = 0;
+    if (mPitchMode == kPitchMode_Shared) {
+        for (int i = 0; i < NUM_TAPS; i++) {
+            int semitones = std::max(-12, std::min(12, mTapPitchShift[i]));
+            if (!mTapEnabled[i] || semitones == 0) continue;
+
+            bool seen = false;
+            for (int j = 0; j < i && !seen; j++) {
+                seen = mTapEnabled[j] && std::max(-12, std::min(12, mTapPitchShift[j])) == semitones;
+            }
+            classes += seen ? 0 : 1;
+        }
+    }
+
+    classes = std::max(classes, count);
+    mDecoupledDelaySystemL.allocatePitchClassBuffers(classes);
+    mDecoupledDelaySystemR.allocatePitchClassBuffers(classes);
+}
+
 bool WaterStickProcessor::isUsingUnifiedDelayLines() const
 {
     return mUseUnifiedDelayLines;
@@ -3434,8 +4221,10 @@ void WaterStickProcessor::logUnifiedDelayLineStats() const
                     ss.clear();
                     ss << "Tap " << i << " Stats:";
                     PitchDebug::logMessage(ss.str());
-                    mUnifiedTapDelayLinesL[i].logProcessingStats();
-                    mUnifiedTapDelayLinesR[i].logProcessingStats();
+                    if (const UnifiedTapEngines* unified = mUnifiedEngines.load(std::memory_order_acquire)) {
+                        unified->left[i].logProcessingStats();
+                        unified->right[i].logProcessingStats();
+                    }
                 }
             }
         }
@@ -3446,18 +4235,14 @@ void WaterStickProcessor::logUnifiedDelayLineStats() const
 void WaterStickProcessor::enableDecoupledDelayLines(bool enable)
 {
     if (mUseDecoupledArchitecture != enable) {
+        // Fallback engines are built and published before they are selected
+        allocateLegacyEngines(enable, mUseUnifiedDelayLines);
         mUseDecoupledArchitecture = enable;
 
         // Reset all systems when switching for clean transition
         if (enable) {
             mDecoupledDelaySystemL.reset();
             mDecoupledDelaySystemR.reset();
-        } else {
-            // Reset fallback systems
-            for (int i = 0; i < NUM_TAPS; i++) {
-                mUnifiedTapDelayLinesL[i].reset();
-                mUnifiedTapDelayLinesR[i].reset();
-            }
         }
 
         if (PitchDebug::isLoggingEnabled()) {
@@ -5,8 +5,14 @@
 #include "pluginterfaces/vst/ivstprocesscontext.h"
 #include "WaterStickParameters.h"
 #include "ThreeSistersFilter.h"
+#include "ThreeSistersFilterBank.h"
 #include "DecoupledDelayArchitecture.h"
+#include "Instrumentation.h"
+#include "TailTracker.h"
+#include "TapParameterTimeline.h"
+#include "ParameterEventScheduler.h"
 #include <vector>
+#include <array>
 #include <cmath>
 #include <algorithm>
 #include <chrono>
@@ -251,14 +257,17 @@ public:
 private:
     static constexpr int NUM_BUFFERS = 3;
     ParameterState mParameterBuffers[NUM_BUFFERS];
-    std::atomic<int> mWriteIndex{0};
-    std::atomic<int> mReadIndex{0};
+
+    // Indices written by the producer and by the audio thread live on
+    // separate cache lines, so neither side's stores evict the other's
+    alignas(CACHE_LINE_SIZE) std::atomic<int> mWriteIndex{0};
     std::atomic<uint64_t> mGlobalVersion{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int> mReadIndex{0};
 
     // PHASE 3: Macro parameter triple buffering
     MacroParameterBatch mMacroBatches[NUM_BUFFERS];
-    std::atomic<int> mMacroWriteIndex{0};
-    std::atomic<int> mMacroReadIndex{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int> mMacroWriteIndex{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int> mMacroReadIndex{0};
 
     void calculatePitchRatio(ParameterState& state);
     int getNextIndex(int currentIndex) const;
@@ -292,11 +301,14 @@ public:
     double getMaxProcessingTime() const;
 
 private:
-    std::chrono::high_resolution_clock::time_point mProcessingStartTime;
-    std::atomic<bool> mEmergencyBypass{false};
-    std::atomic<int> mTimeoutCount{0};
-    std::atomic<int> mRecoveryCount[4]{0, 0, 0, 0};
-    std::atomic<double> mMaxProcessingTime{0.0};
+    // Owned by one delay line and used only on the audio thread. The
+    // timeout checks measure within one sample, so they read the clock only
+    // in instrumented builds (Instrumentation.h) and never fire otherwise
+    BlockTimer mProcessingTimer;
+    bool mEmergencyBypass = false;
+    int mTimeoutCount = 0;
+    int mRecoveryCount[4] = {0, 0, 0, 0};
+    double mMaxProcessingTime = 0.0;
 
     double mSampleRate;
 
@@ -330,8 +342,8 @@ private:
     // Core buffer system - single unified buffer
     std::vector<float> mBuffer;
     int mBufferSize;
-    std::atomic<int> mWriteIndex{0};
-    std::atomic<float> mReadPosition{0.0f};
+    int mWriteIndex = 0;          // Audio thread only
+    float mReadPosition = 0.0f;
     double mSampleRate;
 
     // Safety margins and bounds
@@ -403,9 +415,8 @@ protected:
     int mStabilityCounter;
     int mStabilityThreshold;
 
-    // Crossfade control
-    int mCrossfadeLength;
-    int mCrossfadePosition;
+    // Crossfade control (raised-cosine table walk)
+    FadeRamp mCrossfadeRamp;
     float mCrossfadeGainA;
     float mCrossfadeGainB;
 
@@ -476,8 +487,8 @@ private:
     mutable int mProcessingTimeouts;               // Count of processing timeouts
     mutable int mInfiniteLoopPrevention;           // Count of infinite loop preventions
 
-    // High-resolution timing for dropout detection
-    mutable std::chrono::high_resolution_clock::time_point mProcessingStartTime;
+    // Per-sample timing for dropout detection; instrumented builds only
+    mutable BlockTimer mProcessingTimer;
 
     // Core speed-based processing methods
     void updatePitchRatio();
@@ -590,11 +601,20 @@ public:
     // IAudioProcessor
     Steinberg::tresult PLUGIN_API setupProcessing(Steinberg::Vst::ProcessSetup& newSetup) SMTG_OVERRIDE;
     Steinberg::tresult PLUGIN_API process(Steinberg::Vst::ProcessData& data) SMTG_OVERRIDE;
+    Steinberg::tresult PLUGIN_API canProcessSampleSize(Steinberg::int32 symbolicSampleSize) SMTG_OVERRIDE;
+    Steinberg::uint32 PLUGIN_API getTailSamples() SMTG_OVERRIDE;
+
+    // Times a tap's parameter timeline filled within the delay range and
+    // gave up resolution (see TapParameterTimeline); any thread
+    Steinberg::uint32 getTimelineCompactions() const { return mTimelineCompactions.load(); }
 
     // IComponent
     Steinberg::tresult PLUGIN_API getState(Steinberg::IBStream* state) SMTG_OVERRIDE;
     Steinberg::tresult PLUGIN_API setState(Steinberg::IBStream* state) SMTG_OVERRIDE;
 
+    // IConnectionPoint
+    Steinberg::tresult PLUGIN_API notify(Steinberg::Vst::IMessage* message) SMTG_OVERRIDE;
+
 private:
     // State version constants
     static constexpr Steinberg::int32 kStateVersionLegacy = 0;  // Legacy unversioned state
@@ -607,6 +627,31 @@ private:
     void checkBypassStateChanges();
     void processDelaySection(float inputL, float inputR, float& outputL, float& outputR);
 
+    // Block rendering for the decoupled architecture; returns samples rendered
+    int processDecoupledSubBlock(const float* inputL, const float* inputR, float* wetL, float* wetR, int maxSamples);
+    void prepareBlockProcessing(int maxBlockSize);
+
+    // Per-sample pieces shared by the block and per-sample paths
+    float advanceTapFade(int tap, bool& fadeOutComplete);
+    void storeFeedbackSignal();
+    void applyDelayFade(float& outputL, float& outputR);
+
+    // Block forms of the fades, numSamples gains each; renderTapFade
+    // returns true when a fade-out completed within the block
+    bool renderTapFade(int tap, float* gains, int numSamples);
+    void renderDelayFade(float* gains, int numSamples);
+
+    // Build and publish the legacy engines a selection needs; never called
+    // on the audio thread. Engines are freed only in setupProcessing().
+    void allocateLegacyEngines(bool useDecoupled, bool useUnified);
+
+    // Pitch class buffers of the decoupled systems for the current taps,
+    // at least count of them, plus any the audio thread asked for. Called on
+    // setup, state load and the controller's kPitchClassesMessage, never on
+    // the audio thread
+    void allocatePitchClassBuffers(int count = 0);
+    void panTapOutput(float tapOutputL, float tapOutputR, float pan, float& tapMainL, float& tapMainR) const;
+
     // ENHANCED FEEDBACK SYSTEM METHODS
     // ================================
     void initializeFeedbackSystem();
@@ -664,12 +709,26 @@ private:
     float mGlobalDryWet;
     bool mDelayBypass;
 
+    // Engine mode (EngineModes); the block path adopts a new mode at the
+    // start of a sub-block and clears the delay when it does
+    int mEngineMode;
+    int mActiveEngineMode;
+
+    // Delay time mode (DelayTimeModes), applied to both channel systems at
+    // the start of a sub-block; a change resets the taps
+    int mDelayTimeMode;
+
+    // Pitch mode (PitchModes), applied like the delay time mode; only taps
+    // that move between buffers reset
+    int mPitchMode;
+
+    // Pitch quality (PitchQualities), applied like the pitch mode
+    int mPitchQuality;
+
     bool mDelayBypassPrevious;
     bool mDelayFadingOut;
     bool mDelayFadingIn;
-    int mDelayFadeRemaining;
-    int mDelayFadeTotalLength;
-    float mDelayFadeGain;
+    FadeRamp mDelayFade;            // Exponential wet fade around bypass
 
     // Per-tap parameters
     bool mTapEnabled[16];
@@ -688,36 +747,95 @@ private:
     // Per-tap feedback send parameters
     float mTapFeedbackSend[16];
 
-    // Fade-out state for smooth tap disengagement
+    // Fade state for smooth tap disengagement and engagement
     bool mTapFadingOut[16];        // True when tap is fading out
-    int mTapFadeOutRemaining[16];  // Samples remaining in fade-out
-    int mTapFadeOutTotalLength[16]; // Total fade-out length for calculation
-
-    // Fade-in state for smooth tap engagement
     bool mTapFadingIn[16];         // True when tap is fading in
-    int mTapFadeInRemaining[16];   // Samples remaining in fade-in
-    int mTapFadeInTotalLength[16]; // Total fade-in length for calculation
-
-    float mTapFadeGain[16];        // Current fade gain (0.0 to 1.0)
-
-    // DSP
-    DualDelayLine mDelayLineL;  // Keep original for legacy
-    DualDelayLine mDelayLineR;  // Keep original for legacy
+    FadeRamp mTapFade[16];         // Exponential gain ramp of the running fade
+
+    // Sleep of silent taps: a tap whose filter input and output stay below
+    // DecoupledDelaySystem::SLEEP_THRESHOLD for TAP_SLEEP_HOLD_SECONDS is
+    // not pitched, filtered or mixed until its delay output has energy again
+    static constexpr float TAP_SLEEP_HOLD_SECONDS = 0.25f;
+    uint32_t mSleepingTaps;        // Bit per tap
+    int mTapQuietSamples[16];      // Saturates at the hold
+
+    // Idle engine: while the input is silent and the tail has decayed
+    // (TailTracker) process() outputs flagged silence without running the
+    // engine. Waking resets the delay, so audio from before the idle stretch
+    // is never heard again (no enabled head could still reach it anyway)
+    TailTracker mTailTracker;
+    bool mEngineIdle;
+    MonitorCounter<Steinberg::uint32> mTailSamples{0};   // Estimate published for getTailSamples()
+    void updateTailTracking();
+    void wakeEngine();
 
     // Multi-tap delay lines (16 taps, stereo)
     static const int NUM_TAPS = 16;
-    SpeedBasedDelayLine mTapDelayLinesL[NUM_TAPS];  // LEGACY: Emergency fallback only
-    SpeedBasedDelayLine mTapDelayLinesR[NUM_TAPS];  // LEGACY: Emergency fallback only
 
-    // Phase 4: PRODUCTION unified delay lines (47.9x performance improvement)
-    UnifiedPitchDelayLine mUnifiedTapDelayLinesL[NUM_TAPS];  // Left channel unified delay lines (LEGACY)
-    UnifiedPitchDelayLine mUnifiedTapDelayLinesR[NUM_TAPS];  // Right channel unified delay lines (LEGACY)
-    bool mUseUnifiedDelayLines;                              // Flag to switch between old/new implementations
+    // LEGACY engines, allocated only while selected: the unified lines when
+    // the decoupled architecture is off, the speed-based lines when unified
+    // lines are off too. They are built off the audio thread and published
+    // through an atomic pointer; the audio thread skips an engine it cannot
+    // see yet and never allocates or frees one.
+    struct UnifiedTapEngines {
+        UnifiedPitchDelayLine left[NUM_TAPS];
+        UnifiedPitchDelayLine right[NUM_TAPS];
+    };
+
+    struct SpeedBasedTapEngines {
+        DualDelayLine delayLeft;                              // Original single-tap lines (only kept in sync)
+        DualDelayLine delayRight;
+        SpeedBasedDelayLine left[NUM_TAPS];
+        SpeedBasedDelayLine right[NUM_TAPS];
+    };
+
+    static constexpr double MAX_TAP_DELAY_SECONDS = 20.0;
+
+    // Phase 4: unified delay lines (LEGACY)
+    std::unique_ptr<UnifiedTapEngines> mUnifiedEnginesStorage;
+    std::atomic<UnifiedTapEngines*> mUnifiedEngines{nullptr};
+    std::atomic<bool> mUseUnifiedDelayLines;                 // Flag to switch between old/new implementations
+
+    // LEGACY: Emergency fallback only
+    std::unique_ptr<SpeedBasedTapEngines> mSpeedBasedEnginesStorage;
+    std::atomic<SpeedBasedTapEngines*> mSpeedBasedEngines{nullptr};
 
     // Phase 5: DECOUPLED DELAY + PITCH ARCHITECTURE (Production-ready solution)
     DecoupledDelaySystem mDecoupledDelaySystemL;             // Left channel decoupled system (PRIMARY)
     DecoupledDelaySystem mDecoupledDelaySystemR;             // Right channel decoupled system (PRIMARY)
-    bool mUseDecoupledArchitecture;                          // Feature flag for decoupled system
+    std::atomic<bool> mUseDecoupledArchitecture;             // Feature flag for decoupled system
+
+    // Block scratch for the decoupled path (sized from maxSamplesPerBlock)
+    int mMaxBlockSize;
+    std::vector<float> mTapBlockBufferL;                     // NUM_TAPS x mMaxBlockSize
+    std::vector<float> mTapBlockBufferR;
+    std::array<float*, NUM_TAPS> mTapBlockOutputsL{};
+    std::array<float*, NUM_TAPS> mTapBlockOutputsR{};
+    std::vector<float> mTapLevelGains;                       // NUM_TAPS x mMaxBlockSize gain lanes,
+    std::vector<float> mTapSendGains;                        // zero for taps that are off
+    std::vector<float> mTapMainGainsL;                       // Pan x fade per output side
+    std::vector<float> mTapMainGainsR;
+    std::vector<float> mBlockDelayInputL;                    // Input + feedback into the delay
+    std::vector<float> mBlockDelayInputR;
+    std::vector<float> mBlockSumL;                           // Panned tap sum
+    std::vector<float> mBlockSumR;
+    std::vector<float> mBlockFeedbackSendL;                  // Post-effects feedback sends
+    std::vector<float> mBlockFeedbackSendR;
+    std::vector<float> mBlockFeedbackPreSendL;               // Pre-effects feedback sends
+    std::vector<float> mBlockFeedbackPreSendR;
+    std::vector<float> mBlockWetL;
+    std::vector<float> mBlockWetR;
+    std::vector<float> mBlockEngineInputL;                   // Sample64 input narrowed for the engine, host block sized
+    std::vector<float> mBlockEngineInputR;
+    std::vector<float> mBlockInputGain;                      // Per-sample lanes of automated globals
+    std::vector<float> mBlockFeedbackGain;
+    std::vector<float> mBlockOutputGain;
+    std::vector<float> mBlockDryWet;
+    std::vector<float> mBlockFadeGain;                       // Tap or bypass fade ramp
+
+    // Sample-accurate automation
+    ParameterEventScheduler mEventScheduler;
+    ParameterRampBank mParameterRamps;
 
     TempoSync mTempoSync;
     TapDistribution mTapDistribution;
@@ -726,6 +844,7 @@ private:
     // Per-tap filters (16 taps, stereo)
     ThreeSistersFilter mTapFiltersL[NUM_TAPS];  // Left channel filters
     ThreeSistersFilter mTapFiltersR[NUM_TAPS];  // Right channel filters
+    ThreeSistersFilterBank mTapFilterBank;      // SIMD filters for the block path (all taps, both channels)
 
     // ENHANCED FEEDBACK SYSTEM ARCHITECTURE
     // =================================
@@ -770,26 +889,43 @@ private:
     bool mTempoSyncParametersChanged;
 
     // Parameter capture for delay propagation
-    struct ParameterSnapshot {
-        float level;
-        float pan;
-        float filterCutoff;
-        float filterResonance;
-        int filterType;
-        int pitchShift;
-        float feedbackSend;
-        bool enabled;
-    };
+    using ParameterSnapshot = TapParameterTimeline::Snapshot;
 
-    // Store parameter snapshots for each tap (circular buffer approach)
-    static const int PARAM_HISTORY_SIZE = 8192;  // Enough for ~185ms at 44.1kHz
-    ParameterSnapshot mTapParameterHistory[16][PARAM_HISTORY_SIZE];
-    int mParameterHistoryWriteIndex;
+    // Per-tap change-log timelines, indexed by a running sample clock; their
+    // horizon is the longest delay plus a block
+    TapParameterTimeline mTapParameterTimelines[16];
+    int64_t mParameterClock;
+    MonitorCounter<Steinberg::uint32> mTimelineCompactions{0};
 
     void captureCurrentParameters();
-    ParameterSnapshot getHistoricParameters(int tapIndex, float delayTimeSeconds) const;
+
+    // Sample-accurate automation: step events split the block into segments,
+    // ramps advance once per sample ahead of captureCurrentParameters()
+    Steinberg::int32 mAutomationSample;
+    void applyParameterChange(Steinberg::Vst::ParamID id, Steinberg::Vst::ParamValue value);
+    float* getRampTarget(Steinberg::Vst::ParamID id);
+    static ParameterRampBank::Mapping getRampMapping(Steinberg::Vst::ParamID id);
+    void applyStepEvents(Steinberg::int32 sampleOffset);
+    void advanceAutomation();
+    void flushParameterEvents();
+
+    // Host I/O in either sample size (Sample32 or Sample64). Only the dry
+    // signal and the final dry/wet sum use that precision; the wet signal is
+    // rendered in float either way
+    template <typename SampleType>
+    Steinberg::tresult processBuffers(Steinberg::Vst::ProcessData& data, SampleType** inputs, SampleType** outputs);
+    template <typename SampleType>
+    void processDecoupledSegment(const SampleType* inputL, const SampleType* inputR, SampleType* outputL, SampleType* outputR,
+                                 Steinberg::int32 start, Steinberg::int32 end);
+    template <typename SampleType>
+    void processLegacySegment(const SampleType* inputL, const SampleType* inputR, SampleType* outputL, SampleType* outputR,
+                              Steinberg::int32 start, Steinberg::int32 end);
+    ParameterSnapshot getHistoricParameters(int tapIndex, float delayTimeSeconds, int extraSamplesBack = 0);
 
     void updateParameters();
+    void updateDelayParameters();
+    void updateSegmentParameters();
+    void updateTempoSyncDelayTimes();
     void checkTempoSyncParameterChanges();
 
     // Real-time curve evaluation and parameter smoothing
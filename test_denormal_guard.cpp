@@ -0,0 +1,172 @@
+// Flush-to-zero scope (DenormalGuard.h) on a 30 second decaying tail.
+//
+// Four taps of the decoupled delay system run through the tap filter bank
+// and a damping one-pole back into the delay at a loop gain of 0.7: a
+// noise burst, then 30 seconds of silence while the tail decays. Below
+// about -750 dBFS it turns subnormal, and with a loop gain above one half
+// rounding keeps it there. The tail is rendered without and with a guard
+// around every block, the way process() holds one; cost per sample is
+// reported in five second windows. With the guard no subnormal may reach
+// the delay or the output, and the control register must be back in its
+// previous mode once the guard is gone.
+
+#include "source/WaterStick/DecoupledDelayArchitecture.h"
+#include "source/WaterStick/ThreeSistersFilterBank.h"
+#include "source/WaterStick/WaterStickParameters.h"
+#include "source/WaterStick/DenormalGuard.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <sstream>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr double MAX_DELAY_SECONDS = 20.0;
+constexpr int BLOCK_SIZE = 256;
+constexpr int NUM_TAPS = DecoupledDelaySystem::NUM_TAPS;
+constexpr double BURST_SECONDS = 0.5;
+constexpr double WINDOW_SECONDS = 5.0;
+constexpr int NUM_WINDOWS = 6;   // 30 seconds of tail
+
+constexpr int LOOP_TAPS = 4;
+constexpr float TAP_DELAYS[LOOP_TAPS] = {0.021f, 0.029f, 0.037f, 0.045f};
+constexpr float LOOP_GAIN = 0.7f;
+constexpr float DAMPING_COEFF = 0.99f;
+
+bool isSubnormal(float x) { return std::fpclassify(x) == FP_SUBNORMAL; }
+
+struct Loop {
+    DecoupledDelaySystem system;
+    ThreeSistersFilterBank filters;
+    std::vector<float> delayInput = std::vector<float>(BLOCK_SIZE);
+    std::vector<float> wet = std::vector<float>(BLOCK_SIZE);
+    std::vector<float> buffer = std::vector<float>(NUM_TAPS * BLOCK_SIZE);
+    std::array<float*, NUM_TAPS> taps{};
+    uint32_t loopTaps = 0;
+    float damping = 0.0f;
+
+    Loop() {
+        system.initialize(SAMPLE_RATE, MAX_DELAY_SECONDS);
+        system.prepareBlockProcessing(BLOCK_SIZE);
+        filters.prepare(BLOCK_SIZE);
+        filters.setSampleRate(SAMPLE_RATE);
+        for (int tap = 0; tap < NUM_TAPS; ++tap) taps[tap] = buffer.data() + tap * BLOCK_SIZE;
+        for (int tap = 0; tap < LOOP_TAPS; ++tap) {
+            system.setTapDelayTime(tap, TAP_DELAYS[tap]);
+            system.setTapEnabled(tap, true);
+            filters.setParameters(tap, 2000.0 + 1500.0 * tap, 0.3, kFilterType_LowPass);
+            loopTaps |= 1u << tap;
+        }
+        system.reset();
+    }
+
+    // The processor's order: first input sample, read, filter, close the loop
+    void block(const float* input) {
+        delayInput[0] = input[0] + LOOP_GAIN * damping;
+        system.writeBlock(delayInput.data(), 1);
+        system.readBlock(BLOCK_SIZE, taps.data());
+        filters.processBlock(taps.data(), nullptr, loopTaps, BLOCK_SIZE);
+
+        for (int i = 0; i < BLOCK_SIZE; ++i) {
+            wet[i] = 0.25f * (taps[0][i] + taps[1][i] + taps[2][i] + taps[3][i]);
+            damping = (1.0f - DAMPING_COEFF) * wet[i] + DAMPING_COEFF * damping;
+            if (i + 1 < BLOCK_SIZE) delayInput[i + 1] = input[i + 1] + LOOP_GAIN * damping;
+        }
+        system.writeBlock(delayInput.data() + 1, BLOCK_SIZE - 1);
+    }
+};
+
+struct Result {
+    std::array<double, NUM_WINDOWS> nsPerSample{};
+    long subnormals = 0;   // Written into the delay or heard
+};
+
+Result run(bool guarded) {
+    Loop loop;
+    Result result;
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::vector<float> input(BLOCK_SIZE);
+
+    const long burst = static_cast<long>(BURST_SECONDS * SAMPLE_RATE);
+    const long window = static_cast<long>(WINDOW_SECONDS * SAMPLE_RATE);
+    const long total = burst + NUM_WINDOWS * window;
+
+    auto windowStart = std::chrono::steady_clock::now();
+    long nextWindow = burst + window;
+    for (long sample = 0; sample < total; sample += BLOCK_SIZE) {
+        for (int i = 0; i < BLOCK_SIZE; ++i) input[i] = sample + i < burst ? noise(rng) : 0.0f;
+        if (sample < burst) windowStart = std::chrono::steady_clock::now();
+
+        if (guarded) {
+            DenormalGuard guard;
+            loop.block(input.data());
+        } else {
+            loop.block(input.data());
+        }
+
+        for (int i = 0; i < BLOCK_SIZE; ++i) {
+            result.subnormals += isSubnormal(loop.delayInput[i]) || isSubnormal(loop.wet[i]);
+        }
+
+        if (sample + BLOCK_SIZE >= nextWindow && nextWindow <= total) {
+            auto now = std::chrono::steady_clock::now();
+            int index = static_cast<int>((nextWindow - burst) / window) - 1;
+            result.nsPerSample[index] = std::chrono::duration<double, std::nano>(now - windowStart).count() / window;
+            windowStart = now;
+            nextWindow += window;
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+int main() {
+    bool passed = true;
+
+    bool flushingBefore = DenormalGuard::isFlushing();
+    bool flushingInside;
+    {
+        DenormalGuard guard;
+        flushingInside = DenormalGuard::isFlushing();
+    }
+    bool restored = DenormalGuard::isFlushing() == flushingBefore;
+
+    std::cout << "Denormal guard (" << (DenormalGuard::ENABLED ? "flush to zero available" : "no flush mode on this target")
+              << ")" << std::endl;
+    std::cout << "  " << std::left << std::setw(38) << "flushing inside / restored after"
+              << (flushingInside ? "yes" : "no") << " / " << (restored ? "yes" : "NO") << std::endl;
+    passed = passed && restored && flushingInside == DenormalGuard::ENABLED;
+
+    Result plain = run(false);
+    Result guarded = run(true);
+
+    std::cout << "  " << std::left << std::setw(14) << "tail window" << std::setw(16) << "plain ns/smp"
+              << std::setw(16) << "guarded ns/smp" << "speedup" << std::endl;
+    for (int w = 0; w < NUM_WINDOWS; ++w) {
+        std::ostringstream label;
+        label << static_cast<int>(w * WINDOW_SECONDS) << "-" << static_cast<int>((w + 1) * WINDOW_SECONDS) << " s";
+        std::cout << "  " << std::left << std::setw(14) << label.str() << std::fixed << std::setprecision(1)
+                  << std::setw(16) << plain.nsPerSample[w] << std::setw(16) << guarded.nsPerSample[w]
+                  << std::setprecision(2) << plain.nsPerSample[w] / guarded.nsPerSample[w] << "x" << std::endl;
+    }
+
+    bool clean = !DenormalGuard::ENABLED || guarded.subnormals == 0;
+    passed = passed && clean;
+    std::cout << "  " << std::left << std::setw(38) << "subnormal samples, plain / guarded"
+              << plain.subnormals << " / " << guarded.subnormals << (clean ? "" : "  (wrong)") << std::endl;
+
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+// Table-driven fade envelopes (FadeEngine.h).
+//
+// Compares every ramp gain against the exact raised-cosine and exponential
+// curves at the fade lengths the processor uses and fails past the bounds
+// documented in FadeEngine.h. Also checks that fade-out and fade-in pairs
+// sum to unity, that block rendering matches per-sample stepping (including
+// the unity tail after a fade ends), and that the SIMD gain multiply matches
+// the scalar product. Per-sample cost is reported next to cosf / std::exp.
+
+#include "source/WaterStick/FadeEngine.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <string>
+
+using namespace WaterStick;
+
+namespace {
+
+using Curve = FadeRamp::Curve;
+using Direction = FadeRamp::Direction;
+
+const int LENGTHS[] = {16, 64, 512, 2048, 2400, 24000};
+
+double exactFadeOut(Curve curve, double x) {
+    return curve == Curve::RaisedCosine ? 0.5 * (1.0 + std::cos(x * 3.14159265358979323846))
+                                        : std::exp(-6.0 * x);
+}
+
+double maxCurveError(Curve curve, Direction direction) {
+    double worst = 0.0;
+    for (int length : LENGTHS) {
+        FadeRamp ramp;
+        ramp.start(curve, direction, length);
+        for (int k = 0; k < length; ++k) {
+            double exact = exactFadeOut(curve, static_cast<double>(k) / length);
+            if (direction == Direction::In) exact = 1.0 - exact;
+            worst = std::max(worst, std::abs(ramp.next() - exact));
+        }
+        if (ramp.isActive()) return 1.0;  // Must end after exactly length samples
+    }
+    return worst;
+}
+
+bool pairSumsToUnity(Curve curve) {
+    FadeRamp out, in;
+    out.start(curve, Direction::Out, 777);
+    in.start(curve, Direction::In, 777);
+    while (out.isActive()) {
+        if (std::abs(out.next() + in.next() - 1.0f) > 1e-6f) return false;
+    }
+    return !in.isActive();
+}
+
+bool blockMatchesSteps() {
+    constexpr int BLOCK = 64;
+    FadeRamp stepped, blocked;
+    stepped.start(Curve::Exponential, Direction::In, 300);
+    blocked.start(Curve::Exponential, Direction::In, 300);
+
+    std::vector<float> gains(BLOCK);
+    for (int b = 0; b < 6; ++b) {
+        int covered = blocked.render(gains.data(), BLOCK);
+        if (covered != std::min(BLOCK, std::max(0, 300 - b * BLOCK))) return false;
+        for (int i = 0; i < BLOCK; ++i) {
+            float expected = stepped.isActive() ? stepped.next() : 1.0f;
+            if (gains[i] != expected) return false;
+        }
+    }
+    return !blocked.isActive();
+}
+
+bool simdMultiplyMatches() {
+    // Odd length and offset pointers: unaligned body plus scalar tail
+    std::vector<float> signal(203), gains(203);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = std::sin(0.1f * i);
+        gains[i] = 0.01f * static_cast<float>(i % 100);
+    }
+    std::vector<float> expected(signal);
+    for (size_t i = 1; i < signal.size(); ++i) expected[i] *= gains[i];
+
+    FadeRamp::applyGains(signal.data() + 1, gains.data() + 1, static_cast<int>(signal.size()) - 1);
+    return signal == expected;
+}
+
+template <typename Gain>
+double nsPerSample(Gain gain) {
+    constexpr int LENGTH = 2048;
+    constexpr int PASSES = 2000;
+    volatile int length = LENGTH;  // Keeps the curves from being folded or hoisted
+    float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        sink += gain(length - (pass & 1));
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / (static_cast<double>(PASSES) * LENGTH) + (sink == 12345.0f ? 1.0 : 0.0);
+}
+
+} // namespace
+
+int main() {
+    struct Case {
+        const char* name;
+        Curve curve;
+        Direction direction;
+        double bound;
+    };
+
+    // Bounds from FadeEngine.h
+    const Case cases[] = {
+        {"raised cosine out", Curve::RaisedCosine, Direction::Out, 1e-6},
+        {"raised cosine in", Curve::RaisedCosine, Direction::In, 1e-6},
+        {"exponential out", Curve::Exponential, Direction::Out, 5e-6},
+        {"exponential in", Curve::Exponential, Direction::In, 5e-6},
+    };
+
+    bool passed = true;
+    auto row = [&](const std::string& label, bool ok) {
+        std::cout << "  " << std::left << std::setw(30) << label << (ok ? "yes" : "NO") << std::endl;
+        passed = passed && ok;
+    };
+
+    std::cout << "Fade envelope tables (" << FadeCurveTables::SEGMENTS << " segments, SIMD width "
+              << simd::FloatBatch::WIDTH << ")" << std::endl;
+    for (const Case& c : cases) {
+        double error = maxCurveError(c.curve, c.direction);
+        bool ok = error <= c.bound;
+        passed = passed && ok;
+        std::cout << "  " << std::left << std::setw(30) << c.name
+                  << std::scientific << std::setprecision(2) << error << (ok ? "" : "  (over bound)") << std::endl;
+    }
+
+    row("crossfade pair sums to unity", pairSumsToUnity(Curve::RaisedCosine));
+    row("block render matches steps", blockMatchesSteps());
+    row("SIMD gain multiply exact", simdMultiplyMatches());
+
+    // Per-sample cost of one fade gain, for reference only
+    double cosine = nsPerSample([](int length) {
+        float sum = 0.0f;
+        for (int k = 0; k < length; ++k) {
+            float progress = static_cast<float>(k) / static_cast<float>(length);
+            sum += 0.5f * (1.0f + cosf(progress * 3.14159265f));
+        }
+        return sum;
+    });
+    double exponential = nsPerSample([](int length) {
+        float sum = 0.0f;
+        for (int k = 0; k < length; ++k) {
+            sum += std::exp(-6.0f * static_cast<float>(k) / static_cast<float>(length));
+        }
+        return sum;
+    });
+    double table = nsPerSample([](int length) {
+        FadeRamp ramp;
+        ramp.start(Curve::RaisedCosine, Direction::Out, length);
+        float sum = 0.0f;
+        while (ramp.isActive()) sum += ramp.next();
+        return sum;
+    });
+    std::vector<float> gains(2048);
+    double block = nsPerSample([&](int length) {
+        FadeRamp ramp;
+        ramp.start(Curve::Exponential, Direction::In, length);
+        ramp.render(gains.data(), length);
+        return gains[length / 2];
+    });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "  ns/sample: cosf " << cosine << ", std::exp " << exponential
+              << ", table step " << table << ", table block " << block << std::endl;
+
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+// Documents the error of the FastTanh kernels against std::tanh.
+//
+// Sweeps each kernel (scalar double, scalar float and SIMD) over several
+// input ranges, prints the maximum absolute error per range and fails if
+// any kernel exceeds the bound documented in FastTanh.h. Also checks that
+// every kernel is exactly odd, monotonic and never leaves [-1, 1]. Built a
+// second time as test_fast_tanh_fma with multiply-adds contracted to FMA.
+
+#include "source/WaterStick/FastTanh.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr int STEPS = 400000;
+constexpr double MONOTONIC_TOLERANCE = 5e-7;      // A few float ulp near 1.0
+
+struct Range {
+    double limit;
+    double padeBound;
+    double rationalBound;
+};
+
+// Bounds from FastTanh.h, plus float rounding headroom (~1 ulp near 1.0)
+const Range RANGES[] = {
+    {1.0, 2.5e-7, 5e-7},
+    {2.0, 2.5e-7, 5e-7},
+    {3.0, 1.2e-6, 5e-7},
+    {5.0, 1e-4, 5e-7},
+    {20.0, 1e-4, 5e-7},
+};
+
+template <typename Kernel>
+double maxError(double limit, Kernel kernel) {
+    double worst = 0.0;
+    for (int i = -STEPS; i <= STEPS; ++i) {
+        double x = limit * i / STEPS;
+        worst = std::max(worst, std::abs(kernel(x) - std::tanh(x)));
+    }
+    return worst;
+}
+
+template <typename Kernel>
+bool isWellBehaved(Kernel kernel) {
+    double previous = -1.0;
+    for (int i = -STEPS; i <= STEPS; ++i) {
+        double x = 20.0 * i / STEPS;
+        double y = kernel(x);
+        // Float kernels may step back by rounding noise near +-1, never more
+        if (y < previous - MONOTONIC_TOLERANCE || y < -1.0 || y > 1.0 || y != -kernel(-x)) return false;
+        previous = y;
+    }
+    return true;
+}
+
+double simdPade(double x) {
+    alignas(simd::ALIGNMENT) float lanes[simd::FloatBatch::WIDTH];
+    std::fill(lanes, lanes + simd::FloatBatch::WIDTH, static_cast<float>(x));
+    simd::store(lanes, FastTanh::pade(simd::load(lanes)));
+    return lanes[0];
+}
+
+double simdRational(double x) {
+    alignas(simd::ALIGNMENT) float lanes[simd::FloatBatch::WIDTH];
+    std::fill(lanes, lanes + simd::FloatBatch::WIDTH, static_cast<float>(x));
+    simd::store(lanes, FastTanh::rational(simd::load(lanes)));
+    return lanes[0];
+}
+
+} // namespace
+
+int main() {
+    struct Kernel {
+        const char* name;
+        double (*evaluate)(double);
+        bool pade;
+    };
+
+    const Kernel kernels[] = {
+        {"pade<double>", [](double x) { return FastTanh::pade(x); }, true},
+        {"pade<float>", [](double x) { return static_cast<double>(FastTanh::pade(static_cast<float>(x))); }, true},
+        {"pade<simd>", simdPade, true},
+        {"rational<double>", [](double x) { return FastTanh::rational(x); }, false},
+        {"rational<float>", [](double x) { return static_cast<double>(FastTanh::rational(static_cast<float>(x))); }, false},
+        {"rational<simd>", simdRational, false},
+    };
+
+    bool passed = true;
+
+    std::cout << "FastTanh max abs error vs std::tanh (SIMD width " << simd::FloatBatch::WIDTH << ")" << std::endl;
+    std::cout << std::left << std::setw(18) << "kernel";
+    for (const Range& range : RANGES) {
+        std::cout << "|x|<=" << std::setw(9) << range.limit;
+    }
+    std::cout << std::endl;
+
+    for (const Kernel& kernel : kernels) {
+        std::cout << std::left << std::setw(18) << kernel.name;
+        for (const Range& range : RANGES) {
+            double error = maxError(range.limit, kernel.evaluate);
+            double bound = kernel.pade ? range.padeBound : range.rationalBound;
+            std::cout << std::scientific << std::setprecision(2) << std::setw(14) << error;
+            passed = passed && error <= bound;
+        }
+
+        bool wellBehaved = isWellBehaved(kernel.evaluate);
+        std::cout << (wellBehaved ? "" : "  (not odd/monotonic/bounded)") << std::endl;
+        passed = passed && wellBehaved;
+    }
+
+    // Throughput, for reference only
+    std::vector<float> data(1 << 16);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = 6.0f * (static_cast<float>(i) / data.size() - 0.5f);
+    }
+
+    auto time = [&](auto&& kernel) {
+        float sink = 0.0f;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < 64; ++pass) {
+            for (float x : data) sink += kernel(x);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return elapsed / (64.0 * data.size()) + (sink == 12345.0f ? 1.0 : 0.0);
+    };
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "ns/sample: std::tanh " << time([](float x) { return std::tanh(x); })
+              << ", pade " << time([](float x) { return FastTanh::pade(x); })
+              << ", rational " << time([](float x) { return FastTanh::rational(x); }) << std::endl;
+
+    std::cout << (passed ? "PASS" : "FAIL: error exceeds documented bound") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+// Dual-grain pitch shifter (GrainPitchBank.h).
+//
+// Every lane shifts a sine by its own interval. A head plays its input at
+// exactly the shifted frequency, but its delay repeats every grain, so a
+// tone generally comes out as lines on the grid input + m * GRAIN_RATE_HZ.
+// Each lane's input frequency is therefore chosen so that one grain spans
+// an even number of its periods: the splices are then phase-continuous,
+// the two heads (half a grain apart) are in phase, and the output must be
+// a pure tone at input * ratio at the input's level. No sample-to-sample
+// step may exceed what that tone produces plus a small allowance: a head
+// crossing the write position, as the old wraparound buffer did, shows up
+// as a step of up to twice the amplitude.
+// Lanes at unity must pass their input bit-exactly, including after being
+// retuned back to unity. Throughput of the 16-lane bank is reported.
+
+#include "source/WaterStick/GrainPitchBank.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <string>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int BLOCK_SIZE = 64;
+constexpr int NUM_LANES = GrainPitchBank::NUM_LANES;
+constexpr double PI = 3.14159265358979323846;
+constexpr double LOWEST_FREQUENCY = 150.0;
+
+const int SEMITONES[NUM_LANES] = {0, 1, -1, 3, -3, 5, -5, 7, -7, 9, -9, 11, -11, 12, -12, 2};
+
+double ratioFor(int semitones) { return std::pow(2.0, semitones / 12.0); }
+
+// Lowest frequency from LOWEST_FREQUENCY up with an even number of periods
+// per grain (grain length as documented in GrainPitchBank.h)
+double coherentFrequency(int semitones) {
+    if (semitones == 0) return LOWEST_FREQUENCY;
+    double grain = std::abs(1.0 - ratioFor(semitones)) * SAMPLE_RATE / GrainPitchBank::GRAIN_RATE_HZ;
+    grain = std::max(GrainPitchBank::MIN_GRAIN_SECONDS * SAMPLE_RATE,
+                     std::min(grain, GrainPitchBank::MAX_GRAIN_SECONDS * SAMPLE_RATE));
+    double step = 2.0 * SAMPLE_RATE / grain;
+    return step * std::ceil(LOWEST_FREQUENCY / step);
+}
+
+struct Rig {
+    GrainPitchBank bank;
+    std::vector<float> inputStorage = std::vector<float>(NUM_LANES * BLOCK_SIZE);
+    std::vector<float> outputStorage = std::vector<float>(NUM_LANES * BLOCK_SIZE);
+    std::array<const float*, NUM_LANES> inputs{};
+    std::array<float*, NUM_LANES> outputs{};
+    long sample = 0;
+
+    Rig() {
+        bank.initialize(SAMPLE_RATE, BLOCK_SIZE);
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            inputs[lane] = inputStorage.data() + lane * BLOCK_SIZE;
+            outputs[lane] = outputStorage.data() + lane * BLOCK_SIZE;
+        }
+    }
+
+    void block() {
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            double step = 2.0 * PI * coherentFrequency(SEMITONES[lane]) / SAMPLE_RATE;
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                inputStorage[lane * BLOCK_SIZE + i] = static_cast<float>(std::sin(step * static_cast<double>(sample + i)));
+            }
+        }
+        bank.processBlock(inputs.data(), outputs.data(), BLOCK_SIZE);
+        sample += BLOCK_SIZE;
+    }
+};
+
+// Average frequency between the first and last upward zero crossings,
+// each located by linear interpolation
+double averageFrequency(const std::vector<float>& signal) {
+    double first = -1.0, last = -1.0;
+    long periods = -1;
+    for (size_t k = 1; k < signal.size(); ++k) {
+        if (signal[k - 1] < 0.0f && signal[k] >= 0.0f) {
+            last = static_cast<double>(k - 1) + signal[k - 1] / (signal[k - 1] - signal[k]);
+            if (first < 0.0) first = last;
+            periods++;
+        }
+    }
+    return periods > 0 ? SAMPLE_RATE * periods / (last - first) : 0.0;
+}
+
+struct LaneStats {
+    std::vector<float> captured;
+    double sumSquares = 0.0;
+    double maxStep = 0.0;
+    float previous = 0.0f;
+    bool exact = true;
+};
+
+} // namespace
+
+int main() {
+    Rig rig;
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        rig.bank.setRatio(lane, static_cast<float>(ratioFor(SEMITONES[lane])));
+        rig.bank.resetLane(lane);
+    }
+
+    // Let histories fill and ratios settle, then measure two seconds
+    for (int b = 0; b < 200; ++b) rig.block();
+
+    std::array<LaneStats, NUM_LANES> stats{};
+    for (int lane = 0; lane < NUM_LANES; ++lane) stats[lane].previous = rig.outputs[lane][BLOCK_SIZE - 1];
+
+    const int measureBlocks = static_cast<int>(2.0 * SAMPLE_RATE) / BLOCK_SIZE;
+    for (int b = 0; b < measureBlocks; ++b) {
+        rig.block();
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            LaneStats& s = stats[lane];
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                float y = rig.outputs[lane][i];
+                s.captured.push_back(y);
+                s.sumSquares += static_cast<double>(y) * y;
+                s.maxStep = std::max(s.maxStep, static_cast<double>(std::abs(y - s.previous)));
+                s.exact = s.exact && y == rig.inputs[lane][i];
+                s.previous = y;
+            }
+        }
+    }
+
+    bool passed = true;
+
+    std::cout << "Dual-grain pitch shifter (SIMD width " << simd::FloatBatch::WIDTH << ", 16 lanes)" << std::endl;
+    std::cout << "  " << std::left << std::setw(8) << "semis" << std::setw(10) << "input" << std::setw(12) << "expected"
+              << std::setw(12) << "measured" << std::setw(10) << "level dB" << "max step / sine step" << std::endl;
+
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        const LaneStats& s = stats[lane];
+        double input = coherentFrequency(SEMITONES[lane]);
+        double expected = input * ratioFor(SEMITONES[lane]);
+        double measured = averageFrequency(s.captured);
+        double levelDb = 10.0 * std::log10(s.sumSquares / (measureBlocks * BLOCK_SIZE) / 0.5);
+        double sineStep = 2.0 * PI * expected / SAMPLE_RATE;
+        double stepRatio = s.maxStep / sineStep;
+
+        bool ok = std::abs(measured - expected) <= 0.002 * expected &&
+                  std::abs(levelDb) < 0.2 &&
+                  stepRatio < 1.1 &&
+                  (SEMITONES[lane] != 0 || s.exact);
+        passed = passed && ok;
+
+        std::cout << "  " << std::left << std::setw(8) << SEMITONES[lane]
+                  << std::fixed << std::setprecision(1) << std::setw(10) << input << std::setw(12) << expected << std::setw(12) << measured
+                  << std::setw(10) << levelDb << std::setprecision(2) << stepRatio
+                  << (SEMITONES[lane] == 0 ? (s.exact ? "  (bit-exact)" : "  (NOT exact)") : "")
+                  << (ok ? "" : "  (out of bounds)") << std::endl;
+    }
+
+    // Retuned to unity, every lane must end up passing its input untouched
+    for (int lane = 0; lane < NUM_LANES; ++lane) rig.bank.setRatio(lane, 1.0f);
+    for (int b = 0; b < 100; ++b) rig.block();
+    bool unityExact = true;
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        for (int i = 0; i < BLOCK_SIZE; ++i) unityExact = unityExact && rig.outputs[lane][i] == rig.inputs[lane][i];
+    }
+    passed = passed && unityExact;
+    std::cout << "  " << std::left << std::setw(30) << "back to unity is bit-exact" << (unityExact ? "yes" : "NO") << std::endl;
+
+    // Throughput with every lane pitched, and with none
+    auto nsPerSample = [&](bool pitched) {
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            rig.bank.setRatio(lane, pitched ? static_cast<float>(ratioFor(SEMITONES[lane] == 0 ? 4 : SEMITONES[lane])) : 1.0f);
+            rig.bank.resetLane(lane);
+        }
+        constexpr int BLOCKS = 4000;
+        auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < BLOCKS; ++b) rig.bank.processBlock(rig.inputs.data(), rig.outputs.data(), BLOCK_SIZE);
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (BLOCKS * BLOCK_SIZE);
+    };
+    double pitchedNs = nsPerSample(true);
+    double unityNs = nsPerSample(false);
+    std::cout << std::fixed << std::setprecision(1) << "  ns/sample, all 16 lanes: pitched "
+              << pitchedNs << ", unity " << unityNs << std::endl;
+
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// Tap parameter timelines (TapParameterTimeline.h) over the full delay range.
+//
+// A tap's values are recorded once per sample for 25 seconds, the way the
+// processor captures them, and read back at 0.1, 1, 10 and 20 seconds
+// behind with one timeline per reader. Sparse automation (a ramp every
+// 50 ms) fits the ring and must read back exactly without a compaction.
+// Dense automation (a ramp point every 5 samples, over a hundred per block,
+// with a pitch step every 0.75 s) overflows it: the timeline must report
+// compactions and still read back the right neighbourhood at 20 s. The
+// same stream with a zero horizon, where the oldest entry is always
+// dropped, shows what a full ring would otherwise return.
+
+#include "source/WaterStick/TapParameterTimeline.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <string>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr double MAX_DELAY_SECONDS = 20.0;
+constexpr int BLOCK_SIZE = 512;
+constexpr double RUN_SECONDS = 25.0;
+constexpr double PI = 3.14159265358979323846;
+
+constexpr int NUM_READERS = 4;
+constexpr double READ_SECONDS[NUM_READERS] = {0.1, 1.0, 10.0, 20.0};
+
+struct Stream {
+    std::vector<float> level, pan;
+    std::vector<int> pitch;
+};
+
+// Automation points every pointSpacing samples on smooth curves, ramped
+// linearly in between as the event scheduler renders them
+Stream automate(int pointSpacing, bool pitchSteps) {
+    const long length = static_cast<long>(RUN_SECONDS * SAMPLE_RATE);
+    auto levelAt = [](long n) { return 0.5 + 0.4 * std::sin(2.0 * PI * 1.0 * n / SAMPLE_RATE); };
+    auto panAt = [](long n) { return 0.5 + 0.45 * std::sin(2.0 * PI * 0.6 * n / SAMPLE_RATE + 1.0); };
+
+    Stream stream;
+    stream.level.resize(length);
+    stream.pan.resize(length);
+    stream.pitch.resize(length);
+    for (long n = 0; n < length; ++n) {
+        long point = n - n % pointSpacing;
+        double t = static_cast<double>(n - point) / pointSpacing;
+        stream.level[n] = static_cast<float>(levelAt(point) + t * (levelAt(point + pointSpacing) - levelAt(point)));
+        stream.pan[n] = static_cast<float>(panAt(point) + t * (panAt(point + pointSpacing) - panAt(point)));
+        stream.pitch[n] = pitchSteps ? static_cast<int>(n / static_cast<long>(0.75 * SAMPLE_RATE)) % 7 - 3 : 0;
+    }
+    return stream;
+}
+
+TapParameterTimeline::Snapshot snapshotAt(const Stream& stream, long n) {
+    TapParameterTimeline::Snapshot snapshot{};
+    snapshot.level = stream.level[n];
+    snapshot.pan = stream.pan[n];
+    snapshot.filterCutoff = 1000.0f;
+    snapshot.filterResonance = 0.2f;
+    snapshot.pitchShift = stream.pitch[n];
+    snapshot.feedbackSend = 0.5f;
+    snapshot.enabled = true;
+    return snapshot;
+}
+
+struct ReadBack {
+    std::array<float, NUM_READERS> levelError{};
+    std::array<float, NUM_READERS> panError{};
+    std::array<double, NUM_READERS> pitchWrong{};   // Fraction of samples
+    int64_t compactions = 0;
+};
+
+ReadBack run(const Stream& stream, int64_t horizon) {
+    std::array<TapParameterTimeline, NUM_READERS> timelines;
+    for (auto& timeline : timelines) {
+        timeline.setHorizon(horizon);
+        timeline.reset(snapshotAt(stream, 0), 0);
+    }
+
+    ReadBack result;
+    std::array<long, NUM_READERS> pitchWrong{}, reads{};
+    const long length = static_cast<long>(stream.level.size());
+
+    for (long block = 0; block < length; block += BLOCK_SIZE) {
+        const long end = std::min(length, block + BLOCK_SIZE);
+        for (long n = block; n < end; ++n) {
+            for (auto& timeline : timelines) timeline.record(n, snapshotAt(stream, n));
+        }
+
+        // Read the block back at each delay, as the processor does after capture
+        for (int r = 0; r < NUM_READERS; ++r) {
+            const long back = static_cast<long>(READ_SECONDS[r] * SAMPLE_RATE);
+            for (long n = block; n < end; ++n) {
+                if (n < back) continue;
+                TapParameterTimeline::Snapshot value = timelines[r].lookup(n - back);
+                result.levelError[r] = std::max(result.levelError[r], std::abs(value.level - stream.level[n - back]));
+                result.panError[r] = std::max(result.panError[r], std::abs(value.pan - stream.pan[n - back]));
+                pitchWrong[r] += value.pitchShift != stream.pitch[n - back];
+                reads[r]++;
+            }
+        }
+    }
+
+    for (int r = 0; r < NUM_READERS; ++r) {
+        result.pitchWrong[r] = reads[r] ? static_cast<double>(pitchWrong[r]) / reads[r] : 0.0;
+        result.compactions += timelines[r].getCompactions();
+    }
+    return result;
+}
+
+void print(const std::string& name, const ReadBack& result) {
+    std::cout << "  " << name << " (" << result.compactions / NUM_READERS << " compactions per timeline)" << std::endl;
+    for (int r = 0; r < NUM_READERS; ++r) {
+        std::cout << "    " << std::left << std::setw(8) << (std::to_string(READ_SECONDS[r]).substr(0, 4) + " s")
+                  << std::scientific << std::setprecision(2)
+                  << "level err " << std::setw(11) << result.levelError[r]
+                  << "pan err " << std::setw(11) << result.panError[r]
+                  << std::fixed << std::setprecision(3)
+                  << "pitch wrong " << 100.0 * result.pitchWrong[r] << " %" << std::endl;
+    }
+}
+
+} // namespace
+
+int main() {
+    const int64_t horizon = static_cast<int64_t>(MAX_DELAY_SECONDS * SAMPLE_RATE) + BLOCK_SIZE;
+
+    Stream sparse = automate(static_cast<int>(0.05 * SAMPLE_RATE), false);
+    Stream dense = automate(5, true);
+
+    ReadBack sparseResult = run(sparse, horizon);
+    ReadBack denseResult = run(dense, horizon);
+    ReadBack droppedResult = run(dense, 0);
+
+    std::cout << "Tap parameter timeline (" << TapParameterTimeline::CAPACITY << " entries, horizon "
+              << MAX_DELAY_SECONDS << " s)" << std::endl;
+    print("sparse, ramp every 50 ms", sparseResult);
+    print("dense, ramp every 5 samples", denseResult);
+    print("dense, oldest dropped", droppedResult);
+
+    // Sparse: exact everywhere, nothing compacted
+    bool sparseExact = sparseResult.compactions == 0;
+    for (int r = 0; r < NUM_READERS; ++r) {
+        sparseExact = sparseExact && sparseResult.levelError[r] < 2e-4f && sparseResult.panError[r] < 2e-4f &&
+                      sparseResult.pitchWrong[r] == 0.0;
+    }
+
+    // Dense: overflow reported; every delay, 20 s included, reads within a
+    // hundredth of the curves and gets the pitch of 99% of samples right
+    bool denseCovered = denseResult.compactions > 0;
+    for (int r = 0; r < NUM_READERS; ++r) {
+        denseCovered = denseCovered && denseResult.levelError[r] < 0.01f && denseResult.panError[r] < 0.01f &&
+                       denseResult.pitchWrong[r] < 0.01;
+    }
+
+    // Without compaction the ring cannot reach back 20 s
+    bool droppedFails = droppedResult.levelError[NUM_READERS - 1] > 0.1f;
+
+    std::cout << "  " << std::left << std::setw(34) << "sparse exact" << (sparseExact ? "yes" : "NO") << std::endl;
+    std::cout << "  " << std::left << std::setw(34) << "dense covered to 20 s" << (denseCovered ? "yes" : "NO") << std::endl;
+    std::cout << "  " << std::left << std::setw(34) << "dropping oldest reaches 20 s" << (droppedFails ? "no" : "YES") << std::endl;
+
+    bool passed = sparseExact && denseCovered && droppedFails;
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed ? 0 : 1;
+}
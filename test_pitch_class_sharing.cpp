@@ -0,0 +1,203 @@
+// Shared pitch routing of the decoupled delay system.
+//
+// In Shared routing the input is shifted once per distinct interval into a
+// class buffer and the taps on that interval read it at their delays; in
+// PerTap routing each tap's output is shifted after the delay. For a steady
+// tone both must give every tap the shifted frequency at the input's level.
+// The input is coherent with the grains of both octave intervals (see
+// test_grain_pitch_shifter.cpp), so the frequency is exact. Unshifted taps
+// read the main buffer either way and must match bit-exactly.
+// With more distinct intervals than classes, the extra ones are shifted per
+// tap and must be just as correct. Class buffers are allocated on demand:
+// the first block runs without any, then each rig allocates what the
+// system asked for, as the processor does off the audio thread. A rig
+// switched to Shared after setup gets none until the controller's count
+// arrives, as the processor's notify() passes it on, then shares. Cost with
+// three intervals across 16 taps is reported for both routings.
+
+#include "source/WaterStick/DecoupledDelayArchitecture.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <string>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr double MAX_DELAY_SECONDS = 20.0;
+constexpr int BLOCK_SIZE = 64;
+constexpr int NUM_TAPS = DecoupledDelaySystem::NUM_TAPS;
+constexpr double PI = 3.14159265358979323846;
+
+// Octave grains are 2400 and 1200 samples: whole numbers of 40 Hz periods
+constexpr double INPUT_FREQUENCY = 400.0;
+
+using Routing = DecoupledDelaySystem::PitchRouting;
+
+struct Rig {
+    DecoupledDelaySystem system;
+    std::vector<float> input = std::vector<float>(BLOCK_SIZE);
+    std::vector<float> buffer = std::vector<float>(NUM_TAPS * BLOCK_SIZE);
+    std::array<float*, NUM_TAPS> taps{};
+    long sample = 0;
+
+    Rig(Routing routing, const int* semitones) {
+        system.initialize(SAMPLE_RATE, MAX_DELAY_SECONDS);
+        system.prepareBlockProcessing(BLOCK_SIZE);
+        system.setPitchRouting(routing);
+        for (int tap = 0; tap < NUM_TAPS; ++tap) {
+            system.setTapDelayTime(tap, 0.010f + 0.007f * static_cast<float>(tap));
+            system.setTapEnabled(tap, true);
+            system.setTapPitchShift(tap, semitones[tap]);
+            taps[tap] = buffer.data() + tap * BLOCK_SIZE;
+        }
+        system.reset();
+
+        block();
+        system.allocatePitchClassBuffers();
+    }
+
+    void block() {
+        double step = 2.0 * PI * INPUT_FREQUENCY / SAMPLE_RATE;
+        for (int i = 0; i < BLOCK_SIZE; ++i) {
+            input[i] = static_cast<float>(std::sin(step * static_cast<double>(sample + i)));
+        }
+        system.processBlock(input.data(), BLOCK_SIZE, taps.data());
+        sample += BLOCK_SIZE;
+    }
+};
+
+struct TapStats {
+    std::vector<float> captured;
+    double sumSquares = 0.0;
+};
+
+// Average frequency between the first and last upward zero crossings,
+// each located by linear interpolation
+double averageFrequency(const std::vector<float>& signal) {
+    double first = -1.0, last = -1.0;
+    long periods = -1;
+    for (size_t k = 1; k < signal.size(); ++k) {
+        if (signal[k - 1] < 0.0f && signal[k] >= 0.0f) {
+            last = static_cast<double>(k - 1) + signal[k - 1] / (signal[k - 1] - signal[k]);
+            if (first < 0.0) first = last;
+            periods++;
+        }
+    }
+    return periods > 0 ? SAMPLE_RATE * periods / (last - first) : 0.0;
+}
+
+// Settle for two seconds, then capture every tap for one
+std::array<TapStats, NUM_TAPS> capture(Rig& rig) {
+    for (int b = 0; b < static_cast<int>(2.0 * SAMPLE_RATE) / BLOCK_SIZE; ++b) rig.block();
+
+    std::array<TapStats, NUM_TAPS> stats{};
+    for (int b = 0; b < static_cast<int>(SAMPLE_RATE) / BLOCK_SIZE; ++b) {
+        rig.block();
+        for (int tap = 0; tap < NUM_TAPS; ++tap) {
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                float y = rig.taps[tap][i];
+                stats[tap].captured.push_back(y);
+                stats[tap].sumSquares += static_cast<double>(y) * y;
+            }
+        }
+    }
+    return stats;
+}
+
+// Shifted frequency and unity level on every pitched tap
+bool checkTaps(const std::array<TapStats, NUM_TAPS>& stats, const int* semitones, const std::string& label) {
+    bool ok = true;
+    double worstFrequency = 0.0, worstLevel = 0.0;
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        if (semitones[tap] != 12 && semitones[tap] != -12) continue;
+
+        double expected = INPUT_FREQUENCY * std::pow(2.0, semitones[tap] / 12.0);
+        double error = std::abs(averageFrequency(stats[tap].captured) - expected) / expected;
+        double levelDb = 10.0 * std::log10(stats[tap].sumSquares / stats[tap].captured.size() / 0.5);
+        worstFrequency = std::max(worstFrequency, error);
+        worstLevel = std::max(worstLevel, std::abs(levelDb));
+    }
+    ok = worstFrequency <= 0.002 && worstLevel < 0.2;
+
+    std::cout << "  " << std::left << std::setw(30) << label << std::fixed
+              << std::setprecision(3) << std::setw(14) << worstFrequency * 100.0
+              << std::setprecision(2) << worstLevel << (ok ? "" : "  (out of bounds)") << std::endl;
+    return ok;
+}
+
+double nsPerSample(Routing routing, const int* semitones) {
+    Rig rig(routing, semitones);
+    for (int b = 0; b < 100; ++b) rig.block();
+
+    constexpr int BLOCKS = 2000;
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < BLOCKS; ++b) rig.system.processBlock(rig.input.data(), BLOCK_SIZE, rig.taps.data());
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (BLOCKS * BLOCK_SIZE);
+}
+
+} // namespace
+
+int main() {
+    bool passed = true;
+
+    std::cout << "Shared pitch routing (" << DecoupledDelaySystem::MAX_PITCH_CLASSES << " classes)" << std::endl;
+    std::cout << "  " << std::left << std::setw(30) << "octave taps" << std::setw(14) << "freq err %" << "level dB" << std::endl;
+
+    // Two intervals and unshifted taps, both routings
+    const int octaves[NUM_TAPS] = {0, 12, -12, 0, 12, -12, 12, 0, -12, 12, 0, -12, 12, -12, 0, 12};
+    Rig perTap(Routing::PerTap, octaves);
+    Rig shared(Routing::Shared, octaves);
+    auto perTapStats = capture(perTap);
+    auto sharedStats = capture(shared);
+
+    passed = checkTaps(perTapStats, octaves, "per tap") && passed;
+    passed = checkTaps(sharedStats, octaves, "shared, 2 classes") && passed;
+
+    bool classesOk = shared.system.getPitchClassCount() == 2 && shared.system.getPitchClassBuffers() == 2 &&
+                     perTap.system.getPitchClassBuffers() == 0;
+    bool unshiftedExact = true;
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        if (octaves[tap] == 0) unshiftedExact = unshiftedExact && perTapStats[tap].captured == sharedStats[tap].captured;
+    }
+    passed = passed && classesOk && unshiftedExact;
+
+    // Four intervals take the classes in tap order, the octaves overflow
+    const int crowded[NUM_TAPS] = {7, -5, 3, -7, 12, -12, 7, -5, 3, -7, 12, -12, 0, 0, 12, -12};
+    Rig overflow(Routing::Shared, crowded);
+    passed = checkTaps(capture(overflow), crowded, "shared, overflowing") && passed;
+    bool overflowClassesOk = overflow.system.getPitchClassCount() == DecoupledDelaySystem::MAX_PITCH_CLASSES;
+    passed = passed && overflowClassesOk;
+
+    // Switched to Shared after setup: the audio thread only records what it
+    // wants, and the classes get buffers once the controller's count arrives
+    Rig live(Routing::PerTap, octaves);
+    live.system.setPitchRouting(Routing::Shared);
+    live.block();
+    bool waitedForCount = live.system.getPitchClassBuffers() == 0 && live.system.getPitchClassCount() == 0;
+    live.system.allocatePitchClassBuffers(2);
+    passed = checkTaps(capture(live), octaves, "shared after setup") && passed;
+    bool liveClassesOk = waitedForCount && live.system.getPitchClassBuffers() == 2 && live.system.getPitchClassCount() == 2;
+    passed = passed && liveClassesOk;
+
+    std::cout << "  " << std::left << std::setw(30) << "classes in use" << shared.system.getPitchClassCount()
+              << ", " << overflow.system.getPitchClassCount() << " and " << live.system.getPitchClassCount()
+              << ((classesOk && overflowClassesOk && liveClassesOk) ? "" : "  (wrong)") << std::endl;
+    std::cout << "  " << std::left << std::setw(30) << "unshifted taps bit-exact" << (unshiftedExact ? "yes" : "NO") << std::endl;
+
+    // Three intervals across 16 taps
+    const int preset[NUM_TAPS] = {7, -5, 12, 7, -5, 12, 7, -5, 12, 7, -5, 12, 7, -5, 12, 7};
+    double perTapNs = nsPerSample(Routing::PerTap, preset);
+    double sharedNs = nsPerSample(Routing::Shared, preset);
+    std::cout << std::fixed << std::setprecision(1) << "  system ns/sample, 16 taps on 3 intervals: per tap "
+              << perTapNs << ", shared " << sharedNs << std::endl;
+
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed ? 0 : 1;
+}
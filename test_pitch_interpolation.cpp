@@ -0,0 +1,178 @@
+// Read-head interpolation tiers of the pitch shifter (GrainPitchBank.h,
+// PolyphaseSinc.h).
+//
+// Every tier must shift an octave up and down to the exact frequency at
+// the input's level. Inputs are coherent with the grains (see
+// test_grain_pitch_shifter.cpp), so anything else in the output comes from
+// the read head itself:
+// - 12 kHz an octave down: the level lost to interpolation (dullness).
+// - 15 kHz an octave up: 30 kHz is past Nyquist, so all output is alias.
+// Hermite must keep more treble than linear; the sinc tier must keep
+// within 0.5 dB and hold the alias at least 20 dB down. Cost per
+// tap-sample is reported for each tier with all 16 lanes pitched.
+
+#include "source/WaterStick/GrainPitchBank.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <string>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int BLOCK_SIZE = 64;
+constexpr int NUM_LANES = GrainPitchBank::NUM_LANES;
+constexpr double PI = 3.14159265358979323846;
+
+using Interpolation = GrainPitchBank::Interpolation;
+
+// Octave grains are 2400 (up) and 1200 (down) samples long; every input
+// is a whole number of periods of either
+struct Probe {
+    const char* label;
+    double frequency;
+    int semitones;
+};
+
+const Probe PROBES[] = {
+    {"400 Hz +12", 400.0, 12},
+    {"400 Hz -12", 400.0, -12},
+    {"12 kHz -12", 12000.0, -12},
+    {"15 kHz +12", 15000.0, 12},
+};
+constexpr int NUM_PROBES = 4;
+
+struct Rig {
+    GrainPitchBank bank;
+    std::vector<float> inputStorage = std::vector<float>(NUM_LANES * BLOCK_SIZE);
+    std::vector<float> outputStorage = std::vector<float>(NUM_LANES * BLOCK_SIZE);
+    std::array<const float*, NUM_LANES> inputs{};
+    std::array<float*, NUM_LANES> outputs{};
+    long sample = 0;
+
+    explicit Rig(Interpolation interpolation) {
+        bank.initialize(SAMPLE_RATE, BLOCK_SIZE);
+        bank.setInterpolation(interpolation);
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            inputs[lane] = inputStorage.data() + lane * BLOCK_SIZE;
+            outputs[lane] = outputStorage.data() + lane * BLOCK_SIZE;
+            int semitones = lane < NUM_PROBES ? PROBES[lane].semitones : (lane % 2 ? 7 : -5);
+            bank.setRatio(lane, static_cast<float>(std::pow(2.0, semitones / 12.0)));
+            bank.resetLane(lane);
+        }
+    }
+
+    void block() {
+        for (int lane = 0; lane < NUM_PROBES; ++lane) {
+            double step = 2.0 * PI * PROBES[lane].frequency / SAMPLE_RATE;
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                inputStorage[lane * BLOCK_SIZE + i] = static_cast<float>(std::sin(step * static_cast<double>(sample + i)));
+            }
+        }
+        bank.processBlock(inputs.data(), outputs.data(), BLOCK_SIZE);
+        sample += BLOCK_SIZE;
+    }
+};
+
+// Average frequency between the first and last upward zero crossings,
+// each located by linear interpolation
+double averageFrequency(const std::vector<float>& signal) {
+    double first = -1.0, last = -1.0;
+    long periods = -1;
+    for (size_t k = 1; k < signal.size(); ++k) {
+        if (signal[k - 1] < 0.0f && signal[k] >= 0.0f) {
+            last = static_cast<double>(k - 1) + signal[k - 1] / (signal[k - 1] - signal[k]);
+            if (first < 0.0) first = last;
+            periods++;
+        }
+    }
+    return periods > 0 ? SAMPLE_RATE * periods / (last - first) : 0.0;
+}
+
+struct TierResult {
+    double frequencyError = 0.0;   // Worst of the 400 Hz probes, relative
+    double levelDb[NUM_PROBES] = {};
+    double nsPerTapSample = 0.0;
+};
+
+TierResult measure(Interpolation interpolation) {
+    Rig rig(interpolation);
+    for (int b = 0; b < 200; ++b) rig.block();
+
+    std::array<std::vector<float>, NUM_PROBES> captured;
+    std::array<double, NUM_PROBES> sumSquares{};
+    for (int b = 0; b < static_cast<int>(SAMPLE_RATE) / BLOCK_SIZE; ++b) {
+        rig.block();
+        for (int lane = 0; lane < NUM_PROBES; ++lane) {
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                float y = rig.outputs[lane][i];
+                captured[lane].push_back(y);
+                sumSquares[lane] += static_cast<double>(y) * y;
+            }
+        }
+    }
+
+    TierResult result;
+    for (int lane = 0; lane < NUM_PROBES; ++lane) {
+        result.levelDb[lane] = 10.0 * std::log10(sumSquares[lane] / captured[lane].size() / 0.5 + 1e-30);
+        if (PROBES[lane].frequency == 400.0) {
+            double expected = 400.0 * std::pow(2.0, PROBES[lane].semitones / 12.0);
+            double error = std::abs(averageFrequency(captured[lane]) - expected) / expected;
+            result.frequencyError = std::max(result.frequencyError, error);
+        }
+    }
+
+    constexpr int BLOCKS = 4000;
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < BLOCKS; ++b) rig.bank.processBlock(rig.inputs.data(), rig.outputs.data(), BLOCK_SIZE);
+    result.nsPerTapSample = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                          / (static_cast<double>(BLOCKS) * BLOCK_SIZE * NUM_LANES);
+    return result;
+}
+
+} // namespace
+
+int main() {
+    const Interpolation tiers[] = {Interpolation::Linear, Interpolation::Hermite, Interpolation::Sinc};
+    const char* names[] = {"linear", "hermite", "sinc"};
+
+    std::cout << "Pitch read-head interpolation (SIMD width " << simd::FloatBatch::WIDTH << ", "
+              << PolyphaseSincTable::POINTS << "-point sinc)" << std::endl;
+    std::cout << "  " << std::left << std::setw(10) << "tier" << std::setw(12) << "freq err %";
+    for (const Probe& probe : PROBES) std::cout << std::setw(13) << probe.label;
+    std::cout << "ns/tap-sample" << std::endl;
+
+    std::array<TierResult, 3> results;
+    bool passed = true;
+    for (int t = 0; t < 3; ++t) {
+        results[t] = measure(tiers[t]);
+        const TierResult& r = results[t];
+
+        bool ok = r.frequencyError <= 0.002 && std::abs(r.levelDb[0]) < 0.2 && std::abs(r.levelDb[1]) < 0.2;
+        passed = passed && ok;
+
+        std::cout << "  " << std::left << std::setw(10) << names[t] << std::fixed << std::setprecision(3)
+                  << std::setw(12) << r.frequencyError * 100.0 << std::setprecision(2);
+        for (int lane = 0; lane < NUM_PROBES; ++lane) std::cout << std::setw(13) << r.levelDb[lane];
+        std::cout << r.nsPerTapSample << (ok ? "" : "  (octaves out of bounds)") << std::endl;
+    }
+
+    const TierResult& linear = results[0];
+    const TierResult& hermite = results[1];
+    const TierResult& sinc = results[2];
+    bool trebleOk = hermite.levelDb[2] > linear.levelDb[2] && std::abs(sinc.levelDb[2]) < 0.5;
+    bool aliasOk = sinc.levelDb[3] < -20.0 && sinc.levelDb[3] < linear.levelDb[3];
+    passed = passed && trebleOk && aliasOk;
+
+    std::cout << "  " << std::left << std::setw(30) << "treble kept (12 kHz -12)" << (trebleOk ? "yes" : "NO") << std::endl;
+    std::cout << "  " << std::left << std::setw(30) << "alias rejected (15 kHz +12)" << (aliasOk ? "yes" : "NO") << std::endl;
+
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed ? 0 : 1;
+}
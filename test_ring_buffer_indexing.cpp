@@ -0,0 +1,226 @@
+// Power-of-two, mirrored ring buffers in the decoupled delay system.
+//
+// Checks that the shared buffer is sized to a power of two without changing
+// the longest delay, that a MirroredRingBuffer repeats its start after its
+// end (page-mapped mirror and guard tail alike) while blocks are written
+// across the wrap, and that a read head delivers an impulse at exactly its
+// delay while the write and read indices wrap. Then times 16 read heads over
+// one buffer, wrapped with a modulo on the old (maxDelay + write-ahead) size
+// against a mask on the rounded size, and the whole system for reference.
+
+#include "source/WaterStick/DecoupledDelayArchitecture.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cmath>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr double MAX_DELAY_SECONDS = 20.0;
+constexpr int BLOCK_SIZE = 64;
+constexpr int NUM_TAPS = DecoupledDelaySystem::NUM_TAPS;
+constexpr int BENCH_SAMPLES = 1 << 18;
+
+// Delay of a single read head measured by its impulse response, or -1
+int measureDelay(float delaySeconds, int startOffset) {
+    MultiTapDelayBuffer buffer;
+    buffer.initialize(SAMPLE_RATE, 1.0);
+
+    PureDelayLine head;
+    head.initialize(SAMPLE_RATE, &buffer);
+    head.setDelayTime(delaySeconds);
+    head.reset();
+
+    // Start near the end so the impulse and its echo straddle the wrap
+    const int start = buffer.getSize() - startOffset;
+    for (int i = 0; i < start; ++i) buffer.advance();
+
+    const int expected = static_cast<int>(delaySeconds * SAMPLE_RATE);
+    std::vector<float> input(BLOCK_SIZE), output(BLOCK_SIZE);
+    int peakAt = -1;
+    float peak = 0.0f;
+
+    for (int sample = 0; sample < expected + 4 * BLOCK_SIZE; sample += BLOCK_SIZE) {
+        std::fill(input.begin(), input.end(), 0.0f);
+        if (sample == 0) input[0] = 1.0f;
+
+        // Read from where this block is written, as the system does
+        int timeIndex = buffer.getWriteIndex();
+        buffer.writeBlock(input.data(), BLOCK_SIZE);
+        head.processBlock(timeIndex, BLOCK_SIZE, output.data());
+
+        for (int i = 0; i < BLOCK_SIZE; ++i) {
+            if (std::abs(output[i]) > peak) {
+                peak = std::abs(output[i]);
+                peakAt = sample + i;
+            }
+        }
+    }
+    return peakAt;
+}
+
+// Writes blocks of awkward lengths across the wrap and checks the mirror
+bool mirrorHolds(int size, int guard, MirroredRingBuffer::Mirror mirror, bool& virtualMirror) {
+    MirroredRingBuffer ring;
+    ring.allocate(size, guard, mirror);
+    virtualMirror = ring.isVirtualMirror();
+    if (ring.guard() < guard) return false;
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<float> block(ring.size());
+    uint32_t index = 0;
+
+    for (int pass = 0; pass < 64; ++pass) {
+        int length = 1 + static_cast<int>(rng() % static_cast<uint32_t>(ring.size()));
+        for (int i = 0; i < length; ++i) block[i] = noise(rng);
+
+        if (pass % 2) {
+            ring.writeBlock(index, block.data(), length);
+        } else {
+            for (int i = 0; i < length; ++i) ring.write((index + i) & ring.mask(), block[i]);
+        }
+
+        // The block reads back from where it started, contiguously as far
+        // as the guard reaches past the end
+        for (int i = 0; i < length; ++i) {
+            uint32_t at = index + i < static_cast<uint32_t>(ring.size() + ring.guard()) ? index + i : (index + i) & ring.mask();
+            if (ring.data()[at] != block[i]) return false;
+        }
+        index = (index + length) & ring.mask();
+    }
+
+    for (int i = 0; i < ring.guard(); ++i) {
+        if (ring.data()[i] != ring.data()[i + ring.size()]) return false;
+    }
+    return true;
+}
+
+struct Heads {
+    std::array<int, NUM_TAPS> delays{};
+
+    Heads() {
+        for (int tap = 0; tap < NUM_TAPS; ++tap) delays[tap] = 1000 + tap * 37501;
+    }
+};
+
+// 16 heads reading one span, wrapped with a modulo
+double timeModulo(const std::vector<float>& buffer, int bufferSize, const Heads& heads, float& sink) {
+    auto start = std::chrono::steady_clock::now();
+    int writeIndex = 0;
+    for (int n = 0; n < BENCH_SAMPLES; ++n) {
+        for (int tap = 0; tap < NUM_TAPS; ++tap) {
+            int readIndex = (writeIndex - heads.delays[tap] + bufferSize) % bufferSize;
+            sink += buffer[readIndex];
+        }
+        writeIndex = (writeIndex + 1) % bufferSize;
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The same heads on a power-of-two buffer, wrapped with a mask
+double timeMask(const std::vector<float>& buffer, uint32_t mask, const Heads& heads, float& sink) {
+    auto start = std::chrono::steady_clock::now();
+    uint32_t writeIndex = 0;
+    for (int n = 0; n < BENCH_SAMPLES; ++n) {
+        for (int tap = 0; tap < NUM_TAPS; ++tap) {
+            uint32_t readIndex = (writeIndex - static_cast<uint32_t>(heads.delays[tap])) & mask;
+            sink += buffer[readIndex];
+        }
+        writeIndex = (writeIndex + 1) & mask;
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    auto row = [](const std::string& label) -> std::ostream& {
+        return std::cout << "  " << std::left << std::setw(30) << label;
+    };
+
+    MultiTapDelayBuffer shared;
+    shared.initialize(SAMPLE_RATE, MAX_DELAY_SECONDS);
+    const int maxDelay = static_cast<int>(MAX_DELAY_SECONDS * SAMPLE_RATE);
+    const int oldSize = maxDelay + MultiTapDelayBuffer::WRITE_AHEAD_SAMPLES;
+
+    bool powerOfTwo = (shared.getSize() & (shared.getSize() - 1)) == 0 &&
+                      shared.getSize() >= oldSize &&
+                      shared.getMask() == static_cast<uint32_t>(shared.getSize() - 1);
+    bool maxDelayKept = shared.getMaxDelaySamples() == maxDelay;
+
+    bool delaysExact = true;
+    for (float delay : {0.001f, 0.0105f, 0.25f, 0.9f}) {
+        for (int offset : {1, 17, BLOCK_SIZE, 5000}) {
+            delaysExact = delaysExact && measureDelay(delay, offset) == std::lround(delay * SAMPLE_RATE);
+        }
+    }
+
+    using Mirror = MirroredRingBuffer::Mirror;
+    bool largeVirtual = false, smallVirtual = false, tailVirtual = false;
+    bool mirrorsHold = mirrorHolds(1 << 16, 1 << 10, Mirror::Virtual, largeVirtual) &&
+                       mirrorHolds(100, 16, Mirror::Virtual, smallVirtual) && !smallVirtual &&
+                       mirrorHolds(1 << 16, 1 << 10, Mirror::GuardTail, tailVirtual) && !tailVirtual;
+
+    std::cout << "Power-of-two ring buffers" << std::endl;
+    row("buffer size") << shared.getSize() << " (was " << oldSize << ")" << std::endl;
+    row("power of two, mask matches") << (powerOfTwo ? "yes" : "NO") << std::endl;
+    row("mirror holds") << (mirrorsHold ? "yes" : "NO")
+                        << (largeVirtual ? " (page-mapped and guard tail)" : " (guard tail only)") << std::endl;
+    row("max delay unchanged") << (maxDelayKept ? "yes" : "NO") << std::endl;
+    row("impulse delay exact at wrap") << (delaysExact ? "yes" : "NO") << std::endl;
+
+    // Indexing microbenchmark, for reference only
+    Heads heads;
+    std::vector<float> oldBuffer(oldSize), newBuffer(shared.getSize());
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    for (float& x : oldBuffer) x = noise(rng);
+    for (float& x : newBuffer) x = noise(rng);
+
+    float sink = 0.0f;
+    double moduloNs = timeModulo(oldBuffer, oldSize, heads, sink);
+    double maskNs = timeMask(newBuffer, shared.getMask(), heads, sink);
+    const double reads = static_cast<double>(BENCH_SAMPLES) * NUM_TAPS;
+
+    // Whole system with every tap running, for scale
+    DecoupledDelaySystem system;
+    system.initialize(SAMPLE_RATE, MAX_DELAY_SECONDS);
+    system.prepareBlockProcessing(BLOCK_SIZE);
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        system.setTapDelayTime(tap, heads.delays[tap] / static_cast<float>(SAMPLE_RATE));
+        system.setTapEnabled(tap, true);
+    }
+    system.reset();
+
+    std::vector<float> input(BLOCK_SIZE), outputs(NUM_TAPS * BLOCK_SIZE);
+    std::array<float*, NUM_TAPS> taps{};
+    for (int tap = 0; tap < NUM_TAPS; ++tap) taps[tap] = outputs.data() + tap * BLOCK_SIZE;
+    for (float& x : input) x = noise(rng);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < BENCH_SAMPLES; n += BLOCK_SIZE) {
+        system.processBlock(input.data(), BLOCK_SIZE, taps.data());
+        sink += outputs[0];
+    }
+    double systemNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(3);
+    row("modulo read (ns/tap-sample)") << moduloNs / reads << std::endl;
+    row("mask read (ns/tap-sample)") << maskNs / reads << " (" << std::setprecision(1) << moduloNs / maskNs << "x)" << std::endl;
+    row("system (ns/sample, 16 taps)") << std::setprecision(1) << systemNs / BENCH_SAMPLES
+                                        << (sink == 12345.0f ? " " : "") << std::endl;
+
+    bool passed = powerOfTwo && mirrorsHold && maxDelayKept && delaysExact;
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// Tail tracking (TailTracker.h) around a decoupled delay feedback loop.
+//
+// Two taps feed back through a damping low-pass, the way the processor
+// closes its loop: a noise burst, then silence until the tail is gone. The
+// tracker must never call the tail decayed while anything written or heard
+// is still above SILENCE_THRESHOLD, must do so within the hold once it has
+// died, and the host estimate must cover the measured tail. A loop gain of
+// one never decays. The longest read distance must include a delay time
+// change in progress, for both read modes.
+
+#include "source/WaterStick/DecoupledDelayArchitecture.h"
+#include "source/WaterStick/TailTracker.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr double MAX_DELAY_SECONDS = 20.0;
+constexpr int BLOCK_SIZE = 64;
+constexpr int NUM_TAPS = DecoupledDelaySystem::NUM_TAPS;
+constexpr double BURST_SECONDS = 0.2;
+
+constexpr float TAP_DELAYS[] = {0.110f, 0.250f};
+constexpr float TAP_GAINS[] = {0.6f, 0.4f};
+
+struct Loop {
+    float feedback;
+    float dampingCoeff;   // 0 without damping
+    const char* name;
+};
+
+struct Measured {
+    long lastLoud = -1;      // Last sample written or heard above the threshold
+    long decayedAt = -1;     // First sample of the first block the tracker called decayed
+    bool decayedEarly = false;
+    long holdSamples = 0;
+    uint32_t estimate = 0;
+};
+
+Measured run(const Loop& loop) {
+    DecoupledDelaySystem system;
+    system.initialize(SAMPLE_RATE, MAX_DELAY_SECONDS);
+    system.prepareBlockProcessing(BLOCK_SIZE);
+    for (int tap = 0; tap < 2; ++tap) {
+        system.setTapDelayTime(tap, TAP_DELAYS[tap]);
+        system.setTapEnabled(tap, true);
+    }
+    system.reset();
+
+    TailTracker tracker;
+    tracker.setSampleRate(SAMPLE_RATE);
+    tracker.setLongestReadDistance(system.getMaxReadDistance());
+
+    Measured result;
+    result.holdSamples = system.getMaxReadDistance() + static_cast<long>(TailTracker::SETTLE_SECONDS * SAMPLE_RATE);
+    result.estimate = TailTracker::estimateTailSamples(SAMPLE_RATE, TAP_DELAYS[1],
+                                                       loop.feedback * (TAP_GAINS[0] + TAP_GAINS[1]), loop.dampingCoeff);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::vector<float> input(BLOCK_SIZE), delayInput(BLOCK_SIZE), wet(BLOCK_SIZE), buffer(NUM_TAPS * BLOCK_SIZE);
+    std::array<float*, NUM_TAPS> taps{};
+    for (int tap = 0; tap < NUM_TAPS; ++tap) taps[tap] = buffer.data() + tap * BLOCK_SIZE;
+
+    const long burst = static_cast<long>(BURST_SECONDS * SAMPLE_RATE);
+    float fedBack = 0.0f;
+    float damping = 0.0f;
+
+    // Runs on until the tail has been silent for twice the hold
+    for (long sample = 0; result.lastLoud < 0 || sample < result.lastLoud + 2 * result.holdSamples; sample += BLOCK_SIZE) {
+        if (sample >= burst && tracker.isDecayed() && result.decayedAt < 0) {
+            result.decayedAt = sample;
+        }
+
+        for (int i = 0; i < BLOCK_SIZE; ++i) input[i] = sample + i < burst ? noise(rng) : 0.0f;
+
+        delayInput[0] = input[0] + loop.feedback * fedBack;
+        system.writeBlock(delayInput.data(), 1);
+        system.readBlock(BLOCK_SIZE, taps.data());
+        for (int i = 0; i < BLOCK_SIZE; ++i) {
+            wet[i] = TAP_GAINS[0] * taps[0][i] + TAP_GAINS[1] * taps[1][i];
+            damping = loop.dampingCoeff > 0.0f ? (1.0f - loop.dampingCoeff) * wet[i] + loop.dampingCoeff * damping : wet[i];
+            fedBack = damping;
+            if (i + 1 < BLOCK_SIZE) delayInput[i + 1] = input[i + 1] + loop.feedback * fedBack;
+        }
+        system.writeBlock(delayInput.data() + 1, BLOCK_SIZE - 1);
+
+        for (int i = 0; i < BLOCK_SIZE; ++i) {
+            if (std::max(std::abs(delayInput[i]), std::abs(wet[i])) > TailTracker::SILENCE_THRESHOLD) {
+                result.lastLoud = sample + i;
+                result.decayedEarly = result.decayedEarly || result.decayedAt >= 0;
+            }
+        }
+        float peak = 0.0f;
+        for (int i = 0; i < BLOCK_SIZE; ++i) peak = std::max({peak, std::abs(delayInput[i]), std::abs(wet[i])});
+        tracker.observe(peak, BLOCK_SIZE);
+    }
+
+    return result;
+}
+
+// Read distance, in seconds, one block into a move from 0.5 s to 0.1 s and once settled
+void readDistanceAcrossChange(DecoupledDelaySystem::DelayReadMode mode, double& during, double& settled) {
+    DecoupledDelaySystem system;
+    system.initialize(SAMPLE_RATE, MAX_DELAY_SECONDS);
+    system.prepareBlockProcessing(BLOCK_SIZE);
+    system.setDelayReadMode(mode);
+    system.setTapDelayTime(0, 0.5f);
+    system.setTapEnabled(0, true);
+    system.reset();
+
+    std::vector<float> input(BLOCK_SIZE, 0.0f), buffer(NUM_TAPS * BLOCK_SIZE);
+    std::array<float*, NUM_TAPS> taps{};
+    for (int tap = 0; tap < NUM_TAPS; ++tap) taps[tap] = buffer.data() + tap * BLOCK_SIZE;
+
+    // A reset tap jumps to new delay times until it has heard new input
+    for (int b = 0; b < static_cast<int>(0.6 * SAMPLE_RATE / BLOCK_SIZE); ++b) {
+        system.processBlock(input.data(), BLOCK_SIZE, taps.data());
+    }
+
+    system.setTapDelayTime(0, 0.1f);
+    system.processBlock(input.data(), BLOCK_SIZE, taps.data());
+    during = system.getMaxReadDistance() / SAMPLE_RATE;
+
+    for (int b = 0; b < static_cast<int>(5.0 * SAMPLE_RATE / BLOCK_SIZE); ++b) {
+        system.processBlock(input.data(), BLOCK_SIZE, taps.data());
+    }
+    settled = system.getMaxReadDistance() / SAMPLE_RATE;
+}
+
+} // namespace
+
+int main() {
+    bool passed = true;
+
+    const Loop loops[] = {
+        {0.5f, 0.0f, "gain 0.5"},
+        {0.9f, 0.0f, "gain 0.9"},
+        {0.9f, 0.995f, "gain 0.9, damped"},
+    };
+
+    std::cout << "Tail tracker (threshold " << 20.0 * std::log10(TailTracker::SILENCE_THRESHOLD) << " dBFS)" << std::endl;
+    std::cout << "  " << std::left << std::setw(20) << "loop" << std::setw(12) << "tail s"
+              << std::setw(14) << "decayed +s" << "estimate s" << std::endl;
+
+    const long burst = static_cast<long>(BURST_SECONDS * SAMPLE_RATE);
+    for (const Loop& loop : loops) {
+        Measured m = run(loop);
+        double tail = (m.lastLoud - burst) / SAMPLE_RATE;
+        double decayedAfter = (m.decayedAt - m.lastLoud) / SAMPLE_RATE;
+        double estimate = m.estimate / SAMPLE_RATE;
+
+        bool ok = !m.decayedEarly && m.decayedAt > m.lastLoud &&
+                  m.decayedAt <= m.lastLoud + m.holdSamples + 2 * BLOCK_SIZE &&
+                  m.estimate >= static_cast<uint32_t>(m.lastLoud - burst);
+        passed = passed && ok;
+
+        std::cout << "  " << std::left << std::setw(20) << loop.name << std::fixed << std::setprecision(2)
+                  << std::setw(12) << tail << std::setw(14) << decayedAfter << estimate
+                  << (ok ? "" : "  (wrong)") << std::endl;
+    }
+
+    bool infinite = TailTracker::estimateTailSamples(SAMPLE_RATE, 0.25, 1.0, 0.0) == TailTracker::INFINITE_TAIL;
+    passed = passed && infinite;
+    std::cout << "  " << std::left << std::setw(46) << "gain 1.0 estimate" << (infinite ? "infinite" : "finite") << std::endl;
+
+    for (auto mode : {DecoupledDelaySystem::DelayReadMode::Crossfade, DecoupledDelaySystem::DelayReadMode::Glide}) {
+        double during = 0.0, settled = 0.0;
+        readDistanceAcrossChange(mode, during, settled);
+        bool ok = during >= 0.45 && settled > 0.099 && settled < 0.101;
+        passed = passed && ok;
+        std::cout << "  " << std::left << std::setw(46)
+                  << (mode == DecoupledDelaySystem::DelayReadMode::Glide ? "read distance, glide 0.5 -> 0.1 s"
+                                                                          : "read distance, crossfade 0.5 -> 0.1 s")
+                  << std::fixed << std::setprecision(3) << during << " s, then " << settled << " s"
+                  << (ok ? "" : "  (wrong)") << std::endl;
+    }
+
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+// Sleep of silent taps in the decoupled delay system.
+//
+// Every tap starts asleep on silence, then a tone begins. Each tap must
+// wake on the block its delay output first has energy (no later than its
+// output has, which shifted taps reach a little later), and from then on
+// match a system that never slept: unshifted taps bit-exactly, shifted taps
+// (whose shifter lanes were skipped while asleep and restart on waking) in
+// frequency and level. The input is coherent with the octave grains (see
+// test_grain_pitch_shifter.cpp), so the frequency is exact. A tap that may
+// not wake on input stays silent. Cost per sample is reported with every
+// tap shifted, all awake and with only four awake.
+
+#include "source/WaterStick/DecoupledDelayArchitecture.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr double MAX_DELAY_SECONDS = 20.0;
+constexpr int BLOCK_SIZE = 64;
+constexpr int NUM_TAPS = DecoupledDelaySystem::NUM_TAPS;
+constexpr double PI = 3.14159265358979323846;
+
+constexpr double INPUT_FREQUENCY = 400.0;
+constexpr double TONE_START_SECONDS = 0.2;
+constexpr int HELD_TAP = 5;   // Asleep without waking on input
+
+constexpr int SEMITONES[NUM_TAPS] = {0, 0, 12, 0, 0, 0, -12, 0, 0, 0, 0, 0, 12, -12, 12, -12};
+
+float tapDelay(int tap) { return 0.010f + 0.030f * static_cast<float>(tap); }
+
+struct Rig {
+    DecoupledDelaySystem system;
+    std::vector<float> input = std::vector<float>(BLOCK_SIZE);
+    std::vector<float> buffer = std::vector<float>(NUM_TAPS * BLOCK_SIZE);
+    std::array<float*, NUM_TAPS> taps{};
+    long sample = 0;
+
+    explicit Rig(const int* semitones) {
+        system.initialize(SAMPLE_RATE, MAX_DELAY_SECONDS);
+        system.prepareBlockProcessing(BLOCK_SIZE);
+        for (int tap = 0; tap < NUM_TAPS; ++tap) {
+            system.setTapDelayTime(tap, tapDelay(tap));
+            system.setTapEnabled(tap, true);
+            system.setTapPitchShift(tap, semitones[tap]);
+            taps[tap] = buffer.data() + tap * BLOCK_SIZE;
+        }
+        system.reset();
+    }
+
+    void block() {
+        double step = 2.0 * PI * INPUT_FREQUENCY / SAMPLE_RATE;
+        long toneStart = static_cast<long>(TONE_START_SECONDS * SAMPLE_RATE);
+        for (int i = 0; i < BLOCK_SIZE; ++i) {
+            long n = sample + i;
+            input[i] = n < toneStart ? 0.0f : static_cast<float>(std::sin(step * static_cast<double>(n - toneStart)));
+        }
+        system.processBlock(input.data(), BLOCK_SIZE, taps.data());
+        sample += BLOCK_SIZE;
+    }
+};
+
+// Average frequency between the first and last upward zero crossings,
+// each located by linear interpolation
+double averageFrequency(const std::vector<float>& signal) {
+    double first = -1.0, last = -1.0;
+    long periods = -1;
+    for (size_t k = 1; k < signal.size(); ++k) {
+        if (signal[k - 1] < 0.0f && signal[k] >= 0.0f) {
+            last = static_cast<double>(k - 1) + signal[k - 1] / (signal[k - 1] - signal[k]);
+            if (first < 0.0) first = last;
+            periods++;
+        }
+    }
+    return periods > 0 ? SAMPLE_RATE * periods / (last - first) : 0.0;
+}
+
+double levelDb(const std::vector<float>& signal) {
+    double sumSquares = 0.0;
+    for (float y : signal) sumSquares += static_cast<double>(y) * y;
+    return 10.0 * std::log10(sumSquares / signal.size() / 0.5 + 1e-30);
+}
+
+double nsPerSample(uint32_t sleeping) {
+    int shifted[NUM_TAPS];
+    for (int tap = 0; tap < NUM_TAPS; ++tap) shifted[tap] = tap % 2 ? 12 : -12;
+    Rig rig(shifted);
+    for (int b = 0; b < 100; ++b) rig.block();
+
+    constexpr int BLOCKS = 2000;
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < BLOCKS; ++b) {
+        rig.system.setSleepingTaps(sleeping, 0);
+        rig.system.processBlock(rig.input.data(), BLOCK_SIZE, rig.taps.data());
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (BLOCKS * BLOCK_SIZE);
+}
+
+} // namespace
+
+int main() {
+    bool passed = true;
+
+    Rig reference(SEMITONES);
+    Rig sleeper(SEMITONES);
+    const uint32_t allTaps = (1u << NUM_TAPS) - 1;
+    sleeper.system.setSleepingTaps(allTaps, allTaps & ~(1u << HELD_TAP));
+
+    // Wake block of every tap, and the first block its reference output has energy
+    std::array<long, NUM_TAPS> wokeAt;
+    std::array<long, NUM_TAPS> soundAt;
+    wokeAt.fill(-1);
+    soundAt.fill(-1);
+    bool silentWhileAsleep = true;
+
+    std::array<std::vector<float>, NUM_TAPS> referenceCapture, sleeperCapture;
+    const long settle = static_cast<long>(1.5 * SAMPLE_RATE);
+    const long total = settle + static_cast<long>(SAMPLE_RATE);
+
+    while (sleeper.sample < total) {
+        long blockStart = sleeper.sample;
+        reference.block();
+        sleeper.block();
+        uint32_t sleeping = sleeper.system.getSleepingTaps();
+
+        for (int tap = 0; tap < NUM_TAPS; ++tap) {
+            bool asleep = (sleeping & (1u << tap)) != 0;
+            if (!asleep && wokeAt[tap] < 0) wokeAt[tap] = blockStart;
+
+            bool sound = false;
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                sound = sound || std::abs(reference.taps[tap][i]) > DecoupledDelaySystem::SLEEP_THRESHOLD;
+                if (asleep) silentWhileAsleep = silentWhileAsleep && sleeper.taps[tap][i] == 0.0f;
+            }
+            if (sound && soundAt[tap] < 0) soundAt[tap] = blockStart;
+
+            if (blockStart >= settle) {
+                referenceCapture[tap].insert(referenceCapture[tap].end(), reference.taps[tap], reference.taps[tap] + BLOCK_SIZE);
+                sleeperCapture[tap].insert(sleeperCapture[tap].end(), sleeper.taps[tap], sleeper.taps[tap] + BLOCK_SIZE);
+            }
+        }
+    }
+
+    std::cout << "Tap sleep (threshold " << 20.0 * std::log10(DecoupledDelaySystem::SLEEP_THRESHOLD) << " dBFS)" << std::endl;
+    std::cout << "  " << std::left << std::setw(6) << "tap" << std::setw(8) << "semi" << std::setw(12) << "sound ms"
+              << std::setw(12) << "woke ms" << "after waking" << std::endl;
+
+    for (int tap = 0; tap < NUM_TAPS; ++tap) {
+        bool ok;
+        std::string detail;
+        if (tap == HELD_TAP) {
+            ok = wokeAt[tap] < 0;
+            detail = ok ? "held asleep" : "woke";
+        } else if (SEMITONES[tap] == 0) {
+            ok = wokeAt[tap] == soundAt[tap] && sleeperCapture[tap] == referenceCapture[tap];
+            detail = sleeperCapture[tap] == referenceCapture[tap] ? "bit-exact" : "differs";
+        } else {
+            double expected = INPUT_FREQUENCY * std::pow(2.0, SEMITONES[tap] / 12.0);
+            double error = std::abs(averageFrequency(sleeperCapture[tap]) - expected) / expected;
+            double levelError = std::abs(levelDb(sleeperCapture[tap]) - levelDb(referenceCapture[tap]));
+            ok = wokeAt[tap] >= 0 && wokeAt[tap] <= soundAt[tap] && error <= 0.002 && levelError < 0.2;
+
+            std::ostringstream text;
+            text << std::fixed << std::setprecision(3) << "freq err " << error * 100.0 << " %, level "
+                 << std::setprecision(2) << levelError << " dB";
+            detail = text.str();
+        }
+        passed = passed && ok;
+
+        std::cout << "  " << std::left << std::setw(6) << tap << std::setw(8) << SEMITONES[tap] << std::fixed
+                  << std::setprecision(1) << std::setw(12) << soundAt[tap] * 1000.0 / SAMPLE_RATE << std::setw(12)
+                  << (wokeAt[tap] < 0 ? -1.0 : wokeAt[tap] * 1000.0 / SAMPLE_RATE) << detail
+                  << (ok ? "" : "  (wrong)") << std::endl;
+    }
+
+    passed = passed && silentWhileAsleep;
+    std::cout << "  " << std::left << std::setw(38) << "silent while asleep" << (silentWhileAsleep ? "yes" : "NO") << std::endl;
+
+    double allAwakeNs = nsPerSample(0);
+    double fourAwakeNs = nsPerSample(allTaps & ~0xFu);
+    std::cout << std::fixed << std::setprecision(1) << "  system ns/sample, 16 shifted taps: all awake "
+              << allAwakeNs << ", 4 awake " << fourAwakeNs << std::endl;
+
+    std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+// Regression test: SIMD ThreeSistersFilterBank against the scalar
+// double-precision ThreeSistersFilter, 16 taps x 2 channels.
+//
+// Every tap runs its own random parameter schedule (cutoff, resonance
+// including anti-resonance, and filter type crossfades) and is switched
+// on and off, in host-sized blocks. The bank must track the reference
+// within single-precision tolerance.
+
+#include "source/WaterStick/ThreeSistersFilter.h"
+#include "source/WaterStick/ThreeSistersFilterBank.h"
+#include "source/WaterStick/WaterStickParameters.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+using namespace WaterStick;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int BLOCK_SIZE = 256;
+constexpr int NUM_BLOCKS = 750;                 // ~4 seconds
+constexpr double MAX_ABS_ERROR = 1e-4;
+constexpr double MAX_RELATIVE_RMS_ERROR = 1e-5;
+
+struct TapSettings {
+    double cutoff;
+    double resonance;
+    int type;
+};
+
+TapSettings randomSettings(std::mt19937& rng) {
+    std::uniform_real_distribution<double> logCutoff(std::log(40.0), std::log(16000.0));
+    std::uniform_real_distribution<double> resonance(-1.0, 0.9);
+    std::uniform_int_distribution<int> type(kFilterType_Bypass, kFilterType_Notch);
+    return {std::exp(logCutoff(rng)), resonance(rng), type(rng)};
+}
+
+} // namespace
+
+int main() {
+    using Bank = ThreeSistersFilterBank;
+
+    std::mt19937 rng(20240611);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::uniform_int_distribution<int> offset(0, BLOCK_SIZE - 1);
+
+    ThreeSistersFilter referenceL[Bank::NUM_TAPS];
+    ThreeSistersFilter referenceR[Bank::NUM_TAPS];
+    Bank bank;
+    bank.prepare(BLOCK_SIZE);
+    bank.setSampleRate(SAMPLE_RATE);
+
+    for (int tap = 0; tap < Bank::NUM_TAPS; ++tap) {
+        referenceL[tap].setSampleRate(SAMPLE_RATE);
+        referenceR[tap].setSampleRate(SAMPLE_RATE);
+    }
+
+    std::vector<float> bufferL(Bank::NUM_TAPS * BLOCK_SIZE), bufferR(Bank::NUM_TAPS * BLOCK_SIZE);
+    std::vector<double> expectedL(Bank::NUM_TAPS * BLOCK_SIZE), expectedR(Bank::NUM_TAPS * BLOCK_SIZE);
+    std::array<float*, Bank::NUM_TAPS> tapsL{}, tapsR{};
+    for (int tap = 0; tap < Bank::NUM_TAPS; ++tap) {
+        tapsL[tap] = bufferL.data() + tap * BLOCK_SIZE;
+        tapsR[tap] = bufferR.data() + tap * BLOCK_SIZE;
+    }
+
+    std::array<TapSettings, Bank::NUM_TAPS> settings{};
+    for (auto& s : settings) s = randomSettings(rng);
+
+    double maxError[kNumFilterTypes] = {};
+    double errorEnergy = 0.0;
+    double signalEnergy = 0.0;
+    uint32_t activeTaps = 0xFFFF;
+
+    for (int block = 0; block < NUM_BLOCKS; ++block) {
+        // Occasionally park a tap; parked taps keep their state in both paths
+        if (chance(rng) < 0.05) {
+            activeTaps ^= 1u << std::uniform_int_distribution<int>(0, Bank::NUM_TAPS - 1)(rng);
+        }
+
+        for (int tap = 0; tap < Bank::NUM_TAPS; ++tap) {
+            if (!(activeTaps & (1u << tap))) continue;
+
+            // Up to two parameter changes per block, at random offsets
+            std::array<int, 3> changeAt = {0, BLOCK_SIZE, BLOCK_SIZE};
+            if (chance(rng) < 0.2) changeAt[1] = offset(rng);
+            if (chance(rng) < 0.1) changeAt[2] = offset(rng);
+            std::sort(changeAt.begin(), changeAt.end());
+
+            int nextChange = 0;
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                while (nextChange < 3 && changeAt[nextChange] == i) {
+                    if (i > 0) settings[tap] = randomSettings(rng);
+                    const TapSettings& s = settings[tap];
+                    referenceL[tap].setParameters(s.cutoff, s.resonance, s.type);
+                    referenceR[tap].setParameters(s.cutoff, s.resonance, s.type);
+                    bank.scheduleParameters(tap, i, s.cutoff, s.resonance, s.type);
+                    nextChange++;
+                }
+
+                float inL = noise(rng);
+                float inR = noise(rng);
+                tapsL[tap][i] = inL;
+                tapsR[tap][i] = inR;
+                expectedL[tap * BLOCK_SIZE + i] = referenceL[tap].process(inL);
+                expectedR[tap * BLOCK_SIZE + i] = referenceR[tap].process(inR);
+            }
+        }
+
+        bank.processBlock(tapsL.data(), tapsR.data(), activeTaps, BLOCK_SIZE);
+
+        for (int tap = 0; tap < Bank::NUM_TAPS; ++tap) {
+            if (!(activeTaps & (1u << tap))) continue;
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                for (int channel = 0; channel < 2; ++channel) {
+                    double expected = channel == 0 ? expectedL[tap * BLOCK_SIZE + i] : expectedR[tap * BLOCK_SIZE + i];
+                    double actual = channel == 0 ? tapsL[tap][i] : tapsR[tap][i];
+                    double error = std::abs(actual - expected);
+
+                    int type = settings[tap].type;
+                    maxError[type] = std::max(maxError[type], error);
+                    errorEnergy += error * error;
+                    signalEnergy += expected * expected;
+                }
+            }
+        }
+    }
+
+    const char* typeNames[kNumFilterTypes] = {"Bypass", "LowPass", "HighPass", "BandPass", "Notch"};
+    double worst = 0.0;
+
+    std::cout << "ThreeSistersFilterBank vs ThreeSistersFilter (SIMD width "
+              << simd::FloatBatch::WIDTH << ")" << std::endl;
+    for (int type = 0; type < kNumFilterTypes; ++type) {
+        std::cout << "  " << std::left << std::setw(10) << typeNames[type]
+                  << " max abs error " << std::scientific << std::setprecision(3) << maxError[type] << std::endl;
+        worst = std::max(worst, maxError[type]);
+    }
+
+    double relativeRms = std::sqrt(errorEnergy / std::max(signalEnergy, 1e-30));
+    std::cout << "  relative RMS error " << relativeRms << std::endl;
+
+    if (worst > MAX_ABS_ERROR || relativeRms > MAX_RELATIVE_RMS_ERROR || !std::isfinite(relativeRms)) {
+        std::cout << "FAIL: bank diverges from the double-precision filter" << std::endl;
+        return 1;
+    }
+
+    std::cout << "PASS" << std::endl;
+    return 0;
+}